@@ -3,20 +3,44 @@
 Level compiler: JSON -> binary .lvl according to lvl_binary.md
 
 Usage:
-    python3 level_compiler.py [<folder>]
+    python3 level_compiler.py [--v1] [--bake] [<folder>]
 
 Without arguments the script converts every `.json` file located next to this
 script into a `.lvl` file with the same base name. When a folder is provided it
 performs the same batch conversion within that directory.
+
+Levels are written in the v2 layout (see src/game/level_loader.h) unless
+--v1 is given:
+    header   64 bytes  magic 'GHLV', version 2, header size, file size,
+                       crc32 of the whole file (crc field as zero), section
+                       count and table offset, then the level settings
+    table    16 bytes per section: id, offset, size, record count
+    data     every section starts on a 16 byte boundary; records are
+             naturally aligned so the game reads them in place
+
+--bake adds the planet field sections (see src/game/planet_field.h): gravity
+and distance-to-surface grids plus the planet broadphase cells, each behind a
+40 byte header (version, payload crc32, crc32 of the planet section, grid
+geometry, and the gravity constant, epsilon and planet mass factor the grids
+were computed with). The game checks them against its planets and physics
+constants and recomputes the field at load when they are missing or stale;
+they need the v2 layout.
+
+After a successful batch the compiler also writes catalog.idx (see
+src/game/campaign_levels.h): display name, goals, ratings, counts, start
+text and CRC32 of every level, so the campaign menu never opens the levels.
 """
 import json
+import math
 import struct
 import sys
+import zlib
 from pathlib import Path
 
 # --------------------------- Layout constants ---------------------------
 MAGIC = b'GHLV'
 VERSION = 1
+VERSION_V2 = 2
 
 # Field sizes / limits
 MAX_PLANETS = 1024
@@ -52,6 +76,45 @@ HEADER_FMT = '<4sHHIH3IffIII'
 PLANET_FMT = '<Bfff'  # type(uint8), size(float), pos_x(float), pos_y(float)
 ENEMY_FMT = '<HBffBIBII'  # id(uint16), type(uint8), pos_x(f), pos_y(f), difficulty(uint8), health(uint32), spawn_kind(uint8), spawn_arg(uint32), spawn_delay(uint32)
 
+# v2: fixed-size header, section table and aligned, padded records
+HEADER_V2 = struct.Struct('<4sHHIIII' 'IHH3IffI8x')
+# fields: magic, version, header_size, file_size, crc, section_count, table_offset,
+# time_limit, goal_kills, reserved, rating[3], player_pos_x, player_pos_y, player_health
+HEADER_V2_CRC_OFFSET = 12
+SECTION_V2 = struct.Struct('<IIII')  # id, offset, size, count
+PLANET_V2 = struct.Struct('<B3xfff')  # type, size, pos_x, pos_y (16 bytes)
+ENEMY_V2 = struct.Struct('<HBBffIB3xII')  # id, type, difficulty, pos_x, pos_y, health, spawn_kind, spawn_arg, spawn_delay (28 bytes)
+SECTION_ALIGN = 16
+
+SECTION_STRINGS = 1
+SECTION_PLANETS = 2
+SECTION_ENEMIES = 3
+SECTION_GRAVITY = 4
+SECTION_SDF = 5
+SECTION_BROADPHASE = 6
+
+# Planet field (--bake); must match src/core/types.h and src/game/planet_field.h
+BAKED_HEADER = struct.Struct('<HHIIHHffffff')
+# version, header_size, crc, planets_crc, cols, rows, origin_x, origin_y, cell, gravity_const, epsilon, mass_factor
+FIELD_VERSION = 2             # PLANET_FIELD_VERSION
+DISPLAY_W, DISPLAY_H = 960, 544
+FIELD_CELL = 16.0             # PLANET_FIELD_CELL
+FIELD_BROAD_CELL = 64.0       # PLANET_FIELD_BROAD_CELL
+FIELD_MARGIN = 0.2            # PLANET_FIELD_MARGIN
+GRAVITY_CONST = 500.0         # PROJ_GRAVITY_CONST
+GRAVITY_EPSILON = 0.0001      # PROJ_EPSILON
+MASS_FACTOR = math.pi         # PLANET_MASS_FACTOR
+
+# Campaign catalog index
+CATALOG_NAME = 'catalog.idx'
+CATALOG_MAGIC = b'GHCI'
+CATALOG_VERSION = 1
+CATALOG_HEADER = struct.Struct('<4sHHIIIII4x')  # magic, version, header_size, count, entry_size, text_offset, text_size, crc
+CATALOG_ENTRY = struct.Struct('<24s20sII I3IHxxIIII')
+# filename, display_name, content_hash, content_size, time_limit, rating[3], goal_kills, planets, enemies, text_offset, text_size
+CATALOG_MAX_FILENAME = 24      # CAMPAIGN_LEVEL_MAX_FILENAME
+CATALOG_MAX_DISPLAY_NAME = 20  # CAMPAIGN_LEVEL_MAX_DISPLAY_NAME
+
 # --------------------------- Helpers ---------------------------
 
 def clamp_u16(x):
@@ -145,7 +208,116 @@ def parse_difficulty(value):
 
 # --------------------------- Main builder ---------------------------
 
-def build_level(json_path: Path, out_path: Path):
+def _align(n, a=SECTION_ALIGN):
+    return (n + a - 1) // a * a
+
+
+def _f32(x):
+    return struct.unpack('<f', struct.pack('<f', x))[0]
+
+
+def bake_planet_field(planets_payload, planet_entries):
+    """Gravity, sdf and broadphase sections, laid out like planet_field_build() computes them"""
+    margin_x = _f32(FIELD_MARGIN * DISPLAY_W)
+    margin_y = _f32(FIELD_MARGIN * DISPLAY_H)
+    ox, oy = -margin_x, -margin_y
+    span_x, span_y = DISPLAY_W + 2 * margin_x, DISPLAY_H + 2 * margin_y
+    cols = math.ceil(span_x / FIELD_CELL) + 1
+    rows = math.ceil(span_y / FIELD_CELL) + 1
+    bcols = math.ceil(span_x / FIELD_BROAD_CELL)
+    brows = math.ceil(span_y / FIELD_BROAD_CELL)
+    planets = [(float(p[2]), float(p[3]), float(p[1])) for p in planet_entries]  # x, y, radius
+
+    accel = []
+    sdf = []
+    for r in range(rows):
+        y = oy + r * FIELD_CELL
+        for c in range(cols):
+            x = ox + c * FIELD_CELL
+            ax = ay = 0.0
+            dist = 1e30
+            for px, py, radius in planets:
+                dx, dy = px - x, py - y
+                dist2 = dx * dx + dy * dy
+                d = math.sqrt(dist2)
+                dist = min(dist, d - radius)
+                if dist2 < GRAVITY_EPSILON:
+                    continue
+                a = MASS_FACTOR * radius * radius * GRAVITY_CONST / dist2
+                ax += a * dx / d
+                ay += a * dy / d
+            accel += [ax, ay]
+            sdf.append(dist)
+
+    def cell_range(x, y, radius):
+        def clamp(v, n):
+            return 0 if not v > 0 else (n - 1 if v >= n - 1 else int(v))
+        return (clamp((x - radius - ox) / FIELD_BROAD_CELL, bcols), clamp((y - radius - oy) / FIELD_BROAD_CELL, brows),
+                clamp((x + radius - ox) / FIELD_BROAD_CELL, bcols), clamp((y + radius - oy) / FIELD_BROAD_CELL, brows))
+
+    cells = [[] for _ in range(bcols * brows)]
+    for i, (px, py, radius) in enumerate(planets):
+        c0, r0, c1, r1 = cell_range(px, py, radius)
+        for r in range(r0, r1 + 1):
+            for c in range(c0, c1 + 1):
+                cells[r * bcols + c].append(i)
+    start = [0]
+    for cell in cells:
+        start.append(start[-1] + len(cell))
+
+    planets_crc = zlib.crc32(planets_payload) & 0xFFFFFFFF
+
+    def section(payload, c, r, cell):
+        header = BAKED_HEADER.pack(FIELD_VERSION, BAKED_HEADER.size, zlib.crc32(payload) & 0xFFFFFFFF, planets_crc,
+                                   c, r, ox, oy, cell, GRAVITY_CONST, GRAVITY_EPSILON, MASS_FACTOR)
+        return header + payload
+
+    return [
+        (SECTION_GRAVITY, cols * rows, section(struct.pack(f'<{len(accel)}f', *accel), cols, rows, FIELD_CELL)),
+        (SECTION_SDF, cols * rows, section(struct.pack(f'<{len(sdf)}f', *sdf), cols, rows, FIELD_CELL)),
+        (SECTION_BROADPHASE, bcols * brows,
+         section(struct.pack(f'<{len(start)}I', *start) + struct.pack(f'<{start[-1]}H', *(i for c in cells for i in c)),
+                 bcols, brows, FIELD_BROAD_CELL)),
+    ]
+
+
+def write_level_v2(out_path, time_limit, goal_kills, rating, player, start_text, planet_entries, enemy_objects,
+                   bake=False):
+    planets_payload = b''.join(PLANET_V2.pack(int(p[0]), float(p[1]), float(p[2]), float(p[3])) for p in planet_entries)
+    sections = [
+        (SECTION_STRINGS, 1, start_text.encode('utf-8') + b'\x00'),
+        (SECTION_PLANETS, len(planet_entries), planets_payload),
+        (SECTION_ENEMIES, len(enemy_objects),
+         b''.join(ENEMY_V2.pack(int(e['id']), int(e['type']), int(e['difficulty']), float(e['pos'][0]),
+                                float(e['pos'][1]), int(e['health']), int(e['spawn_kind']),
+                                int(e['spawn_arg_index']), int(e['spawn_delay'])) for e in enemy_objects)),
+    ]
+    if bake and planet_entries:
+        sections += bake_planet_field(planets_payload, planet_entries)
+    table_offset = HEADER_V2.size
+    offset = _align(table_offset + SECTION_V2.size * len(sections))
+    table = b''
+    body = bytearray()
+    for sid, count, payload in sections:
+        table += SECTION_V2.pack(sid, offset, len(payload), count)
+        body += payload + b'\x00' * (_align(len(payload)) - len(payload))
+        offset += _align(len(payload))
+    table += b'\x00' * (_align(table_offset + len(table)) - table_offset - len(table))
+    file_size = table_offset + len(table) + len(body)
+
+    def header(crc):
+        return HEADER_V2.pack(MAGIC, VERSION_V2, HEADER_V2.size, file_size, crc, len(sections), table_offset,
+                              int(time_limit), int(goal_kills), 0, int(rating[0]), int(rating[1]), int(rating[2]),
+                              float(player[0]), float(player[1]), int(player[2]))
+
+    data = header(0) + table + bytes(body)
+    crc = zlib.crc32(data) & 0xFFFFFFFF
+    data = header(crc) + table + bytes(body)
+    out_path.parent.mkdir(parents=True, exist_ok=True)
+    out_path.write_bytes(data)
+
+
+def build_level(json_path: Path, out_path: Path, version_out=VERSION_V2, bake=False):
     with json_path.open('r', encoding='utf-8') as f:
         data = json.load(f)
 
@@ -255,7 +427,15 @@ def build_level(json_path: Path, out_path: Path):
         else:
             e['spawn_arg_index'] = 0
 
-    # ----- Write binary -----
+    start_text = data.get('start_text', '')
+    if version_out == VERSION_V2:
+        write_level_v2(out_path, time_limit, goal_kills, rating, (player_pos_x, player_pos_y, player_health),
+                       start_text, planet_entries, enemy_objects, bake)
+        print(f'Wrote {out_path} v2 (planets={len(planet_entries)} enemies={len(enemy_objects)}'
+              f'{" baked" if bake and planet_entries else ""})')
+        return level_meta(out_path, time_limit, goal_kills, rating, start_text, planet_entries, enemy_objects)
+
+    # ----- Write binary (v1) -----
     header_packed = struct.pack(
         HEADER_FMT,
         MAGIC,
@@ -274,7 +454,6 @@ def build_level(json_path: Path, out_path: Path):
     )
 
     # start_text (nul-terminated utf-8)
-    start_text = data.get('start_text', '')
     start_bytes = start_text.encode('utf-8') + b'\x00'
 
     out_path.parent.mkdir(parents=True, exist_ok=True)
@@ -300,9 +479,52 @@ def build_level(json_path: Path, out_path: Path):
             f.write(e_packed)
 
     print(f'Wrote {out_path} (planets={len(planet_entries)} enemies={len(enemy_objects)})')
-
-
-def compile_folder(json_dir: Path) -> int:
+    return level_meta(out_path, time_limit, goal_kills, rating, start_text, planet_entries, enemy_objects)
+
+
+def level_meta(out_path, time_limit, goal_kills, rating, start_text, planet_entries, enemy_objects):
+    data = out_path.read_bytes()
+    return {
+        'filename': out_path.name,
+        'hash': zlib.crc32(data) & 0xFFFFFFFF,
+        'size': len(data),
+        'time_limit': int(time_limit),
+        'goal_kills': int(goal_kills),
+        'rating': [int(r) for r in rating],
+        'planets': len(planet_entries),
+        'enemies': len(enemy_objects),
+        'start_text': start_text,
+    }
+
+
+def display_name(filename):
+    # Same rules as campaign_level_format_display_name()
+    dot = filename.rfind('.')
+    base = filename[:dot] if dot > 0 else filename
+    base = base.encode('utf-8')[:CATALOG_MAX_DISPLAY_NAME - 1].replace(b'_', b' ')
+    return base or filename.encode('utf-8')[:CATALOG_MAX_DISPLAY_NAME - 1]
+
+
+def write_catalog(out_path: Path, metas):
+    # Sorted like campaign_levels_scan(): case-insensitive, then case-sensitive
+    metas = sorted(metas, key=lambda m: (m['filename'].lower(), m['filename']))
+    entries = b''
+    text = bytearray()
+    for m in metas:
+        raw = m['start_text'].encode('utf-8')
+        entries += CATALOG_ENTRY.pack(m['filename'].encode('utf-8'), display_name(m['filename']), m['hash'], m['size'],
+                                      m['time_limit'], *m['rating'], m['goal_kills'], m['planets'], m['enemies'],
+                                      len(text), len(raw))
+        text += raw + b'\x00'
+    text_offset = CATALOG_HEADER.size + len(entries)
+    body = entries + bytes(text)
+    header = CATALOG_HEADER.pack(CATALOG_MAGIC, CATALOG_VERSION, CATALOG_HEADER.size, len(metas), CATALOG_ENTRY.size,
+                                 text_offset, len(text), zlib.crc32(body) & 0xFFFFFFFF)
+    out_path.write_bytes(header + body)
+    print(f'Wrote {out_path} ({len(metas)} levels)')
+
+
+def compile_folder(json_dir: Path, version_out=VERSION_V2, bake=False) -> int:
     json_dir = json_dir.resolve()
     if not json_dir.is_dir():
         raise NotADirectoryError(f"{json_dir} is not a directory")
@@ -314,10 +536,15 @@ def compile_folder(json_dir: Path) -> int:
 
     print(f'Compiling {len(json_files)} level(s) from {json_dir}')
     errors = []
+    metas = []
     for json_path in json_files:
         out_path = json_path.with_suffix('.lvl')
+        if len(out_path.name.encode('utf-8')) >= CATALOG_MAX_FILENAME:
+            print(f'Warning: {out_path.name} is too long for the campaign (max {CATALOG_MAX_FILENAME - 1} chars)')
         try:
-            build_level(json_path, out_path)
+            meta = build_level(json_path, out_path, version_out, bake)
+            if len(out_path.name.encode('utf-8')) < CATALOG_MAX_FILENAME:
+                metas.append(meta)
         except Exception as exc:  # pylint: disable=broad-except
             errors.append((json_path, exc))
             print(f'Error: failed to compile {json_path.name}: {exc}')
@@ -326,15 +553,27 @@ def compile_folder(json_dir: Path) -> int:
         print(f'Encountered {len(errors)} error(s) during compilation.')
         return 1
 
+    write_catalog(json_dir / CATALOG_NAME, metas)
+
     print('All levels compiled successfully.')
     return 0
 
 
 # --------------------------- CLI ---------------------------
 if __name__ == '__main__':
-    target_dir = Path(sys.argv[1]).resolve() if len(sys.argv) >= 2 else Path(__file__).resolve().parent
+    args = sys.argv[1:]
+    version_out = VERSION_V2
+    if '--v1' in args:
+        args.remove('--v1')
+        version_out = VERSION
+    bake = '--bake' in args
+    if bake:
+        args.remove('--bake')
+        if version_out != VERSION_V2:
+            print('Warning: --bake needs the v2 layout, ignoring it')
+    target_dir = Path(args[0]).resolve() if args else Path(__file__).resolve().parent
     try:
-        exit_code = compile_folder(target_dir)
+        exit_code = compile_folder(target_dir, version_out, bake)
     except Exception as err:  # pylint: disable=broad-except
         print(f'Compilation failed: {err}')
         exit_code = 1
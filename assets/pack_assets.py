@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""
+Asset packer: bundles runtime assets into a single memory-mappable archive.
+
+Usage:
+    python3 pack_assets.py [-o <output>] [<assets folder>]
+
+Without arguments the script packs the folder it lives in and writes
+`assets.pak` next to it. PNG images are stored pre-decoded as RGBA32 (byte
+order R, G, B, A; SDL_PIXELFORMAT_RGBA32) so the game can upload them to the
+GPU straight from the mapping. Compiled levels, the level index, text files
+and fonts are stored as-is.
+
+Layout (little endian, see src/core/vfs.h):
+    header   32 bytes  magic 'GHPK', version, header size, section count,
+                       table offset, table crc32, total size
+    sections 96 bytes each, sorted by path
+    data     every section starts on a 64 byte boundary
+
+Only the Python standard library is used so the packer can run as part of
+the build on any machine.
+"""
+import struct
+import sys
+import zlib
+from pathlib import Path
+
+MAGIC = b'GHPK'
+VERSION = 1
+HEADER = struct.Struct('<4sHHIIII8x')
+SECTION = struct.Struct('<64sIIIIHHII4x')
+ALIGN = 64
+
+KIND_RAW = 0
+KIND_TEXTURE = 1
+FORMAT_NONE = 0
+FORMAT_RGBA32 = 1
+
+# (folder, extensions, decode png?)
+CONTENT = [
+    ('images', ('.png',), True),
+    ('buttons', ('.png',), True),
+    ('levels', ('.lvl', '.idx'), False),
+    ('fonts', ('.ttf',), False),
+    ('', ('.txt',), False),
+]
+# Documentation screenshots, never loaded by the game
+SKIP = {'images/gameplay.png', 'images/main_menu.png'}
+
+
+# ------------------------------ PNG decoding -----------------------------
+def _paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def decode_png(path):
+    """Return (width, height, rgba bytes) for 8-bit, non-interlaced PNGs."""
+    data = path.read_bytes()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError(f'{path}: not a PNG file')
+    pos = 8
+    idat = bytearray()
+    palette = b''
+    trns = b''
+    width = height = depth = ctype = interlace = 0
+    while pos < len(data):
+        length, tag = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if tag == b'IHDR':
+            width, height, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif tag == b'PLTE':
+            palette = chunk
+        elif tag == b'tRNS':
+            trns = chunk
+        elif tag == b'IDAT':
+            idat += chunk
+        elif tag == b'IEND':
+            break
+    if depth != 8 or interlace != 0:
+        raise ValueError(f'{path}: only 8-bit non-interlaced PNGs are supported')
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(ctype)
+    if channels is None:
+        raise ValueError(f'{path}: unsupported colour type {ctype}')
+
+    raw = zlib.decompress(bytes(idat))
+    stride = width * channels
+    prev = bytearray(stride)
+    rows = []
+    off = 0
+    for _ in range(height):
+        ftype = raw[off]
+        line = bytearray(raw[off + 1:off + 1 + stride])
+        off += 1 + stride
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                line[i] = (line[i] + _paeth(a, b, c)) & 0xFF
+        rows.append(line)
+        prev = line
+
+    out = bytearray(width * height * 4)
+    o = 0
+    for line in rows:
+        for x in range(width):
+            if ctype == 6:
+                out[o:o + 4] = line[x * 4:x * 4 + 4]
+            elif ctype == 2:
+                out[o:o + 3] = line[x * 3:x * 3 + 3]
+                out[o + 3] = 255
+            elif ctype == 0:
+                g = line[x]
+                out[o:o + 4] = bytes((g, g, g, 255))
+            elif ctype == 4:
+                g = line[x * 2]
+                out[o:o + 4] = bytes((g, g, g, line[x * 2 + 1]))
+            else:
+                idx = line[x]
+                out[o:o + 3] = palette[idx * 3:idx * 3 + 3]
+                out[o + 3] = trns[idx] if idx < len(trns) else 255
+            o += 4
+    return width, height, bytes(out)
+
+
+# ------------------------------- Packing ---------------------------------
+def collect(root):
+    entries = []
+    for folder, exts, decode in CONTENT:
+        base = root / folder if folder else root
+        if not base.is_dir():
+            continue
+        for path in sorted(base.iterdir()):
+            if not path.is_file() or path.suffix.lower() not in exts:
+                continue
+            name = path.relative_to(root).as_posix()
+            if name in SKIP:
+                continue
+            if len(name.encode('utf-8')) >= 64:
+                print(f'skipping {name}: path too long', file=sys.stderr)
+                continue
+            if decode:
+                w, h, pixels = decode_png(path)
+                entries.append((name, KIND_TEXTURE, pixels, w, h, FORMAT_RGBA32, w * 4))
+            else:
+                entries.append((name, KIND_RAW, path.read_bytes(), 0, 0, FORMAT_NONE, 0))
+    entries.sort(key=lambda e: e[0].encode('utf-8'))
+    return entries
+
+
+def align(n):
+    return (n + ALIGN - 1) & ~(ALIGN - 1)
+
+
+def build(root, output):
+    entries = collect(root)
+    table_offset = HEADER.size
+    offset = align(table_offset + SECTION.size * len(entries))
+    table = bytearray()
+    blobs = []
+    for name, kind, blob, w, h, fmt, pitch in entries:
+        table += SECTION.pack(name.encode('utf-8'), kind, offset, len(blob),
+                              zlib.crc32(blob) & 0xFFFFFFFF, w, h, fmt, pitch)
+        blobs.append((offset, blob))
+        offset = align(offset + len(blob))
+    total = offset
+    header = HEADER.pack(MAGIC, VERSION, HEADER.size, len(entries), table_offset,
+                         zlib.crc32(bytes(table)) & 0xFFFFFFFF, total)
+
+    out = bytearray(total)
+    out[0:HEADER.size] = header
+    out[table_offset:table_offset + len(table)] = table
+    for off, blob in blobs:
+        out[off:off + len(blob)] = blob
+    tmp = output.with_suffix(output.suffix + '.tmp')
+    tmp.write_bytes(out)
+    tmp.replace(output)
+    print(f'{output}: {len(entries)} sections, {total} bytes')
+
+
+def main(argv):
+    output = None
+    args = list(argv)
+    if '-o' in args:
+        i = args.index('-o')
+        if i + 1 >= len(args):
+            print(__doc__)
+            return 1
+        output = Path(args[i + 1])
+        del args[i:i + 2]
+    root = Path(args[0]) if args else Path(__file__).resolve().parent
+    if output is None:
+        output = root / 'assets.pak'
+    try:
+        build(root, output)
+    except (OSError, ValueError, zlib.error) as exc:
+        print(f'error: {exc}', file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
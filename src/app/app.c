@@ -9,19 +9,34 @@
 #include "../services/input.h"
 #include "../services/renderer.h"
 #include "../scenes/scene_menu.h"
+#include "../scenes/scene_campaign.h"
 #include "../core/time.h"
 #include "../core/types.h"
 #include "../core/log.h"
 #include "../services/texture_manager.h"
+#include "../services/quality.h"
 #include "../game/campaign_progress.h"
+#include "../game/campaign_levels.h"
+#include "../game/level_thumbs.h"
 
 struct App {
     struct Services *services;
     SceneStack stack;
     FrameTimer timer;
     int running;
+    bool redraw_requested; // set by app_request_redraw, cleared after the next present
+    bool idle;             // last app_update skipped render/present
+    unsigned int frames_presented;
+    unsigned int frames_skipped;
+    double stats_at;
+    Uint64 boot_start;     // perf counter at app_create, for boot stage timings
+    Uint64 boot_last;
+    bool first_frame_logged;
+    bool menu_logged;
 };
 
+#define APP_FRAME_STATS_SECONDS 10.0
+
 static App *g_app = NULL;
 
 App *app_get(void) {
@@ -32,10 +47,23 @@ struct Services *app_services(void) {
     return g_app ? g_app->services : NULL;
 }
 
+/**
+ * @brief Log the time spent in a boot stage and since app_create
+ */
+static void app_boot_mark(const char *stage) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    double freq = (double)SDL_GetPerformanceFrequency();
+    LOG_INFO("boot", "%-16s +%7.1f ms (total %7.1f ms)", stage,
+             (double)(now - g_app->boot_last) * 1000.0 / freq,
+             (double)(now - g_app->boot_start) * 1000.0 / freq);
+    g_app->boot_last = now;
+}
+
 bool app_create(void) {
     if (g_app) {
         return true;
     }
+    Uint64 boot_start = SDL_GetPerformanceCounter();
 
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
 
@@ -55,19 +83,30 @@ bool app_create(void) {
         return false;
     }
 
+    g_app->boot_start = boot_start;
+    g_app->boot_last = boot_start;
+    app_boot_mark("sdl init");
+
     g_app->services = services_get();
     services_init(g_app->services);
+    app_boot_mark("services");
 
     if (!campaign_progress_data()) {
         LOG_WARN("app", "Failed to load campaign progress from %s",
                 campaign_progress_default_path());
     }
 
+    app_boot_mark("campaign save");
+
+    /* Assets keep streaming in while the loading scene is up; it switches to
+     * the menu as soon as the menu's textures are available. */
     scenestack_init(&g_app->stack);
-    if (!scenestack_set_base(&g_app->stack, SCENE_MENU)) {
-        LOG_ERROR("app", "Failed to create initial menu scene");
+    if (!scenestack_set_base(&g_app->stack, SCENE_LOADING)) {
+        LOG_ERROR("app", "Failed to create initial loading scene");
     }
     timer_init(&g_app->timer);
+    g_app->stats_at = g_app->timer.current_time + APP_FRAME_STATS_SECONDS;
+    g_app->redraw_requested = true;
     g_app->running = 1;
     return true;
 }
@@ -78,17 +117,38 @@ void app_destroy(void) {
     }
     scenestack_shutdown(&g_app->stack);
     campaign_progress_shutdown();
+    campaign_levels_index_release();
+    scene_campaign_prefetch_cancel();
+    level_thumbs_shutdown();
     services_shutdown(g_app->services);
     SDL_Quit();
     free(g_app);
     g_app = NULL;
 }
 
+/**
+ * @brief Scenes other than the loading screen and the main menu may use any
+ *        asset, so finish the startup load before entering them.
+ */
+static void app_require_assets(SceneID id) {
+    if (!g_app->services->loading || id == SCENE_LOADING || id == SCENE_MENU) {
+        return;
+    }
+    services_finish_loading(g_app->services);
+    app_boot_mark("assets (forced)");
+}
+
 bool app_set_scene(SceneID id) {
+    app_require_assets(id);
+    if (id == SCENE_MENU && !g_app->menu_logged) {
+        g_app->menu_logged = true;
+        app_boot_mark("menu handoff");
+    }
     return scenestack_set_base(&g_app->stack, id);
 }
 
 bool app_push_overlay(SceneID id) {
+    app_require_assets(id);
     return scenestack_push(&g_app->stack, id);
 }
 
@@ -100,29 +160,109 @@ bool app_has_overlay(void) {
     return g_app && g_app->stack.overlay_count > 0;
 }
 
+/**
+ * @brief Periodically log how many frames were presented vs skipped as idle
+ */
+static void app_frame_stats(void) {
+    double now = g_app->timer.current_time;
+    if (now < g_app->stats_at) {
+        return;
+    }
+    unsigned int total = g_app->frames_presented + g_app->frames_skipped;
+    LOG_DEBUG("app", "frames presented=%u skipped=%u (%.0f%% idle)",
+              g_app->frames_presented, g_app->frames_skipped,
+              total ? 100.0 * g_app->frames_skipped / total : 0.0);
+    g_app->frames_presented = 0;
+    g_app->frames_skipped = 0;
+    g_app->stats_at = now + APP_FRAME_STATS_SECONDS;
+}
+
+#ifdef DEBUG_QUALITY
+static void app_quality_overlay(void) {
+    char text[48];
+    snprintf(text, sizeof(text), "%s %.1f ms", quality_current()->name, quality_average_ms());
+    renderer_draw_text(g_app->services->renderer, text, 8.f, 8.f, (TextStyle){0});
+}
+#endif
+
 void app_update(void) {
     if (!g_app) {
         return;
     }
 
+    Uint64 work_start = SDL_GetPerformanceCounter();
+    bool was_idle = g_app->idle;
     double frame_dt = timer_frame_delta(&g_app->timer);
+    /* Interval since the previous frame, before clamping, for the quality governor */
+    double frame_ms = frame_dt * 1000.0;
     if (frame_dt > 0.25) {
         frame_dt = 0.25;
     }
     g_app->timer.accumulator += frame_dt;
+    /* Waking from an idle wait runs exactly one step for the event that woke
+     * us; the time slept is not owed, or later frames would run fast. Scenes
+     * with a running timer stay dirty and never idle, so this loses them nothing. */
+    if (was_idle) {
+        g_app->timer.accumulator = FIXED_DT;
+    }
 
+    bool input_active = false;
     if (g_app->timer.accumulator >= FIXED_DT) {
         struct InputState in = {0};
         input_poll(g_app->services->input, &in);
+        input_active = input_state_any(&in);
         scenestack_handle_input(&g_app->stack, &in);
         scenestack_update(&g_app->stack, FIXED_DT);
         g_app->timer.accumulator -= FIXED_DT;
     }
 
+    /* Startup assets are turned into textures a slice at a time */
+    if (g_app->services->loading && services_load_step(g_app->services, BOOT_LOAD_SLICE_MS)) {
+        app_boot_mark("assets");
+    }
+
+    /* Scene changes above released their textures; drop what no longer fits */
+    texman_trim(g_app->services->texman);
+
+    app_frame_stats();
+
+    /* Menus and other static scenes keep the last presented frame on screen
+     * until input arrives or a scene reports a change. */
+    if (!input_active && !g_app->redraw_requested && !scenestack_needs_render(&g_app->stack)) {
+        g_app->idle = true;
+        g_app->frames_skipped++;
+        return;
+    }
+    g_app->idle = false;
+    g_app->redraw_requested = false;
+    g_app->frames_presented++;
+
     SDL_Renderer *sdlr = g_app->services->sdl_renderer;
     SDL_SetRenderDrawColor(sdlr, 0, 0, 0, 255);
     SDL_RenderClear(sdlr);
 
     scenestack_render(&g_app->stack, g_app->services->renderer);
+#ifdef DEBUG_QUALITY
+    app_quality_overlay();
+#endif
+    /* Only rendered frames count; idle menu frames say nothing about load, and
+     * the gap after an idle stretch is not a missed vsync */
+    double work_ms = (double)(SDL_GetPerformanceCounter() - work_start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    quality_frame(work_ms, was_idle ? 0.0 : frame_ms);
     renderer_render(g_app->services->renderer);
+    if (!g_app->first_frame_logged) {
+        g_app->first_frame_logged = true;
+        app_boot_mark("first frame");
+    }
+}
+
+void app_request_redraw(void) {
+    if (g_app) {
+        g_app->redraw_requested = true;
+    }
+}
+
+bool app_is_idle(void) {
+    /* Keep the loop spinning while startup assets are still being uploaded */
+    return g_app && g_app->idle && !g_app->services->loading;
 }
\ No newline at end of file
@@ -29,6 +29,18 @@ void app_destroy(void);
  */
 void app_update(void);
 
+/**
+ * @brief Request a new frame on the next update (e.g. after a window event)
+ */
+void app_request_redraw(void);
+
+/**
+ * @brief Check whether the last update skipped rendering because nothing changed.
+ *        The main loop may then block on SDL_WaitEventTimeout.
+ * @return true if idle
+ */
+bool app_is_idle(void);
+
 /**
  * @brief Set the base scene
  * @param id Scene ID to set
@@ -13,6 +13,8 @@
 #include "../scenes/overlay_endgame.h"
 #include "../scenes/overlay_endgame_qp.h"
 #include "../scenes/scene_loading.h"
+#include "../services/services.h"
+#include "../services/texture_manager.h"
 
 /**
  * @brief Macro to reduce verbosity in VTable initialization.
@@ -57,24 +59,76 @@ SCENE_VTABLE(vt_endgame_camp, overlay_endgame);
 // Loading scene has NULL handle_input, so uses custom macro
 SCENE_VTABLE_CUSTOM(vt_load, scene_loading_enter, scene_loading_leave, NULL, scene_loading_update, scene_loading_render);
 
+/**
+ * @brief Standalone textures a scene draws; held for the scene's lifetime so
+ *        the texture manager can evict everything else. Overlays draw over
+ *        their base scene and need nothing extra; atlas sprites are always
+ *        resident.
+ * @param id Scene ID
+ * @param count Receives the number of entries
+ * @return Texture IDs to acquire
+ */
+static const TextureID *scene_textures(SceneID id, int *count) {
+    static const TextureID MENU[] = {TEX_BG_STARFIELD, TEX_LOGO};
+    static const TextureID BACKGROUND[] = {TEX_BG_STARFIELD};
+    switch (id) {
+    case SCENE_MENU:
+        *count = (int)(sizeof(MENU) / sizeof(MENU[0]));
+        return MENU;
+    case SCENE_CAMPAIGN_MENU:
+    case SCENE_HELP:
+    case SCENE_CREDITS:
+    case SCENE_QUICK_PLAY_MENU:
+    case SCENE_QUICK_PLAY:
+    case SCENE_CAMPAIGN:
+    case SCENE_LOADING:
+        *count = (int)(sizeof(BACKGROUND) / sizeof(BACKGROUND[0]));
+        return BACKGROUND;
+    default:
+        *count = 0;
+        return NULL;
+    }
+}
+
+static void scene_hold_textures(SceneID id, bool hold) {
+    Services *svc = services_get();
+    if (!svc || !svc->texman) {
+        return;
+    }
+    int count = 0;
+    const TextureID *ids = scene_textures(id, &count);
+    for (int i = 0; i < count; i++) {
+        if (hold) {
+            texman_acquire(svc->texman, ids[i]);
+        } else {
+            texman_release(svc->texman, ids[i]);
+        }
+    }
+}
+
 Scene *scene_create(SceneID id) {
     Scene *s = calloc(1, sizeof(Scene));
     s->id = id;
     switch (id) {
     case SCENE_MENU:
         s->vt = &vt_menu;
+        s->redraw_on_demand = true;
         break;
     case SCENE_CAMPAIGN_MENU:
         s->vt = &vt_campaign_menu;
+        s->redraw_on_demand = true;
         break;
     case SCENE_HELP:
         s->vt = &vt_help;
+        s->redraw_on_demand = true;
         break;
     case SCENE_CREDITS:
         s->vt = &vt_credits;
+        s->redraw_on_demand = true;
         break;
     case SCENE_QUICK_PLAY_MENU:
         s->vt = &vt_qp_menu;
+        s->redraw_on_demand = true;
         break;
     case SCENE_QUICK_PLAY:
         s->vt = &vt_game;
@@ -87,6 +141,7 @@ Scene *scene_create(SceneID id) {
         s->is_overlay = true;
         s->blocks_under_input = true;
         s->blocks_under_update = true;
+        s->redraw_on_demand = true;
         break;
     case SCENE_OVERLAY_START_GAME:
         s->vt = &vt_start_game;
@@ -99,18 +154,21 @@ Scene *scene_create(SceneID id) {
         s->is_overlay = true;
         s->blocks_under_input = true;
         s->blocks_under_update = true;
+        s->redraw_on_demand = true;
         break;
     case SCENE_OVERLAY_ENDGAME:
         s->vt = &vt_endgame_qp;
         s->is_overlay = true;
         s->blocks_under_input = true;
         s->blocks_under_update = true;
+        s->redraw_on_demand = true;
         break;
     case SCENE_OVERLAY_ENDGAME_CAMPAIGN:
         s->vt = &vt_endgame_camp;
         s->is_overlay = true;
         s->blocks_under_input = true;
         s->blocks_under_update = true;
+        s->redraw_on_demand = true;
         break;
     case SCENE_LOADING:
         s->vt = &vt_load;
@@ -118,6 +176,7 @@ Scene *scene_create(SceneID id) {
     default:
         break;
     }
+    scene_hold_textures(id, true);
     return s;
 }
 
@@ -128,5 +187,6 @@ void scene_destroy(Scene *s) {
     if (s->state && s->vt && s->vt->leave) {
         s->vt->leave(s);
     }
+    scene_hold_textures(s->id, false);
     free(s);
 }
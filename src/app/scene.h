@@ -38,6 +38,10 @@ struct Scene {
     bool is_overlay;
     bool blocks_under_update;
     bool blocks_under_input;
+    /* Static scenes only need a new frame after input or when they set dirty.
+     * Scenes without this flag are treated as animating every frame. */
+    bool redraw_on_demand;
+    bool dirty;
     SceneID id;
 };
 
@@ -1,6 +1,8 @@
 #include "scenestack.h"
 #include <stdlib.h>
 #include <string.h>
+#include "../core/log.h"
+#include "../services/renderer.h"
 
 void scenestack_init(SceneStack *st) {
     memset(st, 0, sizeof(*st));
@@ -22,9 +24,16 @@ void scenestack_shutdown(SceneStack *st) {
         destroy_scene(&st->overlays[i]);
     }
     destroy_scene(&st->base);
+    if (st->base_cache) {
+        SDL_DestroyTexture(st->base_cache);
+        st->base_cache = NULL;
+    }
+    st->base_cache_valid = false;
 }
 
 bool scenestack_set_base(SceneStack *st, SceneID id) {
+    st->base_cache_valid = false;
+    st->changed = true;
     destroy_scene(&st->base);
     st->base = scene_create(id);
     if (!st->base) {
@@ -49,6 +58,9 @@ bool scenestack_push(SceneStack *st, SceneID id) {
     if (s->vt && s->vt->enter) {
         s->vt->enter(s);
     }
+    /* Re-snapshot the base on the next render so the cache shows its final state */
+    st->base_cache_valid = false;
+    st->changed = true;
     return true;
 }
 
@@ -58,6 +70,76 @@ void scenestack_pop(SceneStack *st) {
     }
     Scene *top = st->overlays[--st->overlay_count];
     scene_destroy(top);
+    st->base_cache_valid = false;
+    st->changed = true;
+}
+
+/**
+ * @brief Check whether any overlay stops the base scene from updating
+ * @param st Scene stack
+ * @return true if the base scene is frozen
+ */
+static bool base_is_frozen(const SceneStack *st) {
+    for (int i = 0; i < st->overlay_count; i++) {
+        if (st->overlays[i]->blocks_under_update) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Render the base scene into the cache texture if it is stale
+ * @param st Scene stack
+ * @param r Renderer
+ * @return true if base_cache holds a usable snapshot
+ */
+static bool refresh_base_cache(SceneStack *st, struct Renderer *r) {
+    if (st->base_cache_valid) {
+        return true;
+    }
+    if (st->base_cache_unsupported || !SDL_RenderTargetSupported(r->sdl)) {
+        st->base_cache_unsupported = true;
+        return false;
+    }
+
+    int w = 0, h = 0;
+    if (SDL_GetRendererOutputSize(r->sdl, &w, &h) != 0 || w <= 0 || h <= 0) {
+        return false;
+    }
+    if (st->base_cache && (st->base_cache_w != w || st->base_cache_h != h)) {
+        SDL_DestroyTexture(st->base_cache);
+        st->base_cache = NULL;
+    }
+    if (!st->base_cache) {
+        st->base_cache = SDL_CreateTexture(r->sdl, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!st->base_cache) {
+            LOG_WARN("scenestack", "Failed to create base scene cache: %s", SDL_GetError());
+            st->base_cache_unsupported = true;
+            return false;
+        }
+        /* The snapshot covers the whole screen, copy it without blending */
+        SDL_SetTextureBlendMode(st->base_cache, SDL_BLENDMODE_NONE);
+        st->base_cache_w = w;
+        st->base_cache_h = h;
+    }
+
+    SDL_Texture *prev = SDL_GetRenderTarget(r->sdl);
+    if (SDL_SetRenderTarget(r->sdl, st->base_cache) != 0) {
+        LOG_WARN("scenestack", "Failed to bind base scene cache: %s", SDL_GetError());
+        st->base_cache_unsupported = true;
+        return false;
+    }
+    SDL_SetRenderDrawColor(r->sdl, 0, 0, 0, 255);
+    SDL_RenderClear(r->sdl);
+    renderer_begin_frame(r);
+    renderer_set_pass(r, 0);
+    st->base->vt->render(st->base, r);
+    renderer_flush(r);
+    SDL_SetRenderTarget(r->sdl, prev);
+
+    st->base_cache_valid = true;
+    return true;
 }
 
 void scenestack_handle_input(SceneStack *st, const struct InputState *in) {
@@ -100,14 +182,61 @@ void scenestack_update(SceneStack *st, float dt) {
     }
 }
 
+/**
+ * @brief Check whether a single scene has something new to show
+ * @param s Scene
+ * @return true if the scene animates or was marked dirty
+ */
+static bool scene_needs_render(const Scene *s) {
+    return !s->redraw_on_demand || s->dirty;
+}
+
+bool scenestack_needs_render(const SceneStack *st) {
+    if (st->changed) {
+        return true;
+    }
+    for (int i = 0; i < st->overlay_count; i++) {
+        if (scene_needs_render(st->overlays[i])) {
+            return true;
+        }
+    }
+    if (!st->base) {
+        return false;
+    }
+    if (base_is_frozen(st) && st->base_cache_valid) {
+        return false;
+    }
+    return scene_needs_render(st->base);
+}
+
 void scenestack_render(SceneStack *st, struct Renderer *r) {
-    if (st->base && st->base->vt && st->base->vt->render) {
-        st->base->vt->render(st->base, r);
+    /* Scenes record into the render queue; each scene gets its own pass so
+     * overlays always end up above the scenes below them after sorting. */
+    bool has_base = st->base && st->base->vt && st->base->vt->render;
+    /* A frozen base scene looks the same every frame: draw it once into a
+     * texture and only blit that while the blocking overlay is open. */
+    bool use_cache = has_base && base_is_frozen(st) && refresh_base_cache(st, r);
+
+    renderer_begin_frame(r);
+    if (has_base) {
+        renderer_set_pass(r, 0);
+        if (use_cache) {
+            renderer_draw_texture(r, st->base_cache, NULL, NULL, 0.f);
+        } else {
+            st->base->vt->render(st->base, r);
+        }
     }
     for (int i = 0; i < st->overlay_count; i++) {
         Scene *s = st->overlays[i];
         if (s->vt && s->vt->render) {
+            renderer_set_pass(r, i + 1);
             s->vt->render(s, r);
         }
+        s->dirty = false;
+    }
+    renderer_flush(r);
+    if (st->base) {
+        st->base->dirty = false;
     }
+    st->changed = false;
 }
@@ -5,6 +5,12 @@ typedef struct SceneStack {
     Scene *base;
     Scene *overlays[8];
     int overlay_count;
+    /* Snapshot of the base scene, reused while an overlay blocks its updates */
+    SDL_Texture *base_cache;
+    int base_cache_w, base_cache_h;
+    bool base_cache_valid;
+    bool base_cache_unsupported;
+    bool changed;  // scenes were pushed, popped or replaced since the last render
 } SceneStack;
 
 /**
@@ -55,6 +61,16 @@ void scenestack_handle_input(SceneStack *st, const struct InputState *in);
  */
 void scenestack_update(SceneStack *st, float dt);
 
+/**
+ * @brief Check whether the stack has to draw a new frame
+ *
+ * False only when every visible scene is redraw_on_demand and clean (a frozen,
+ * cached base scene counts as clean) and the stack did not change.
+ * @param st Scene stack
+ * @return true if scenestack_render() would produce a different image
+ */
+bool scenestack_needs_render(const SceneStack *st);
+
 /**
  * @brief Render all scenes in the stack
  * @param st Scene stack
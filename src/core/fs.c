@@ -0,0 +1,184 @@
+#include "fs.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef PLATFORM_VITA
+#include <psp2/io/stat.h>
+#elif defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define FS_HAVE_MMAP 1
+#endif
+
+const char *fs_cache_dir(void) {
+#ifdef PLATFORM_VITA
+    return "ux0:/data/GravityHunters/cache";
+#else
+    return "./cache";
+#endif
+}
+
+int fs_ensure_parent_dirs(const char *path) {
+
+    if (!path || !*path)
+        return -1;
+
+    size_t len = strlen(path);
+    if (len == 0)
+        return -1;
+
+    char buffer[512];
+    if (len >= sizeof(buffer))
+        return -1;
+    memcpy(buffer, path, len + 1);
+
+    for (size_t i = 1; i < len; ++i) {
+        if (buffer[i] == '/') {
+            char saved = buffer[i];
+            buffer[i] = '\0';
+            if (buffer[i - 1] != ':') {
+#ifdef PLATFORM_VITA
+                int res = sceIoMkdir(buffer, 0777);
+                if (res < 0) {
+                    SceIoStat stat_info;
+                    memset(&stat_info, 0, sizeof(stat_info));
+                    if (sceIoGetstat(buffer, &stat_info) < 0) {
+                        buffer[i] = saved;
+                        return -1;
+                    }
+                }
+#else
+                if (mkdir(buffer, 0777) != 0 && errno != EEXIST) {
+                    buffer[i] = saved;
+                    return -1;
+                }
+#endif
+            }
+            buffer[i] = saved;
+        }
+    }
+    return 0;
+}
+
+bool fs_map_file(const char *path, FsMapping *out) {
+    if (!path || !out)
+        return false;
+    memset(out, 0, sizeof(*out));
+#ifdef FS_HAVE_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return false;
+    out->data = p;
+    out->size = (size_t)st.st_size;
+    out->mapped = true;
+    return true;
+#else
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    if (fseek(f, 0, SEEK_END) != 0) {
+        fclose(f);
+        return false;
+    }
+    long size = ftell(f);
+    if (size <= 0 || fseek(f, 0, SEEK_SET) != 0) {
+        fclose(f);
+        return false;
+    }
+    // malloc only guarantees 8 bytes on Vita newlib; round up by hand
+    void *block = malloc((size_t)size + FS_MAP_ALIGN - 1);
+    if (!block) {
+        fclose(f);
+        return false;
+    }
+    uint8_t *buf = (uint8_t *)(((uintptr_t)block + FS_MAP_ALIGN - 1) & ~(uintptr_t)(FS_MAP_ALIGN - 1));
+    if (fread(buf, 1, (size_t)size, f) != (size_t)size) {
+        free(block);
+        fclose(f);
+        return false;
+    }
+    fclose(f);
+    out->data = buf;
+    out->size = (size_t)size;
+    out->block = block;
+    return true;
+#endif
+}
+
+void fs_unmap_file(FsMapping *m) {
+    if (!m || !m->data)
+        return;
+#ifdef FS_HAVE_MMAP
+    if (m->mapped)
+        munmap((void *)m->data, m->size);
+    else
+        free(m->block);
+#else
+    free(m->block);
+#endif
+    memset(m, 0, sizeof(*m));
+}
+
+/* Push the file's data to the storage device before it is renamed into place */
+static bool fs_sync_file(FILE *f) {
+    if (fflush(f) != 0)
+        return false;
+#if defined(_WIN32)
+    return _commit(_fileno(f)) == 0;
+#elif defined(PLATFORM_VITA)
+    return true; /* stdio has no fsync here; fclose hands the data to the IO layer */
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+bool fs_write_file_atomic(const char *path, const void *head, size_t head_size, const void *body, size_t body_size) {
+    if (!path)
+        return false;
+    if (fs_ensure_parent_dirs(path) != 0)
+        return false;
+    char tmp[512];
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp))
+        return false;
+    FILE *f = fopen(tmp, "wb");
+    if (!f)
+        return false;
+    bool ok = true;
+    if (head && head_size)
+        ok = fwrite(head, 1, head_size, f) == head_size;
+    if (ok && body && body_size)
+        ok = fwrite(body, 1, body_size, f) == body_size;
+    if (ok)
+        ok = fs_sync_file(f);
+    if (fclose(f) != 0)
+        ok = false;
+    if (!ok) {
+        remove(tmp);
+        return false;
+    }
+#ifndef FS_HAVE_MMAP
+    /* rename() does not replace an existing file here; POSIX replaces atomically */
+    remove(path);
+#endif
+    /* On failure the complete tmp file stays behind for the loader to recover */
+    return rename(tmp, path) == 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Read-only view of a whole file.
+ *
+ * On POSIX PC builds the file is memory-mapped; elsewhere (Vita) it is read
+ * into a heap buffer aligned to FS_MAP_ALIGN, so data is at least as aligned
+ * as a page mapping needs to be for the formats read in place (levels, pack).
+ * Callers only see data/size either way.
+ */
+#define FS_MAP_ALIGN 64
+
+typedef struct FsMapping {
+    const void *data;
+    size_t size;
+    bool mapped; // true if data came from mmap
+    void *block; // heap allocation behind data when not mapped
+} FsMapping;
+
+/**
+ * @brief Directory for regenerable data (nebula cache, thumbnails, ...)
+ * @return Path without trailing slash
+ */
+const char *fs_cache_dir(void);
+
+/**
+ * @brief Create every missing directory on the way to path (the last component is treated as a file)
+ * @param path File path
+ * @return 0 on success, -1 on failure
+ */
+int fs_ensure_parent_dirs(const char *path);
+
+/**
+ * @brief Map or read a whole file
+ * @param path File path
+ * @param out Filled on success
+ * @return true on success
+ */
+bool fs_map_file(const char *path, FsMapping *out);
+
+/**
+ * @brief Release a mapping from fs_map_file
+ * @param m Mapping (reset to empty)
+ */
+void fs_unmap_file(FsMapping *m);
+
+/**
+ * @brief Write a file via a temporary sibling and rename, so readers never see a partial file
+ *
+ * The sibling (path + ".tmp") is synced to storage before the rename. If the
+ * rename fails it is kept, so a caller can recover the new contents from it.
+ * @param path Destination path
+ * @param head Optional header bytes written first
+ * @param head_size Header size
+ * @param body Payload
+ * @param body_size Payload size
+ * @return true on success
+ */
+bool fs_write_file_atomic(const char *path, const void *head, size_t head_size, const void *body, size_t body_size);
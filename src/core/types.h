@@ -8,7 +8,27 @@
  * Using 1/60 aligns with display refresh for steadier perceived motion on Vita. */
 #define FIXED_DT (1.0f/60.0f)
 
+/* Step gameplay worlds on a worker thread and render from published snapshots
+ * (see game/world_runner.h). Off by default; enable with -DGH_SIM_THREAD=ON. */
+#ifndef WORLD_SIM_THREAD
+#define WORLD_SIM_THREAD 0
+#endif
+
 // Menu
+/* Longest time the main loop sleeps in SDL_WaitEventTimeout while every scene is idle */
+#define APP_IDLE_WAIT_MS        100
+/* Main-thread time per frame spent turning decoded startup assets into textures */
+#ifndef BOOT_LOAD_SLICE_MS
+#define BOOT_LOAD_SLICE_MS      4.0
+#endif
+/* Quality governor (services/quality.h): per-frame work budget and how long
+ * the average has to stay over / under it before the tier changes */
+#ifndef QUALITY_FRAME_BUDGET_MS
+#define QUALITY_FRAME_BUDGET_MS 16.6
+#endif
+#define QUALITY_DOWN_FRAMES     30  /* ~0.5 s over budget -> one tier down */
+#define QUALITY_UP_FRAMES       240 /* ~4 s with headroom -> one tier up */
+#define QUALITY_HOLD_FRAMES     120 /* no further change right after a switch */
 #define MENU_REPEAT_DELAY_MS    500u
 #define MENU_REPEAT_INTERVAL_MS 100u
 #define MENU_COLOR_BUTTON_BASE            (SDL_Color){34, 34, 34, 255}
@@ -22,12 +42,25 @@
 #define OVERLAY_BACKDROP_COLOR            (SDL_Color){0, 0, 0, 160}
 
 // World
-#define MAX_ENEMIES 9
-#define MAX_PLANETS 16
-#define MAX_SHOOTERS 10
-#define MAX_PROJECTILES_PER_SHOOTER 100
+/* Starting capacities of the growable world storage; levels reserve their own
+ * planet/enemy counts at load, so these only matter for ad-hoc spawning. */
+#ifndef WORLD_INITIAL_PLANETS
+#define WORLD_INITIAL_PLANETS 16
+#endif
+#ifndef WORLD_INITIAL_ENEMIES
+#define WORLD_INITIAL_ENEMIES 16
+#endif
+#ifndef PROJ_POOL_INITIAL
+#define PROJ_POOL_INITIAL 8 // projectile slots per shooter before it grows
+#endif
+#define MAX_PROJECTILES_PER_SHOOTER 100 // in flight at once per shooter (gameplay limit)
+/* Enemy shot-search samples per tick across all enemies; above it enemies
+ * take turns searching (see world_update). */
+#ifndef WORLD_AI_SAMPLES_PER_TICK
+#define WORLD_AI_SAMPLES_PER_TICK 96
+#endif
 #define TRAIL_LEN 10
-#define MAX_EXPLOSIONS 64
+#define MAX_EFFECTS 1024 // pooled explosion/debris particles
 
 typedef unsigned int u32;
 
@@ -41,6 +74,8 @@ typedef struct Vec2 { float x, y; } Vec2;
 #ifndef PROJ_EPSILON
 #define PROJ_EPSILON 0.0001f
 #endif
+/* Planet mass per squared radius (mass = pi * r^2) */
+#define PLANET_MASS_FACTOR M_PI
 
 #define PROJ_DAMAGE_INCREASE_PER_SECOND 5
 
@@ -49,6 +84,20 @@ typedef struct Vec2 { float x, y; } Vec2;
 #define SIM_MAX_PROJECTILE_TIME 3.0f
 #endif
 
+/* Planet field (game/planet_field.h): node spacing of the gravity and distance
+ * grids, distance from a planet surface below which gravity is summed exactly,
+ * broadphase cell size and the extra area covered around the display. Baked
+ * level data carries its own geometry, so changing these only affects grids
+ * computed at load and the compiler's defaults. */
+#ifndef PLANET_FIELD_CELL
+#define PLANET_FIELD_CELL 16.0f
+#endif
+#ifndef PLANET_FIELD_NEAR
+#define PLANET_FIELD_NEAR 32.0f
+#endif
+#define PLANET_FIELD_BROAD_CELL 64.0f
+#define PLANET_FIELD_MARGIN 0.2f
+
 /* Numeric constants */
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -66,6 +115,29 @@ typedef struct Vec2 { float x, y; } Vec2;
 #ifndef TEXF_SHEET
 #define TEXF_SHEET (1u << 0)
 #endif
+#ifndef TEXF_ATLAS
+#define TEXF_ATLAS (1u << 1) /* packed into a shared atlas page */
+#endif
+#ifndef TEXF_RGB565
+#define TEXF_RGB565 (1u << 2) /* opaque 16-bit copy (alpha composited over black), if the renderer supports it */
+#endif
+
+/* Sprite atlas: pages are PAGE_SIZE wide and trimmed to the used height */
+#ifndef TEXMAN_ATLAS_PAGE_SIZE
+#define TEXMAN_ATLAS_PAGE_SIZE 1024
+#endif
+#ifndef TEXMAN_ATLAS_MAX_PAGES
+#define TEXMAN_ATLAS_MAX_PAGES 2
+#endif
+#ifndef TEXMAN_ATLAS_PADDING
+#define TEXMAN_ATLAS_PADDING 2 /* transparent gutter against linear-filter bleed */
+#endif
+/* Texture residency budget (bytes). Unreferenced standalone textures are
+ * dropped once the resident set exceeds it. The pinned atlas plus the nebula
+ * already come close, so menu-only art (logo) is released during gameplay. */
+#ifndef TEXMAN_VRAM_BUDGET
+#define TEXMAN_VRAM_BUDGET (4u * 1024u * 1024u)
+#endif
 
 /* Enemy constants */
 #ifndef ENEMY_SHOT_HIT_RADIUS
@@ -0,0 +1,142 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fs.h"
+
+/**
+ * @brief Read-only asset access backed by the packed archive.
+ *
+ * vfs_mount maps <assets_root>/assets.pak (built by assets/pack_assets.py).
+ * Lookups are served as zero-copy views into that mapping; anything missing
+ * from the pack (or the whole pack, during development) falls back to the
+ * loose file under the assets root.
+ *
+ * Pack layout, little endian:
+ *   VfsPackHeader, then section_count VfsPackSection records sorted by path,
+ *   then the section payloads, each aligned to 64 bytes. Every payload has a
+ *   CRC32 which is checked the first time the section is opened.
+ */
+
+#define VFS_PACK_NAME "assets.pak"
+#define VFS_PACK_VERSION 1
+#define VFS_PATH_MAX 64
+
+typedef enum VfsKind {
+    VFS_RAW = 0,     // file bytes as on disk
+    VFS_TEXTURE = 1  // pre-decoded pixels (width/height/pitch/format valid)
+} VfsKind;
+
+typedef enum VfsFormat {
+    VFS_FORMAT_NONE = 0,
+    VFS_FORMAT_RGBA32 = 1 // bytes R,G,B,A (SDL_PIXELFORMAT_RGBA32)
+} VfsFormat;
+
+#pragma pack(push, 1)
+typedef struct VfsPackHeader {
+    char magic[4];          // "GHPK"
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t section_count;
+    uint32_t table_offset;
+    uint32_t table_crc;
+    uint32_t total_size;
+    uint8_t reserved[8];
+} VfsPackHeader;
+
+typedef struct VfsPackSection {
+    char path[VFS_PATH_MAX]; // relative to the assets root, NUL terminated
+    uint32_t kind;           // VfsKind
+    uint32_t offset;
+    uint32_t size;
+    uint32_t crc;
+    uint16_t width, height;
+    uint32_t format;         // VfsFormat
+    uint32_t pitch;
+    uint8_t reserved[4];
+} VfsPackSection;
+#pragma pack(pop)
+
+/**
+ * @brief An opened asset. data stays valid until vfs_close (or vfs_unmount
+ *        for packed files).
+ */
+typedef struct VfsFile {
+    const void *data;
+    size_t size;
+    VfsKind kind;
+    VfsFormat format;
+    int width, height, pitch;
+    bool packed;       // served from the archive
+    FsMapping loose;   // backing mapping of a loose file
+} VfsFile;
+
+/**
+ * @brief Mount the asset root and its archive, if present
+ * @param assets_root Directory holding the assets (no trailing slash)
+ * @return true if an archive was mounted; loose files work either way
+ */
+bool vfs_mount(const char *assets_root);
+
+/**
+ * @brief Release the archive mapping. Views handed out become invalid.
+ */
+void vfs_unmount(void);
+
+/**
+ * @brief Asset root passed to vfs_mount
+ * @return Path without trailing slash
+ */
+const char *vfs_root(void);
+
+/**
+ * @brief Open an asset by path relative to the assets root
+ *        (absolute paths skip the archive)
+ * @param path Asset path, e.g. "levels/01_-_Intro.lvl"
+ * @param out Filled on success
+ * @return true on success
+ */
+bool vfs_open(const char *path, VfsFile *out);
+
+/**
+ * @brief Like vfs_open, but only succeeds for archived files (no loose fallback)
+ * @param path Asset path relative to the assets root
+ * @param out Filled on success; the view lives until vfs_unmount
+ * @return true if the archive holds a valid copy
+ */
+bool vfs_open_packed(const char *path, VfsFile *out);
+
+/**
+ * @brief Size and checksum of an archived file, straight from the section table
+ *        (no data access, no verification)
+ * @param path Asset path relative to the assets root
+ * @param size Receives the payload size (optional)
+ * @param crc Receives the payload CRC32 (optional)
+ * @return true if the archive holds the file
+ */
+bool vfs_packed_info(const char *path, size_t *size, uint32_t *crc);
+
+/**
+ * @brief Release an asset from vfs_open
+ * @param f File (reset to empty)
+ */
+void vfs_close(VfsFile *f);
+
+/**
+ * @brief Enumerate archived files directly inside a directory
+ * @param dir Directory relative to the assets root, e.g. "levels"
+ * @param fn Called with each file name (without the directory)
+ * @param user Passed to fn
+ * @return Number of entries, or -1 if no archive is mounted
+ */
+int vfs_list(const char *dir, void (*fn)(const char *name, void *user), void *user);
+
+/**
+ * @brief CRC32 (IEEE 802.3), as used for pack checksums
+ * @param crc Previous value (0 to start)
+ * @param data Bytes
+ * @param size Byte count
+ * @return Updated CRC
+ */
+uint32_t vfs_crc32(uint32_t crc, const void *data, size_t size);
@@ -12,7 +12,10 @@
 #include <sys/stat.h>
 
 #include <strings.h> // strcasecmp
+#include <SDL2/SDL.h>
 #include "../core/log.h"
+#include "../core/vfs.h"
+#include "level_loader.h"
 
 #ifndef PATH_MAX
 #define PATH_MAX 256
@@ -21,6 +24,21 @@
 
 #define LEVEL_EXTENSION ".lvl"
 
+_Static_assert(sizeof(CampaignIndexHeader) == 32, "catalog index header layout");
+_Static_assert(sizeof(CampaignIndexEntry) == 88, "catalog index entry layout");
+
+// Level metadata for menus, loaded once per run
+static struct {
+    bool loaded;
+    VfsFile file;                 // prebuilt catalog.idx
+    CampaignIndexEntry *built;    // records built by the fallback scan
+    char *built_text;
+    const CampaignIndexEntry *entries;
+    const char *text;
+    size_t text_size;
+    int count;
+} g_index;
+
 static int ensure_descriptor_capacity(CampaignLevelList *list, int min_capacity) {
 
     if (!list)
@@ -157,6 +175,30 @@ static void handle_long_name_warning(const char *name) {
 
 }
 
+typedef struct PackedScan {
+    CampaignLevelList *list;
+    int failed;
+} PackedScan;
+
+static void add_packed_level(const char *name, void *user) {
+
+    PackedScan *scan = (PackedScan *)user;
+    if (scan->failed || !has_level_extension(name))
+        return;
+    size_t len = strlen(name);
+    if (len >= CAMPAIGN_LEVEL_MAX_FILENAME) {
+        handle_long_name_warning(name);
+        return;
+    }
+    if (ensure_descriptor_capacity(scan->list, scan->list->count + 1) != 0) {
+        scan->failed = 1;
+        return;
+    }
+    CampaignLevelDescriptor *dst = &scan->list->items[scan->list->count++];
+    memcpy(dst->filename, name, len + 1);
+
+}
+
 int campaign_levels_scan(CampaignLevelList *list, const char *levels_root) {
 
     if (!list)
@@ -164,6 +206,17 @@ int campaign_levels_scan(CampaignLevelList *list, const char *levels_root) {
 
     campaign_levels_free(list);
 
+    // The asset pack already holds the level list; no directory walk needed
+    if (!levels_root || !levels_root[0]) {
+        PackedScan scan = { list, 0 };
+        if (vfs_list("levels", add_packed_level, &scan) > 0 && !scan.failed && list->count > 0) {
+            if (list->count > 1)
+                qsort(list->items, (size_t)list->count, sizeof(*list->items), compare_descriptors);
+            return 0;
+        }
+        campaign_levels_free(list);
+    }
+
     const char *root = (levels_root && levels_root[0]) ? levels_root : campaign_levels_default_root();
     if (!root)
         return -1;
@@ -264,3 +317,220 @@ int campaign_level_catalog_from_descriptors(const CampaignLevelList *src, Campai
     campaign_level_catalog_apply_progress(dst, progress);
     return 0;
 }
+
+static bool index_level_matches(const CampaignIndexEntry *entry) {
+
+    char path[64];
+    snprintf(path, sizeof(path), "levels/%s", entry->filename);
+    size_t size = 0;
+    uint32_t crc = 0;
+    // The pack's section table already carries the checksum of every level
+    if (vfs_packed_info(path, &size, &crc))
+        return size == entry->content_size && crc == entry->content_hash;
+    VfsFile f;
+    if (!vfs_open(path, &f))
+        return false;
+    bool ok = f.size == entry->content_size && vfs_crc32(0, f.data, f.size) == entry->content_hash;
+    vfs_close(&f);
+    return ok;
+
+}
+
+static bool index_open_prebuilt(const CampaignLevelList *levels) {
+
+    VfsFile *f = &g_index.file;
+    if (!vfs_open("levels/" CAMPAIGN_INDEX_NAME, f))
+        return false;
+
+    const uint8_t *base = (const uint8_t *)f->data;
+    const CampaignIndexHeader *h = (const CampaignIndexHeader *)base;
+    const char *why = NULL;
+    if (f->size < sizeof(*h) || memcmp(h->magic, "GHCI", 4) != 0)
+        why = "bad magic";
+    else if (h->version != CAMPAIGN_INDEX_VERSION || h->header_size != sizeof(*h) || h->entry_size != sizeof(CampaignIndexEntry))
+        why = "unsupported version";
+    else if ((uint64_t)h->header_size + (uint64_t)h->count * sizeof(CampaignIndexEntry) > h->text_offset ||
+             (uint64_t)h->text_offset + h->text_size > f->size)
+        why = "truncated";
+    else if (!f->packed && vfs_crc32(0, base + sizeof(*h), f->size - sizeof(*h)) != h->crc)
+        why = "checksum mismatch";
+    if (why) {
+        LOG_WARN("campaign_levels", "Ignoring %s: %s", CAMPAIGN_INDEX_NAME, why);
+        vfs_close(f);
+        return false;
+    }
+
+    const CampaignIndexEntry *entries = (const CampaignIndexEntry *)(base + sizeof(*h));
+    const char *text = (const char *)(base + h->text_offset);
+    bool fresh = (int)h->count == levels->count;
+    for (int i = 0; fresh && i < levels->count; ++i) {
+        const CampaignIndexEntry *e = &entries[i];
+        fresh = memchr(e->filename, '\0', sizeof(e->filename)) && memchr(e->display_name, '\0', sizeof(e->display_name)) &&
+                (uint64_t)e->text_offset + e->text_size < h->text_size && text[e->text_offset + e->text_size] == '\0' &&
+                strcmp(e->filename, levels->items[i].filename) == 0 && index_level_matches(e);
+    }
+    if (!fresh) {
+        LOG_INFO("campaign_levels", "%s is out of date, scanning levels", CAMPAIGN_INDEX_NAME);
+        vfs_close(f);
+        return false;
+    }
+
+    g_index.entries = entries;
+    g_index.count = (int)h->count;
+    g_index.text = text;
+    g_index.text_size = h->text_size;
+    return true;
+
+}
+
+// Fallback: load every level once and fill the same records the compiler writes
+static bool index_build(const CampaignLevelList *levels) {
+
+    g_index.built = calloc(levels->count ? (size_t)levels->count : 1, sizeof(CampaignIndexEntry));
+    if (!g_index.built)
+        return false;
+    size_t text_size = 0;
+    for (int i = 0; i < levels->count; ++i) {
+        const char *name = levels->items[i].filename;
+        CampaignIndexEntry *e = &g_index.built[g_index.count];
+        char path[64];
+        snprintf(path, sizeof(path), "levels/%s", name);
+        VfsFile f;
+        if (!vfs_open(path, &f))
+            continue;
+        e->content_size = (uint32_t)f.size;
+        e->content_hash = vfs_crc32(0, f.data, f.size);
+        vfs_close(&f);
+
+        GameLevel lvl;
+        char err[128] = {0};
+        if (level_load(name, &lvl, err, sizeof(err)) != 0) {
+            LOG_WARN("campaign_levels", "Skipping level '%s': %s", name, err);
+            memset(e, 0, sizeof(*e));
+            continue;
+        }
+        snprintf(e->filename, sizeof(e->filename), "%s", name);
+        campaign_level_format_display_name(name, e->display_name, sizeof(e->display_name));
+        e->time_limit = lvl.time_limit;
+        e->goal_kills = lvl.goal_kills;
+        memcpy(e->rating, lvl.rating, sizeof(e->rating));
+        e->planets_count = lvl.planets_count;
+        e->enemies_count = lvl.enemies_count;
+        size_t len = lvl.start_text ? strlen(lvl.start_text) : 0;
+        char *text = realloc(g_index.built_text, text_size + len + 1);
+        if (!text) {
+            level_free(&lvl);
+            return false;
+        }
+        memcpy(text + text_size, lvl.start_text ? lvl.start_text : "", len + 1);
+        g_index.built_text = text;
+        e->text_offset = (uint32_t)text_size;
+        e->text_size = (uint32_t)len;
+        text_size += len + 1;
+        level_free(&lvl);
+        g_index.count++;
+    }
+    g_index.entries = g_index.built;
+    g_index.text = g_index.built_text ? g_index.built_text : "";
+    g_index.text_size = text_size;
+    return true;
+
+}
+
+int campaign_levels_index_load(void) {
+
+    if (g_index.loaded)
+        return g_index.count;
+
+    // With the asset pack mounted this is a walk over the in-memory section table
+    CampaignLevelList levels = {0};
+    if (campaign_levels_scan(&levels, NULL) != 0)
+        return -1;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    bool prebuilt = index_open_prebuilt(&levels);
+    if (!prebuilt && !index_build(&levels)) {
+        LOG_ERROR("campaign_levels", "Failed to build the level index");
+        campaign_levels_free(&levels);
+        campaign_levels_index_release();
+        return -1;
+    }
+    campaign_levels_free(&levels);
+    g_index.loaded = true;
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    LOG_INFO("campaign_levels", "Level index: %d levels from %s in %.2f ms", g_index.count,
+             prebuilt ? CAMPAIGN_INDEX_NAME : "a level scan", ms);
+    return g_index.count;
+
+}
+
+const CampaignIndexEntry *campaign_levels_index_entry(int index) {
+
+    if (index < 0 || index >= g_index.count)
+        return NULL;
+    return &g_index.entries[index];
+
+}
+
+const CampaignIndexEntry *campaign_levels_index_find(const char *filename) {
+
+    if (!filename)
+        return NULL;
+    for (int i = 0; i < g_index.count; ++i) {
+        if (strcmp(g_index.entries[i].filename, filename) == 0)
+            return &g_index.entries[i];
+    }
+    return NULL;
+
+}
+
+const char *campaign_levels_index_text(const CampaignIndexEntry *entry) {
+
+    if (!entry || !g_index.text || entry->text_offset >= g_index.text_size)
+        return "";
+    return g_index.text + entry->text_offset;
+
+}
+
+void campaign_levels_index_release(void) {
+
+    vfs_close(&g_index.file);
+    free(g_index.built);
+    free(g_index.built_text);
+    memset(&g_index, 0, sizeof(g_index));
+
+}
+
+int campaign_level_catalog_from_index(CampaignLevelCatalog *dst) {
+
+    if (!dst)
+        return -1;
+
+    campaign_level_catalog_free(dst);
+
+    int count = campaign_levels_index_load();
+    if (count < 0)
+        return -1;
+    if (count == 0)
+        return 0;
+
+    if (ensure_catalog_capacity(dst, count) != 0) {
+        campaign_level_catalog_free(dst);
+        return -1;
+
+}
+
+    for (int i = 0; i < count; ++i) {
+
+        const CampaignIndexEntry *e = &g_index.entries[i];
+        CampaignLevelInfo *info = &dst->items[i];
+        campaign_level_info_init(info, e->filename);
+        if (e->display_name[0])
+            snprintf(info->display_name, sizeof(info->display_name), "%s", e->display_name);
+
+    }
+    dst->count = count;
+    CampaignProgress *progress = campaign_progress_data();
+    campaign_level_catalog_apply_progress(dst, progress);
+    return 0;
+}
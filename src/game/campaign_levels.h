@@ -39,6 +39,40 @@ typedef struct CampaignLevelCatalog {
     int capacity;
 } CampaignLevelCatalog;
 
+// Prebuilt catalog index written by assets/levels/level_compiler.py next to
+// the levels. Little endian: CampaignIndexHeader, 'count' CampaignIndexEntry
+// records sorted like campaign_levels_scan, then the NUL-terminated start
+// texts. The header CRC32 covers everything after the header.
+#define CAMPAIGN_INDEX_NAME "catalog.idx"
+#define CAMPAIGN_INDEX_VERSION 1
+
+typedef struct CampaignIndexHeader {
+    char magic[4];          // "GHCI"
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t count;
+    uint32_t entry_size;
+    uint32_t text_offset;   // from the start of the file
+    uint32_t text_size;
+    uint32_t crc;
+    uint8_t reserved[4];
+} CampaignIndexHeader;
+
+typedef struct CampaignIndexEntry {
+    char filename[CAMPAIGN_LEVEL_MAX_FILENAME];
+    char display_name[CAMPAIGN_LEVEL_MAX_DISPLAY_NAME];
+    uint32_t content_hash;  // CRC32 of the .lvl file
+    uint32_t content_size;  // .lvl size in bytes
+    uint32_t time_limit;
+    uint32_t rating[3];
+    uint16_t goal_kills;
+    uint16_t reserved;
+    uint32_t planets_count;
+    uint32_t enemies_count;
+    uint32_t text_offset;   // start text, relative to the text block
+    uint32_t text_size;     // without the NUL
+} CampaignIndexEntry;
+
 // Returns the default filesystem root where campaign levels are stored.
 // On Vita this resolves to "app0:/assets/levels", otherwise "./assets/levels".
 const char *campaign_levels_default_root(void);
@@ -60,6 +94,29 @@ void campaign_levels_free(CampaignLevelList *list);
 // extension, unlocked=false, stars_earned=0.
 void campaign_level_info_init(CampaignLevelInfo *info, const char *filename);
 
+// Loads the level index once per run and keeps it for later calls. Uses the
+// prebuilt catalog when it is present and matches the shipped levels
+// (checked against the asset pack without touching level data), otherwise
+// scans the levels and loads each one to build the same records.
+// Returns the number of levels, or negative on failure.
+int campaign_levels_index_load(void);
+
+// Index entry by position (sorted like campaign_levels_scan) or NULL.
+const CampaignIndexEntry *campaign_levels_index_entry(int index);
+
+// Index entry for a level filename or NULL.
+const CampaignIndexEntry *campaign_levels_index_find(const char *filename);
+
+// Start text of an index entry ("" if none).
+const char *campaign_levels_index_text(const CampaignIndexEntry *entry);
+
+// Drops the cached index (the next campaign_levels_index_load rebuilds it).
+void campaign_levels_index_release(void);
+
+// Populates the catalog from the cached index and applies campaign progress.
+// Existing catalog contents are cleared first. Returns 0 on success, negative on failure.
+int campaign_level_catalog_from_index(CampaignLevelCatalog *dst);
+
 // Releases memory owned by the catalog and resets it to empty.
 void campaign_level_catalog_free(CampaignLevelCatalog *catalog);
 
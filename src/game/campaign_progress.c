@@ -1,24 +1,42 @@
 #include "campaign_progress.h"
 
-#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#include <sys/stat.h>
-#include <sys/types.h>
+#include <SDL2/SDL.h>
 
-#ifdef PLATFORM_VITA
-#include <psp2/io/stat.h>
-#endif
+#include "../core/fs.h"
+#include "../core/log.h"
+#include "../core/vfs.h"
 
 #define PROGRESS_MAGIC "GHSV"
 #define PROGRESS_VERSION 1
 #define PROGRESS_MAX_ENTRIES 2048
+#define PROGRESS_HEADER_SIZE 12                                  // magic, version, reserved, count
+#define PROGRESS_RECORD_SIZE (CAMPAIGN_LEVEL_MAX_FILENAME + 1 + 4) // name, stars, score
+#define PROGRESS_JOURNAL_RECORD_SIZE (PROGRESS_RECORD_SIZE + 4)    // + crc32
+#define PROGRESS_COMPACT_RECORDS 16
 
 static CampaignProgress g_progress = {0};
 static bool g_progress_loaded = false;
 
+// Background writer: the main thread only encodes bytes and hands them over
+static struct {
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    SDL_cond *wake;
+    SDL_cond *idle;
+    bool quit;
+    bool busy;
+    char path[256];
+    uint8_t *journal;       // encoded journal records waiting to be appended
+    size_t journal_size;
+    size_t journal_cap;
+    uint8_t *snapshot;      // full save waiting to replace the snapshot (supersedes 'journal')
+    size_t snapshot_size;
+} g_writer;
+
 static int ensure_entry_capacity(CampaignProgress *progress, int min_capacity) {
 
     if (!progress)
@@ -40,46 +58,49 @@ static int ensure_entry_capacity(CampaignProgress *progress, int min_capacity) {
 
 }
 
-static int ensure_parent_directories(const char *path) {
+static uint32_t progress_hash(const char *name) {
 
-    if (!path || !*path)
-        return -1;
+    uint32_t h = 2166136261u; // FNV-1a
+    for (int i = 0; i < CAMPAIGN_LEVEL_MAX_FILENAME && name[i]; ++i) {
+        h ^= (uint8_t)name[i];
+        h *= 16777619u;
+    }
+    return h;
 
-    size_t len = strlen(path);
-    if (len == 0)
-        return -1;
+}
 
-    char buffer[512];
-    if (len >= sizeof(buffer))
-        return -1;
-    memcpy(buffer, path, len + 1);
-
-    for (size_t i = 1; i < len; ++i) {
-        if (buffer[i] == '/') {
-            char saved = buffer[i];
-            buffer[i] = '\0';
-            if (buffer[i - 1] != ':') {
-#ifdef PLATFORM_VITA
-                int res = sceIoMkdir(buffer, 0777);
-                if (res < 0) {
-                    SceIoStat stat_info;
-                    memset(&stat_info, 0, sizeof(stat_info));
-                    if (sceIoGetstat(buffer, &stat_info) < 0) {
-                        buffer[i] = saved;
-                        return -1;
-                    }
-                }
-#else
-                if (mkdir(buffer, 0777) != 0 && errno != EEXIST) {
-                    buffer[i] = saved;
-                    return -1;
-                }
-#endif
-            }
-            buffer[i] = saved;
-        }
+static int progress_slot(const CampaignProgress *progress, const char *filename) {
+
+    uint32_t mask = (uint32_t)progress->slot_count - 1;
+    uint32_t i = progress_hash(filename) & mask;
+    while (progress->slots[i] >= 0 &&
+           strncmp(progress->entries[progress->slots[i]].filename, filename, CAMPAIGN_LEVEL_MAX_FILENAME) != 0)
+        i = (i + 1) & mask;
+    return (int)i;
+
+}
+
+// Keeps the table at most half full; rebuilt from the entries when it grows
+static int progress_index_add(CampaignProgress *progress, int entry) {
+
+    if ((progress->count) * 2 > progress->slot_count) {
+        int slot_count = progress->slot_count > 0 ? progress->slot_count : 16;
+        while (progress->count * 2 > slot_count)
+            slot_count *= 2;
+        int *slots = (int *)malloc((size_t)slot_count * sizeof(*slots));
+        if (!slots)
+            return -1;
+        free(progress->slots);
+        progress->slots = slots;
+        progress->slot_count = slot_count;
+        memset(slots, 0xFF, (size_t)slot_count * sizeof(*slots));
+        for (int i = 0; i < progress->count; ++i)
+            progress->slots[progress_slot(progress, progress->entries[i].filename)] = i;
+        return 0;
     }
+    progress->slots[progress_slot(progress, progress->entries[entry].filename)] = entry;
     return 0;
+
 }
 
 const char *campaign_progress_default_path(void) {
@@ -97,122 +118,285 @@ void campaign_progress_free(CampaignProgress *progress) {
     if (!progress)
         return;
     free(progress->entries);
+    free(progress->slots);
     progress->entries = NULL;
+    progress->slots = NULL;
+    progress->slot_count = 0;
     progress->count = 0;
     progress->capacity = 0;
     progress->dirty = false;
+    progress->journal_records = 0;
 
 }
 
-static int write_empty_save(const char *path) {
+static void encode_record(uint8_t *dst, const CampaignProgressEntry *entry) {
 
-    if (!path)
-        return -1;
-    if (ensure_parent_directories(path) != 0)
-        return -1;
-    FILE *f = fopen(path, "wb");
-    if (!f)
-        return -1;
-    const char magic[4] = PROGRESS_MAGIC;
+    memset(dst, 0, CAMPAIGN_LEVEL_MAX_FILENAME);
+    strncpy((char *)dst, entry->filename, CAMPAIGN_LEVEL_MAX_FILENAME - 1);
+    dst[CAMPAIGN_LEVEL_MAX_FILENAME] = entry->stars;
+    memcpy(dst + CAMPAIGN_LEVEL_MAX_FILENAME + 1, &entry->score, sizeof(int32_t));
+
+}
+
+static void decode_record(const uint8_t *src, CampaignProgressEntry *entry) {
+
+    memset(entry, 0, sizeof(*entry));
+    memcpy(entry->filename, src, CAMPAIGN_LEVEL_MAX_FILENAME);
+    entry->filename[CAMPAIGN_LEVEL_MAX_FILENAME - 1] = '\0';
+    entry->stars = src[CAMPAIGN_LEVEL_MAX_FILENAME];
+    memcpy(&entry->score, src + CAMPAIGN_LEVEL_MAX_FILENAME + 1, sizeof(int32_t));
+    if (entry->stars > CAMPAIGN_PROGRESS_MAX_STARS)
+        entry->stars = CAMPAIGN_PROGRESS_MAX_STARS;
+
+}
+
+// Whole save in the snapshot layout; caller frees
+static uint8_t *encode_snapshot(const CampaignProgress *progress, size_t *size) {
+
+    *size = PROGRESS_HEADER_SIZE + (size_t)progress->count * PROGRESS_RECORD_SIZE;
+    uint8_t *buf = (uint8_t *)malloc(*size);
+    if (!buf)
+        return NULL;
     uint16_t version = PROGRESS_VERSION;
     uint16_t reserved = 0;
-    uint32_t count = 0;
-    fwrite(magic, sizeof(char), 4, f);
-    fwrite(&version, sizeof(version), 1, f);
-    fwrite(&reserved, sizeof(reserved), 1, f);
-    fwrite(&count, sizeof(count), 1, f);
-    fclose(f);
-    return 0;
+    uint32_t count = (uint32_t)progress->count;
+    memcpy(buf, PROGRESS_MAGIC, 4);
+    memcpy(buf + 4, &version, sizeof(version));
+    memcpy(buf + 6, &reserved, sizeof(reserved));
+    memcpy(buf + 8, &count, sizeof(count));
+    for (int i = 0; i < progress->count; ++i)
+        encode_record(buf + PROGRESS_HEADER_SIZE + (size_t)i * PROGRESS_RECORD_SIZE, &progress->entries[i]);
+    return buf;
 
 }
 
-int campaign_progress_load(CampaignProgress *progress, const char *path) {
+static void journal_path(const char *path, char *out, size_t out_size) {
 
-    if (!progress)
-        return -1;
+    snprintf(out, out_size, "%s.log", path);
 
-    campaign_progress_free(progress);
+}
 
-    const char *resolved = path ? path : campaign_progress_default_path();
-    FILE *f = fopen(resolved, "rb");
-    if (!f) {
-        if (errno == ENOENT) {
-            write_empty_save(resolved);
-            return 0;
+// Applies one loaded record with the same keep-the-best rule as updates
+static void apply_record(CampaignProgress *progress, const CampaignProgressEntry *rec) {
+
+    if (campaign_progress_update(progress, rec->filename, rec->stars, rec->score) < 0)
+        LOG_WARN("campaign_progress", "Dropped progress for '%s'", rec->filename);
 
 }
-        return -1;
-    }
 
-    char magic[4];
-    if (fread(magic, sizeof(char), 4, f) != 4 || memcmp(magic, PROGRESS_MAGIC, 4) != 0) {
-        fclose(f);
-        return -1;
-    }
+static int load_snapshot(CampaignProgress *progress, const FsMapping *m) {
 
+    const uint8_t *data = (const uint8_t *)m->data;
+    if (m->size < PROGRESS_HEADER_SIZE || memcmp(data, PROGRESS_MAGIC, 4) != 0)
+        return -1;
     uint16_t version = 0;
-    uint16_t reserved = 0;
     uint32_t count = 0;
-    if (fread(&version, sizeof(version), 1, f) != 1) {
-        fclose(f);
+    memcpy(&version, data + 4, sizeof(version));
+    memcpy(&count, data + 8, sizeof(count));
+    if (version != PROGRESS_VERSION || count > PROGRESS_MAX_ENTRIES)
         return -1;
-    }
-    if (fread(&reserved, sizeof(reserved), 1, f) != 1) {
-        fclose(f);
-        return -1;
-    }
-    if (fread(&count, sizeof(count), 1, f) != 1) {
-        fclose(f);
+    if (m->size < PROGRESS_HEADER_SIZE + (size_t)count * PROGRESS_RECORD_SIZE)
         return -1;
+    for (uint32_t i = 0; i < count; ++i) {
+        CampaignProgressEntry rec;
+        decode_record(data + PROGRESS_HEADER_SIZE + (size_t)i * PROGRESS_RECORD_SIZE, &rec);
+        apply_record(progress, &rec);
     }
+    return 0;
 
-    if (version != PROGRESS_VERSION || count > PROGRESS_MAX_ENTRIES) {
+}
 
-        fclose(f);
-        return -1;
+// Returns the number of records applied; *torn is set when the tail was unusable
+static int replay_journal(CampaignProgress *progress, const char *path, bool *torn) {
 
+    char log_path[300];
+    journal_path(path, log_path, sizeof(log_path));
+    FsMapping m;
+    if (!fs_map_file(log_path, &m))
+        return 0;
+    const uint8_t *data = (const uint8_t *)m.data;
+    int applied = 0;
+    for (size_t off = 0; off + PROGRESS_JOURNAL_RECORD_SIZE <= m.size; off += PROGRESS_JOURNAL_RECORD_SIZE) {
+        uint32_t crc;
+        memcpy(&crc, data + off + PROGRESS_RECORD_SIZE, sizeof(crc));
+        if (vfs_crc32(0, data + off, PROGRESS_RECORD_SIZE) != crc) {
+            LOG_WARN("campaign_progress", "Journal damaged after %d records, ignoring the rest", applied);
+            break;
+        }
+        CampaignProgressEntry rec;
+        decode_record(data + off, &rec);
+        apply_record(progress, &rec);
+        applied++;
     }
+    *torn = (size_t)applied * PROGRESS_JOURNAL_RECORD_SIZE != m.size;
+    fs_unmap_file(&m);
+    return applied;
 
-    for (uint32_t i = 0; i < count; ++i) {
+}
 
-        char name[CAMPAIGN_LEVEL_MAX_FILENAME] = {0
+int campaign_progress_load(CampaignProgress *progress, const char *path) {
 
-    };
-        uint8_t stars = 0;
-        int32_t score = 0;
-        if (fread(name, sizeof(char), CAMPAIGN_LEVEL_MAX_FILENAME, f) != CAMPAIGN_LEVEL_MAX_FILENAME) {
-            campaign_progress_free(progress);
-            fclose(f);
-            return -1;
-        }
-        if (fread(&stars, sizeof(uint8_t), 1, f) != 1) {
-            campaign_progress_free(progress);
-            fclose(f);
-            return -1;
-        }
-        if (fread(&score, sizeof(int32_t), 1, f) != 1) {
-            campaign_progress_free(progress);
-            fclose(f);
-            return -1;
-        }
-        if (stars > CAMPAIGN_PROGRESS_MAX_STARS)
-            stars = CAMPAIGN_PROGRESS_MAX_STARS;
-        if (ensure_entry_capacity(progress, progress->count + 1) != 0) {
+    if (!progress)
+        return -1;
+
+    campaign_progress_free(progress);
+
+    const char *resolved = path ? path : campaign_progress_default_path();
+    bool torn = false;
+    FsMapping m;
+    bool have_snapshot = fs_map_file(resolved, &m);
+    if (!have_snapshot) {
+        /* A crash between replacing and renaming leaves the finished temp file */
+        char tmp[300];
+        snprintf(tmp, sizeof(tmp), "%s.tmp", resolved);
+        have_snapshot = fs_map_file(tmp, &m);
+        if (have_snapshot)
+            LOG_WARN("campaign_progress", "Recovering progress from %s", tmp);
+    }
+    if (!have_snapshot) {
+        size_t size = 0;
+        uint8_t *empty = encode_snapshot(progress, &size);
+        if (empty)
+            fs_write_file_atomic(resolved, NULL, 0, empty, size);
+        free(empty);
+    }
+    if (have_snapshot) {
+        int rc = load_snapshot(progress, &m);
+        fs_unmap_file(&m);
+        if (rc != 0) {
+            LOG_ERROR("campaign_progress", "Save file %s is damaged", resolved);
             campaign_progress_free(progress);
-            fclose(f);
             return -1;
         }
-        CampaignProgressEntry *entry = &progress->entries[progress->count++];
-        memcpy(entry->filename, name, CAMPAIGN_LEVEL_MAX_FILENAME);
-        entry->filename[CAMPAIGN_LEVEL_MAX_FILENAME - 1] = '\0';
-        entry->stars = stars;
-        entry->score = score;
     }
-    fclose(f);
+
+    progress->journal_records = replay_journal(progress, resolved, &torn);
+    for (int i = 0; i < progress->count; ++i)
+        progress->entries[i].unsaved = false;
     progress->dirty = false;
+    LOG_INFO("campaign_progress", "Loaded %d levels (%d journal updates)", progress->count, progress->journal_records);
+    if (torn) {
+        /* Appending after a torn record would hide the new ones; rewrite the snapshot instead */
+        progress->journal_records = PROGRESS_COMPACT_RECORDS;
+        progress->dirty = true;
+    }
     return 0;
 }
 
+static void writer_write(const char *path, const uint8_t *snapshot, size_t snapshot_size, const uint8_t *journal, size_t journal_size) {
+
+    char log_path[300];
+    journal_path(path, log_path, sizeof(log_path));
+    if (snapshot) {
+        if (!fs_write_file_atomic(path, NULL, 0, snapshot, snapshot_size)) {
+            LOG_ERROR("campaign_progress", "Failed to write %s", path);
+            return;
+        }
+        /* Everything journaled so far is in the snapshot now */
+        remove(log_path);
+        return;
+    }
+    if (!journal_size)
+        return;
+    if (fs_ensure_parent_dirs(log_path) != 0)
+        return;
+    FILE *f = fopen(log_path, "ab");
+    if (!f) {
+        LOG_ERROR("campaign_progress", "Failed to open %s", log_path);
+        return;
+    }
+    bool ok = fwrite(journal, 1, journal_size, f) == journal_size;
+    if (fclose(f) != 0 || !ok)
+        LOG_ERROR("campaign_progress", "Failed to append to %s", log_path);
+
+}
+
+static int writer_thread(void *data) {
+
+    (void)data;
+    SDL_LockMutex(g_writer.lock);
+    for (;;) {
+        while (!g_writer.quit && !g_writer.snapshot && !g_writer.journal_size)
+            SDL_CondWait(g_writer.wake, g_writer.lock);
+        if (!g_writer.snapshot && !g_writer.journal_size)
+            break; // quit with nothing left to write
+        char path[sizeof(g_writer.path)];
+        memcpy(path, g_writer.path, sizeof(path));
+        uint8_t *snapshot = g_writer.snapshot;
+        size_t snapshot_size = g_writer.snapshot_size;
+        uint8_t *journal = g_writer.journal;
+        size_t journal_size = g_writer.journal_size;
+        g_writer.snapshot = NULL;
+        g_writer.snapshot_size = 0;
+        g_writer.journal = NULL;
+        g_writer.journal_size = 0;
+        g_writer.journal_cap = 0;
+        g_writer.busy = true;
+        SDL_UnlockMutex(g_writer.lock);
+
+        writer_write(path, snapshot, snapshot_size, journal, journal_size);
+        free(snapshot);
+        free(journal);
+
+        SDL_LockMutex(g_writer.lock);
+        g_writer.busy = false;
+        SDL_CondBroadcast(g_writer.idle);
+    }
+    SDL_UnlockMutex(g_writer.lock);
+    return 0;
+
+}
+
+static bool writer_start(void) {
+
+    if (g_writer.thread)
+        return true;
+    g_writer.lock = SDL_CreateMutex();
+    g_writer.wake = SDL_CreateCond();
+    g_writer.idle = SDL_CreateCond();
+    g_writer.quit = false;
+    if (g_writer.lock && g_writer.wake && g_writer.idle)
+        g_writer.thread = SDL_CreateThread(writer_thread, "progress_writer", NULL);
+    if (!g_writer.thread) {
+        LOG_WARN("campaign_progress", "No writer thread, saving synchronously");
+        if (g_writer.idle) SDL_DestroyCond(g_writer.idle);
+        if (g_writer.wake) SDL_DestroyCond(g_writer.wake);
+        if (g_writer.lock) SDL_DestroyMutex(g_writer.lock);
+        g_writer.idle = g_writer.wake = NULL;
+        g_writer.lock = NULL;
+        return false;
+    }
+    return true;
+
+}
+
+static void writer_stop(void) {
+
+    if (!g_writer.thread)
+        return;
+    SDL_LockMutex(g_writer.lock);
+    g_writer.quit = true;
+    SDL_CondSignal(g_writer.wake);
+    SDL_UnlockMutex(g_writer.lock);
+    SDL_WaitThread(g_writer.thread, NULL);
+    SDL_DestroyCond(g_writer.idle);
+    SDL_DestroyCond(g_writer.wake);
+    SDL_DestroyMutex(g_writer.lock);
+    memset(&g_writer, 0, sizeof(g_writer));
+
+}
+
+void campaign_progress_flush(void) {
+
+    if (!g_writer.thread)
+        return;
+    SDL_LockMutex(g_writer.lock);
+    while (g_writer.busy || g_writer.snapshot || g_writer.journal_size)
+        SDL_CondWait(g_writer.idle, g_writer.lock);
+    SDL_UnlockMutex(g_writer.lock);
+
+}
+
 int campaign_progress_save(CampaignProgress *progress, const char *path) {
 
     if (!progress)
@@ -220,60 +404,101 @@ int campaign_progress_save(CampaignProgress *progress, const char *path) {
 
     const char *resolved = path ? path : campaign_progress_default_path();
 
-    FILE *f = fopen(resolved, "wb");
-    if (!f)
-        return -1;
+    int changed = 0;
+    for (int i = 0; i < progress->count; ++i)
+        changed += progress->entries[i].unsaved ? 1 : 0;
+    if (!changed && !progress->dirty)
+        return 0;
 
-    const char magic[4] = PROGRESS_MAGIC;
-    uint16_t version = PROGRESS_VERSION;
-    uint16_t reserved = 0;
-    uint32_t count = (uint32_t)progress->count;
+    /* Compact once the journal is long enough; otherwise append the changes */
+    bool compact = progress->journal_records + changed >= PROGRESS_COMPACT_RECORDS;
+    uint8_t *snapshot = NULL;
+    size_t snapshot_size = 0;
+    uint8_t *journal = NULL;
+    size_t journal_size = 0;
+    if (compact) {
+        snapshot = encode_snapshot(progress, &snapshot_size);
+        if (!snapshot)
+            return -1;
+    } else {
+        journal_size = (size_t)changed * PROGRESS_JOURNAL_RECORD_SIZE;
+        journal = (uint8_t *)malloc(journal_size ? journal_size : 1);
+        if (!journal)
+            return -1;
+        uint8_t *dst = journal;
+        for (int i = 0; i < progress->count; ++i) {
+            if (!progress->entries[i].unsaved)
+                continue;
+            encode_record(dst, &progress->entries[i]);
+            uint32_t crc = vfs_crc32(0, dst, PROGRESS_RECORD_SIZE);
+            memcpy(dst + PROGRESS_RECORD_SIZE, &crc, sizeof(crc));
+            dst += PROGRESS_JOURNAL_RECORD_SIZE;
+        }
+    }
+    for (int i = 0; i < progress->count; ++i)
+        progress->entries[i].unsaved = false;
+    progress->journal_records = compact ? 0 : progress->journal_records + changed;
+    progress->dirty = false;
 
-    fwrite(magic, sizeof(char), 4, f);
-    fwrite(&version, sizeof(version), 1, f);
-    fwrite(&reserved, sizeof(reserved), 1, f);
-    fwrite(&count, sizeof(count), 1, f);
-
-    for (int i = 0; i < progress->count; ++i) {
-        const CampaignProgressEntry *entry = &progress->entries[i];
-        char namebuf[CAMPAIGN_LEVEL_MAX_FILENAME] = {0
-
-};
-        strncpy(namebuf, entry->filename, CAMPAIGN_LEVEL_MAX_FILENAME - 1);
-        uint8_t stars = entry->stars;
-        int32_t score = entry->score;
-        fwrite(namebuf, sizeof(char), CAMPAIGN_LEVEL_MAX_FILENAME, f);
-        fwrite(&stars, sizeof(uint8_t), 1, f);
-        fwrite(&score, sizeof(int32_t), 1, f);
+    if (!writer_start()) {
+        writer_write(resolved, snapshot, snapshot_size, journal, journal_size);
+        free(snapshot);
+        free(journal);
+        return 0;
     }
 
-    fclose(f);
-    progress->dirty = false;
+    SDL_LockMutex(g_writer.lock);
+    if (strcmp(g_writer.path, resolved) != 0 && (g_writer.snapshot || g_writer.journal_size)) {
+        /* Different file: let the queued writes for the old one land first */
+        SDL_UnlockMutex(g_writer.lock);
+        campaign_progress_flush();
+        SDL_LockMutex(g_writer.lock);
+    }
+    snprintf(g_writer.path, sizeof(g_writer.path), "%s", resolved);
+    if (snapshot) {
+        /* The snapshot already contains anything still queued for the journal */
+        free(g_writer.snapshot);
+        free(g_writer.journal);
+        g_writer.snapshot = snapshot;
+        g_writer.snapshot_size = snapshot_size;
+        g_writer.journal = NULL;
+        g_writer.journal_size = 0;
+        g_writer.journal_cap = 0;
+    } else if (journal_size) {
+        if (g_writer.journal_size + journal_size > g_writer.journal_cap) {
+            size_t cap = (g_writer.journal_size + journal_size) * 2;
+            uint8_t *grown = (uint8_t *)realloc(g_writer.journal, cap);
+            if (!grown) {
+                SDL_UnlockMutex(g_writer.lock);
+                free(journal);
+                return -1;
+            }
+            g_writer.journal = grown;
+            g_writer.journal_cap = cap;
+        }
+        memcpy(g_writer.journal + g_writer.journal_size, journal, journal_size);
+        g_writer.journal_size += journal_size;
+    }
+    SDL_CondSignal(g_writer.wake);
+    SDL_UnlockMutex(g_writer.lock);
+    free(journal);
     return 0;
 }
 
 static CampaignProgressEntry *campaign_progress_find_mut(CampaignProgress *progress, const char *filename) {
 
-    if (!progress || !filename)
+    if (!progress || !filename || progress->slot_count == 0)
         return NULL;
-    for (int i = 0; i < progress->count; ++i) {
-        if (strncmp(progress->entries[i].filename, filename, CAMPAIGN_LEVEL_MAX_FILENAME) == 0)
-            return &progress->entries[i];
-
-}
-    return NULL;
+    int slot = progress->slots[progress_slot(progress, filename)];
+    return slot >= 0 ? &progress->entries[slot] : NULL;
 }
 
 const CampaignProgressEntry *campaign_progress_find(const CampaignProgress *progress, const char *filename) {
 
-    if (!progress || !filename)
+    if (!progress || !filename || progress->slot_count == 0)
         return NULL;
-    for (int i = 0; i < progress->count; ++i) {
-        if (strncmp(progress->entries[i].filename, filename, CAMPAIGN_LEVEL_MAX_FILENAME) == 0)
-            return &progress->entries[i];
-
-}
-    return NULL;
+    int slot = progress->slots[progress_slot(progress, filename)];
+    return slot >= 0 ? &progress->entries[slot] : NULL;
 }
 
 int campaign_progress_update(CampaignProgress *progress, const char *filename, uint8_t stars, int32_t score) {
@@ -287,13 +512,20 @@ int campaign_progress_update(CampaignProgress *progress, const char *filename, u
     if (!entry) {
         if (stars == 0)
             return 0;
+        if (progress->count >= PROGRESS_MAX_ENTRIES)
+            return -1;
         if (ensure_entry_capacity(progress, progress->count + 1) != 0)
             return -1;
         entry = &progress->entries[progress->count++];
         memset(entry, 0, sizeof(*entry));
         strncpy(entry->filename, filename, CAMPAIGN_LEVEL_MAX_FILENAME - 1);
+        if (progress_index_add(progress, progress->count - 1) != 0) {
+            progress->count--;
+            return -1;
+        }
         entry->stars = stars;
         entry->score = score;
+        entry->unsaved = true;
         progress->dirty = true;
         return 1;
 
@@ -308,6 +540,7 @@ int campaign_progress_update(CampaignProgress *progress, const char *filename, u
 
     entry->stars = stars;
     entry->score = score;
+    entry->unsaved = true;
     progress->dirty = true;
     return 1;
 }
@@ -333,12 +566,17 @@ CampaignProgress *campaign_progress_data(void) {
 
 void campaign_progress_shutdown(void) {
 
-    if (!g_progress_loaded)
-        return;
-    if (g_progress.dirty)
-        campaign_progress_save(&g_progress, NULL);
-    campaign_progress_free(&g_progress);
-    g_progress_loaded = false;
+    if (g_progress_loaded) {
+        /* Fold the journal into a fresh snapshot on the way out */
+        if (g_progress.dirty || g_progress.journal_records > 0) {
+            g_progress.journal_records = PROGRESS_COMPACT_RECORDS;
+            g_progress.dirty = true;
+            campaign_progress_save(&g_progress, NULL);
+        }
+        campaign_progress_free(&g_progress);
+        g_progress_loaded = false;
+    }
+    writer_stop();
 
 }
 
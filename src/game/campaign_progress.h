@@ -16,6 +16,7 @@ typedef struct CampaignProgressEntry {
     char filename[CAMPAIGN_LEVEL_MAX_FILENAME];
     uint8_t stars;
     int32_t score;
+    bool unsaved; // changed since the last campaign_progress_save
 } CampaignProgressEntry;
 
 // Container storing all progress entries; zero-initialize before use.
@@ -24,13 +25,28 @@ typedef struct CampaignProgress {
     int count;
     int capacity;
     bool dirty;
+    int *slots;          // hash index into entries (-1 = empty); slot_count is a power of two
+    int slot_count;
+    int journal_records; // updates in the journal since the last snapshot
 } CampaignProgress;
 
 // Returns default save path for current platform.
 const char *campaign_progress_default_path(void);
 
+// Saves are a snapshot at 'path' plus an append-only journal "<path>.log".
+// Loading reads the snapshot and replays the journal over it; torn journal
+// records (crash mid-write) fail their checksum and are ignored.
 int campaign_progress_load(CampaignProgress *progress, const char *path);
+
+// Queues the entries changed since the last save and returns without
+// touching the disk. A background writer appends them to the journal; after
+// PROGRESS_COMPACT_RECORDS updates it instead rewrites the snapshot through a
+// temporary file and rename, then drops the journal.
 int campaign_progress_save(CampaignProgress *progress, const char *path);
+
+// Blocks until everything queued by campaign_progress_save is on disk.
+void campaign_progress_flush(void);
+
 void campaign_progress_free(CampaignProgress *progress);
 
 const CampaignProgressEntry *campaign_progress_find(const CampaignProgress *progress, const char *filename);
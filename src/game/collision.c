@@ -3,11 +3,15 @@
 #include "player.h"
 #include "enemy.h"
 #include "planet.h"
+#include "planet_field.h"
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "projectile_system.h"
 #include "projectile.h"
 #include "../services/renderer.h"
 
+// Gefundener Treffer/Kontakt, in Dispatch-Reihenfolge (a vor b)
 typedef struct Pair {
     Entity *a;
     Entity *b;
@@ -58,32 +62,62 @@ static int collision_should_test(Entity *a, Entity *b) {
     return 1;
 }
 
-// Holt alle relevanten Entities aus der World (Player, Enemies, Planets,
-// aktive Projektile) in ein flaches Array.
-static void collect_entities(struct World *w, Entity **out, int *count, int max) {
-    *count = 0;
+// Holt alle relevanten Entities aus der World in die (wachsende) Scratch-Liste
+// der World, sortiert nach Art: Player, Enemies, Planets, aktive Projektile.
+// Planets optional, wenn sie separat über den Broadphase-Index des
+// PlanetField getestet werden. enemies_end / first_projectile markieren die
+// Grenzen der Gruppen.
+typedef struct EntityList {
+    Entity **items;
+    int count;
+    int enemies_end;
+    int first_projectile;
+} EntityList;
+
+static bool collect_entities(struct World *w, EntityList *out, int include_planets) {
+    memset(out, 0, sizeof(*out));
     if (!w)
-        return;
-    if (w->player && *count < max)
-        out[(*count)++] = (Entity *)w->player;
-    for (int i = 0; i < w->enemy_count && *count < max; i++) {
+        return false;
+    ProjectileSystem *ps = &w->projsys;
+    int need = 1 + w->enemy_count + (include_planets ? w->planet_count : 0);
+    for (int s = 0; s < ps->shooter_count; ++s)
+        need += ps->shooters[s].head;
+    if (need > w->collision_capacity) {
+        int cap = w->collision_capacity > 0 ? w->collision_capacity : 256;
+        while (cap < need)
+            cap *= 2;
+        Entity **arr = realloc(w->collision_list, sizeof(*arr) * (size_t)cap);
+        if (!arr)
+            return false;
+        w->collision_list = arr;
+        w->collision_capacity = cap;
+    }
+    Entity **list = w->collision_list;
+    int count = 0;
+    if (w->player)
+        list[count++] = (Entity *)w->player;
+    for (int i = 0; i < w->enemy_count; i++) {
         if (w->enemies[i])
-            out[(*count)++] = (Entity *)w->enemies[i];
+            list[count++] = (Entity *)w->enemies[i];
     }
-    for (int i = 0; i < w->planet_count && *count < max; i++) {
+    out->enemies_end = count;
+    for (int i = 0; include_planets && i < w->planet_count; i++) {
         if (w->planets[i])
-            out[(*count)++] = (Entity *)w->planets[i];
+            list[count++] = (Entity *)w->planets[i];
     }
+    out->first_projectile = count;
     // projectiles
-    ProjectileSystem *ps = &w->projsys;
-    for (int s = 0; s < ps->shooter_count && *count < max; ++s) {
+    for (int s = 0; s < ps->shooter_count; ++s) {
         ShooterPool *pool = &ps->shooters[s];
-        for (int i = 0; i < pool->head && *count < max; i++) {
+        for (int i = 0; i < pool->head; i++) {
             Projectile *pr = pool->items[i];
             if (pr && pr->active)
-                out[(*count)++] = (Entity *)pr;
+                list[count++] = (Entity *)pr;
         }
     }
+    out->items = list;
+    out->count = count;
+    return true;
 }
 
 // Schneller Bounding-Circle Broadphase Test (nur Radius / Distanz)
@@ -234,6 +268,18 @@ static int circle_circle(Entity *a, Entity *b) {
     float dist = dist2 > 0.f ? sqrtf(dist2) : 0.f;
     return 1; // overlap detected; we don't need direction for simple resolve now
 }
+// Narrowphase je nach Collider-Form (Polygon/Kreis)
+static int collision_narrowphase(Entity *a, Entity *b) {
+    unsigned int sfA = a->collider.shape;
+    unsigned int sfB = b->collider.shape;
+    if ((sfA & COLLIDER_SHAPE_POLY) && (sfB & COLLIDER_SHAPE_POLY))
+        return sat_poly_poly(a->collider.poly_world, a->collider.poly_count, b->collider.poly_world, b->collider.poly_count);
+    if (sfA & COLLIDER_SHAPE_POLY)
+        return sat_circle_poly(b, a); // b is circle
+    if (sfB & COLLIDER_SHAPE_POLY)
+        return sat_circle_poly(a, b); // a is circle
+    return circle_circle(a, b);
+}
 static void apply_separation(Entity *e, Vec2 n, float amount) {
     e->pos.x += n.x * amount;
     e->pos.y += n.y * amount;
@@ -264,15 +310,54 @@ static void dispatch_pair(Entity *a, Entity *b) {
         b->vt->on_collide(b, a);
 }
 
+// Hängt ein Paar an den Event-Puffer der World an. Die Erkennung selbst hat
+// damit keine Seiteneffekte; ausgelöst wird erst in collision_resolve.
+static void collision_record(struct World *w, Entity *a, Entity *b) {
+    if (w->collision_pair_count >= w->collision_pair_capacity) {
+        int cap = w->collision_pair_capacity > 0 ? w->collision_pair_capacity * 2 : 64;
+        Pair *arr = realloc(w->collision_pairs, sizeof(*arr) * (size_t)cap);
+        if (!arr) {
+            dispatch_pair(a, b); // kein Speicher: sofort auslösen wie früher
+            return;
+        }
+        w->collision_pairs = arr;
+        w->collision_pair_capacity = cap;
+    }
+    w->collision_pairs[w->collision_pair_count++] = (Pair){a, b};
+}
+
+// Zweite Phase: erst alle Projektil-Treffer (Schaden, Score, Deaktivierung,
+// Effekte), dann die Kontakte. Innerhalb einer Gruppe gilt die Reihenfolge
+// der Erkennung, dispatch_pair überspringt bereits verbrauchte Projektile -
+// ein Projektil trifft also weiterhin nur das erste gültige Ziel.
+static void collision_resolve(struct World *w) {
+    Pair *pairs = w->collision_pairs;
+    int n = w->collision_pair_count;
+    for (int i = 0; i < n; i++) {
+        if ((pairs[i].a->type == ENT_PROJECTILE) ^ (pairs[i].b->type == ENT_PROJECTILE))
+            dispatch_pair(pairs[i].a, pairs[i].b);
+    }
+    for (int i = 0; i < n; i++) {
+        if (pairs[i].a->type != ENT_PROJECTILE && pairs[i].b->type != ENT_PROJECTILE)
+            dispatch_pair(pairs[i].a, pairs[i].b);
+    }
+    w->collision_pair_count = 0;
+}
+
 // Haupt-Einstieg: Führt vollständigen Kollisions-Durchlauf aus.
 // dt derzeit ungenutzt (Reserviert für zukünftige CCD / zeitabhängige Filter).
 void collision_run(struct World *w, float dt) {
     (void)dt;
     if (!w)
         return; // dt kept for future (CCD etc.)
-    Entity *list[256];
-    int count = 0;
-    collect_entities(w, list, &count, 256);
+    // Planeten sind statisch: mit PlanetField-Broadphase nur die Planeten
+    // in den Zellen um jede Entity testen statt alle Paare
+    int planets_indexed = w->field.cell_start != NULL;
+    EntityList el;
+    if (!collect_entities(w, &el, !planets_indexed))
+        return;
+    Entity **list = el.items;
+    int count = el.count;
     for (int i = 0; i < count; i++) {
         Entity *e = list[i];
         if (e->collider.radius <= 0.f) {
@@ -284,8 +369,18 @@ void collision_run(struct World *w, float dt) {
         if (e->collider.poly_world_dirty)
             collider_prepare(e);
     }
-    for (int i = 0; i < count; i++) {
-        for (int j = i + 1; j < count; j++) {
+    // Paare Enemy/Enemy, Planet/Planet und Projektil/Projektil lösen nichts aus
+    // (kein on_collide bzw. Platzhalter): dank der Sortierung überspringt die
+    // innere Schleife diese Gruppen, Projektile werden nur noch als zweiter
+    // Partner besucht. Das hält den Durchlauf bei vielen Enemies linear in
+    // Enemies x Projektile statt quadratisch in allen Entities.
+    for (int i = 0; i < el.first_projectile; i++) {
+        int j0 = i + 1;
+        if (list[i]->type == ENT_ENEMY && j0 < el.enemies_end)
+            j0 = el.enemies_end;
+        else if (list[i]->type == ENT_PLANET)
+            j0 = el.first_projectile;
+        for (int j = j0; j < count; j++) {
             Entity *a = list[i];
             Entity *b = list[j];
             if (!collision_should_test(a, b))
@@ -293,26 +388,35 @@ void collision_run(struct World *w, float dt) {
             // Schneller Circle Broadphase
             if (!broadphase_circle(a, b))
                 continue; // no possible collision
-            int collided = 0;
-            unsigned int sfA = a->collider.shape;
-            unsigned int sfB = b->collider.shape;
-            if ((sfA & COLLIDER_SHAPE_POLY) && (sfB & COLLIDER_SHAPE_POLY)) {
-                collided = sat_poly_poly(a->collider.poly_world, a->collider.poly_count, b->collider.poly_world, b->collider.poly_count);
-            }
-            else if ((sfA & COLLIDER_SHAPE_POLY) && !(sfB & COLLIDER_SHAPE_POLY)) {
-                collided = sat_circle_poly(b, a); // b is circle
-            }
-            else if ((sfB & COLLIDER_SHAPE_POLY) && !(sfA & COLLIDER_SHAPE_POLY)) {
-                collided = sat_circle_poly(a, b); // a is circle
-            }
-            else {
-                collided = circle_circle(a, b);
-            }
-            if (!collided)
+            if (!collision_narrowphase(a, b))
                 continue;
-            dispatch_pair(a, b);
+            collision_record(w, a, b);
+        }
+    }
+    uint16_t near_planets[64];
+    for (int i = 0; planets_indexed && i < count; i++) {
+        Entity *e = list[i];
+        int n = planet_field_query(&w->field, e->pos.x, e->pos.y, e->collider.radius, near_planets, 64);
+        int all = n < 0; // no index or overflow: every planet
+        int total = all ? w->planet_count : n;
+        for (int k = 0; k < total; k++) {
+            int idx = all ? k : near_planets[k];
+            if (idx >= w->planet_count || !w->planets[idx])
+                continue;
+            Entity *pl = (Entity *)w->planets[idx];
+            if (!collision_should_test(pl, e) || !broadphase_circle(pl, e))
+                continue;
+            if (!collision_narrowphase(pl, e))
+                continue;
+            // gleiche Reihenfolge wie im Paar-Durchlauf (Planeten vor Projektilen gesammelt)
+            if (e->type == ENT_PROJECTILE) {
+                collision_record(w, pl, e);
+                break; // ein Planet verbraucht das Projektil immer
+            }
+            collision_record(w, e, pl);
         }
     }
+    collision_resolve(w);
 }
 
 #ifdef DEBUG_COLLISION
@@ -320,19 +424,22 @@ void collision_run(struct World *w, float dt) {
 // Zeigt: Bounding-Circle (cyan) + Polygon-Umriss (rot) + Mittelpunkt (magenta)
 void collision_debug_draw(struct World *w, struct Renderer *r) {
     if (!w || !r) return;
-    Entity *list[256]; int count = 0; collect_entities(w, list, &count, 256);
-    SDL_SetRenderDrawBlendMode(r->sdl, SDL_BLENDMODE_BLEND);
+    EntityList el;
+    if (!collect_entities(w, &el, 1)) return;
+    Entity **list = el.items; int count = el.count;
+    SDL_BlendMode prev_blend = renderer_set_blend_mode(r, SDL_BLENDMODE_BLEND);
+    RenderLayer prev_layer = renderer_set_layer(r, RENDER_LAYER_HUD);
     for (int i = 0; i < count; ++i) {
         Entity *e = list[i];
         float rC = e->collider.radius;
         if (rC > 1.f) {
-            SDL_SetRenderDrawColor(r->sdl, 0, 200, 255, 180);
+            SDL_Color circle_col = {0, 200, 255, 180};
             Vec2 prev = {e->pos.x + rC, e->pos.y};
             const int SEG = 32;
             for (int s = 1; s <= SEG; ++s) {
                 float ang = (float)s / SEG * 6.28318530718f;
                 Vec2 cur = {e->pos.x + cosf(ang) * rC, e->pos.y + sinf(ang) * rC};
-                SDL_RenderDrawLineF(r->sdl, prev.x, prev.y, cur.x, cur.y);
+                renderer_draw_line(r, prev.x, prev.y, cur.x, cur.y, circle_col);
                 prev = cur;
             }
         }
@@ -340,17 +447,19 @@ void collision_debug_draw(struct World *w, struct Renderer *r) {
         EntityCollider *c = &e->collider;
         if ((c->shape & COLLIDER_SHAPE_POLY) && c->poly_count > 1) {
             if (c->poly_world_dirty) collider_prepare(e);
-            SDL_SetRenderDrawColor(r->sdl, 255, 40, 40, 220);
+            SDL_Color poly_col = {255, 40, 40, 220};
             for (int p = 0; p < c->poly_count; ++p) {
                 int q = (p + 1) % c->poly_count;
                 Vec2 a = c->poly_world[p];
                 Vec2 b = c->poly_world[q];
-                SDL_RenderDrawLineF(r->sdl, a.x, a.y, b.x, b.y);
+                renderer_draw_line(r, a.x, a.y, b.x, b.y, poly_col);
             }
-            SDL_SetRenderDrawColor(r->sdl, 255, 0, 255, 220);
-            SDL_RenderDrawLineF(r->sdl, e->pos.x - 2, e->pos.y, e->pos.x + 2, e->pos.y);
-            SDL_RenderDrawLineF(r->sdl, e->pos.x, e->pos.y - 2, e->pos.x, e->pos.y + 2);
+            SDL_Color center_col = {255, 0, 255, 220};
+            renderer_draw_line(r, e->pos.x - 2, e->pos.y, e->pos.x + 2, e->pos.y, center_col);
+            renderer_draw_line(r, e->pos.x, e->pos.y - 2, e->pos.x, e->pos.y + 2, center_col);
         }
     }
+    renderer_set_layer(r, prev_layer);
+    renderer_set_blend_mode(r, prev_blend);
 }
 #endif
@@ -6,7 +6,8 @@
 struct World; // forward
 struct Renderer; // forward
 
-// Run collision detection & dispatch (no global resolution).
+// Run collision detection, then dispatch the recorded hits and contacts
+// (detection itself only appends to the world's pair buffer).
 void collision_run(struct World *w, float dt);
 
 // Debug Drawing (compile-time only):
@@ -0,0 +1,169 @@
+#include "effects.h"
+#include <math.h>
+#include <string.h>
+#include "../services/explosion_gen.h"
+#include "../services/quality.h"
+
+#define EFFECT_BLAST_FPS 25.f     /* explosion animation speed (0.04 s per frame) */
+#define EFFECT_DEBRIS_DRAG 0.08f  /* fraction of debris velocity left after one second */
+
+/* Debris uses the projectile disc closest to each explosion's colour:
+ * orange, blue, green, red -> yellow, blue, green, red */
+static const uint8_t DEBRIS_VARIANT[EXPLOSION_GEN_TYPES] = {3, 2, 1, 0};
+
+void effects_init(EffectPool *fx, TextureManager *tm, u32 seed) {
+    if (!fx)
+        return;
+    fx->count = 0;
+    fx->dropped = 0;
+    fx->texman = tm;
+    fx->sprites = tm ? texman_sprites(tm) : NULL;
+    rng_seed(&fx->rng, seed ^ 0x9E3779B9u);
+}
+
+static int effects_type(int type) {
+    return type < 0 ? 0 : type % EXPLOSION_GEN_TYPES;
+}
+
+static int effects_alloc(EffectPool *fx) {
+    if (fx->count >= MAX_EFFECTS) {
+        fx->dropped++;
+        return -1;
+    }
+    return fx->count++;
+}
+
+static void effects_emit_blast(EffectPool *fx, int type, float x, float y, float scale) {
+    const QualityTier *q = quality_current();
+    int frames = texman_explosion_frames(fx->texman);
+    if (frames <= 0)
+        return;
+    int i = effects_alloc(fx);
+    if (i < 0)
+        return;
+    fx->x[i] = x;
+    fx->y[i] = y;
+    fx->vx[i] = 0.f;
+    fx->vy[i] = 0.f;
+    fx->age[i] = 0.f;
+    /* Lower tiers skip animation frames, which also ends the blast sooner */
+    float fps = EFFECT_BLAST_FPS * (float)q->effect_frame_step;
+    fx->life[i] = (float)frames / fps;
+    fx->size[i] = EXPLOSION_GEN_TILE * scale * q->effect_scale;
+    fx->shrink[i] = 0.f;
+    fx->frame_rate[i] = fps;
+    fx->sprite[i] = (uint16_t)(SPR_EXPLOSION_FIRST + type * EXPLOSION_GEN_FRAMES);
+    fx->frames[i] = (uint8_t)frames;
+}
+
+static void effects_emit_debris(EffectPool *fx, int type, float x, float y, int count, float speed_min, float speed_max,
+                                float size, float life) {
+    uint16_t sprite = (uint16_t)(SPR_PROJECTILE_FIRST + DEBRIS_VARIANT[type]);
+    count = (int)((float)count * quality_current()->effect_density + 0.5f);
+    for (int n = 0; n < count; n++) {
+        int i = effects_alloc(fx);
+        if (i < 0)
+            return;
+        float angle = rng_rangef(&fx->rng, 0.f, 6.2831853f);
+        float speed = rng_rangef(&fx->rng, speed_min, speed_max);
+        float s = size * rng_rangef(&fx->rng, 0.6f, 1.f);
+        float l = life * rng_rangef(&fx->rng, 0.7f, 1.f);
+        fx->x[i] = x;
+        fx->y[i] = y;
+        fx->vx[i] = cosf(angle) * speed;
+        fx->vy[i] = sinf(angle) * speed;
+        fx->age[i] = 0.f;
+        fx->life[i] = l;
+        fx->size[i] = s;
+        fx->shrink[i] = s / l;
+        fx->frame_rate[i] = 0.f;
+        fx->sprite[i] = sprite;
+        fx->frames[i] = 1;
+    }
+}
+
+void effects_emit_impact(EffectPool *fx, int type, float x, float y) {
+    if (!fx)
+        return;
+    type = effects_type(type);
+    effects_emit_blast(fx, type, x, y, 0.5f);
+    effects_emit_debris(fx, type, x, y, 4, 60.f, 140.f, 4.f, 0.35f);
+}
+
+void effects_emit_kill(EffectPool *fx, int type, float x, float y, float scale) {
+    if (!fx)
+        return;
+    type = effects_type(type);
+    effects_emit_blast(fx, type, x, y, scale);
+    effects_emit_debris(fx, type, x, y, 10, 40.f, 180.f * scale, 6.f, 0.8f);
+}
+
+void effects_emit_planet_hit(EffectPool *fx, int type, float x, float y) {
+    if (!fx)
+        return;
+    type = effects_type(type);
+    effects_emit_blast(fx, type, x, y, 0.5f);
+    effects_emit_debris(fx, type, x, y, 3, 20.f, 70.f, 3.f, 0.5f);
+}
+
+/* Overwrite slot dst with slot src */
+static void effects_move(EffectPool *fx, int src, int dst) {
+    fx->x[dst] = fx->x[src];
+    fx->y[dst] = fx->y[src];
+    fx->vx[dst] = fx->vx[src];
+    fx->vy[dst] = fx->vy[src];
+    fx->age[dst] = fx->age[src];
+    fx->life[dst] = fx->life[src];
+    fx->size[dst] = fx->size[src];
+    fx->shrink[dst] = fx->shrink[src];
+    fx->frame_rate[dst] = fx->frame_rate[src];
+    fx->sprite[dst] = fx->sprite[src];
+    fx->frames[dst] = fx->frames[src];
+}
+
+void effects_update(EffectPool *fx, float dt) {
+    if (!fx || fx->count == 0)
+        return;
+    int n = fx->count;
+    float drag = powf(EFFECT_DEBRIS_DRAG, dt);
+    /* Branch-free passes over contiguous arrays */
+    for (int i = 0; i < n; i++)
+        fx->age[i] += dt;
+    for (int i = 0; i < n; i++) {
+        fx->x[i] += fx->vx[i] * dt;
+        fx->y[i] += fx->vy[i] * dt;
+    }
+    for (int i = 0; i < n; i++) {
+        fx->vx[i] *= drag;
+        fx->vy[i] *= drag;
+    }
+    for (int i = 0; i < n; i++)
+        fx->size[i] -= fx->shrink[i] * dt;
+    /* Swap-remove finished particles; draw order among effects doesn't matter */
+    for (int i = 0; i < n;) {
+        if (fx->age[i] < fx->life[i] && fx->size[i] > 0.f) {
+            i++;
+            continue;
+        }
+        n--;
+        if (i != n)
+            effects_move(fx, n, i);
+    }
+    fx->count = n;
+}
+
+void effects_render(const EffectPool *fx, Renderer *r) {
+    if (!fx || !fx->sprites)
+        return;
+    for (int i = 0; i < fx->count; i++) {
+        int frame = (int)(fx->age[i] * fx->frame_rate[i]);
+        if (frame >= fx->frames[i])
+            frame = fx->frames[i] - 1;
+        const Sprite *sp = &fx->sprites[fx->sprite[i] + frame];
+        if (!sp->tex)
+            continue;
+        float s = fx->size[i];
+        SDL_FRect dst = {fx->x[i] - s * 0.5f, fx->y[i] - s * 0.5f, s, s};
+        renderer_draw_texture(r, sp->tex, &sp->src, &dst, 0.f);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <stdint.h>
+#include "../core/types.h"
+#include "../core/rand.h"
+#include "../services/texture_manager.h"
+#include "../services/renderer.h"
+
+/**
+ * @brief Fixed-capacity effect particles (explosion animations and debris).
+ *
+ * Stored as parallel arrays so the per-tick update is a handful of straight
+ * loops the compiler can vectorize. Dead particles are swap-removed, nothing
+ * is allocated after init. Every particle draws an atlas sprite, so a full
+ * pool lands in the render queue as one merged draw per atlas page.
+ */
+typedef struct EffectPool {
+    int count;
+    float x[MAX_EFFECTS], y[MAX_EFFECTS];
+    float vx[MAX_EFFECTS], vy[MAX_EFFECTS];
+    float age[MAX_EFFECTS], life[MAX_EFFECTS];
+    float size[MAX_EFFECTS];       // rendered edge length in pixels
+    float shrink[MAX_EFFECTS];     // size lost per second (debris), 0 for animations
+    float frame_rate[MAX_EFFECTS]; // animation frames per second, 0 = single sprite
+    uint16_t sprite[MAX_EFFECTS];  // first SpriteID of the animation
+    uint8_t frames[MAX_EFFECTS];   // animation length in sprites
+    TextureManager *texman;
+    const Sprite *sprites;         // texman sprite table, indexed by SpriteID
+    Rng rng;                       // debris spread; separate from the world RNG
+    int dropped;                   // particles refused because the pool was full
+} EffectPool;
+
+/**
+ * @brief Reset a pool
+ * @param fx Pool
+ * @param tm Texture manager providing the sprites
+ * @param seed Seed for debris spread
+ */
+void effects_init(EffectPool *fx, TextureManager *tm, u32 seed);
+
+/**
+ * @brief Projectile hitting a ship that survives: small blast plus sparks
+ * @param fx Pool
+ * @param type Explosion type (clamped)
+ * @param x Impact X
+ * @param y Impact Y
+ */
+void effects_emit_impact(EffectPool *fx, int type, float x, float y);
+
+/**
+ * @brief Destroyed ship: full-size blast plus a ring of debris
+ * @param fx Pool
+ * @param type Explosion type (clamped)
+ * @param x Center X
+ * @param y Center Y
+ * @param scale Blast size relative to one 64px explosion tile
+ */
+void effects_emit_kill(EffectPool *fx, int type, float x, float y, float scale);
+
+/**
+ * @brief Projectile hitting a planet: small blast plus a few dust specks
+ * @param fx Pool
+ * @param type Explosion type (clamped)
+ * @param x Impact X
+ * @param y Impact Y
+ */
+void effects_emit_planet_hit(EffectPool *fx, int type, float x, float y);
+
+/**
+ * @brief Advance all particles and drop finished ones
+ * @param fx Pool
+ * @param dt Time step in seconds
+ */
+void effects_update(EffectPool *fx, float dt);
+
+/**
+ * @brief Draw all particles (caller selects the layer)
+ * @param fx Pool
+ * @param r Renderer
+ */
+void effects_render(const EffectPool *fx, Renderer *r);
@@ -11,6 +11,8 @@
 #include "planet.h"
 #include "enemy_types.h"
 #include "entity_helpers.h"
+#include "trajectory.h"
+#include "../services/quality.h"
 
 #include "../core/types.h"
 
@@ -24,84 +26,15 @@
  * projectile hits a planet or leaves the allowed bounds.
  *
  * This helper is used by the enemy shot-search to evaluate candidate
- * trajectories.
+ * trajectories; the simulation itself is trajectory_min_dist(), shared with
+ * the offline level analyzer.
  */
 static float simulate_projectile_min_dist(struct World *w, Vec2 origin, Vec2 player_pos, float angle, float strength, float hit_radius) {
     if (!w)
         return 1e9f;
-    Vec2 pos = origin;
-    Vec2 vel = (Vec2){cosf(angle) * strength, sinf(angle) * strength
-};
-    float t = 0.f;
-    /* Work in squared distances to avoid sqrt inside the loop */
-    float min_dist2 = 1e30f;
-    float hit_r2 = hit_radius * hit_radius;
-
-    /* get OOB bounds from world */
-    float min_x, min_y, max_x, max_y;
-    world_get_proj_oob_bounds(w, &min_x, &min_y, &max_x, &max_y);
-
-    /* simulate with fixed timestep */
-    const float sim_dt = FIXED_DT;
-    const float sim_max_time = SIM_MAX_PROJECTILE_TIME;
-
-    while (t < sim_max_time) {
-
-        /* gravity from planets */
-        for (int i = 0; i < w->planet_count; ++i) {
-            struct Planet *pl = w->planets[i];
-            if (!pl)
-                continue;
-            float dx = pl->e.pos.x - pos.x;
-            float dy = pl->e.pos.y - pos.y;
-            float dist2 = dx * dx + dy * dy;
-            /* extremely close singularity guard */
-            if (dist2 < PROJ_EPSILON)
-                return 1e9f;
-
-            /* Hit planet: if projectile hits planet body, compute distance to player at this point
-             * and if that distance is smaller than current best, update and abort (projectile destroyed).
-             */
-            if (dist2 <= pl->radius_sq) {
-                float pdx = pos.x - player_pos.x;
-                float pdy = pos.y - player_pos.y;
-                float pd2 = pdx * pdx + pdy * pdy;
-                if (pd2 < min_dist2)
-                    min_dist2 = pd2;
-                /* projectile destroyed by planet; stop simulation */
-                return sqrtf(min_dist2);
-            }
-
-            /* apply gravity (inverse-square) */
-            float inv_dist = 1.0f / sqrtf(dist2);
-            float inv_dist2 = inv_dist * inv_dist;
-            float accel = (pl->mass * PROJ_GRAVITY_CONST) * inv_dist2;
-            vel.x += accel * dx * inv_dist * sim_dt;
-            vel.y += accel * dy * inv_dist * sim_dt;
-        }
-
-        /* integrate */
-        pos.x += vel.x * sim_dt;
-        pos.y += vel.y * sim_dt;
-
-        /* If the simulated projectile leaves the world bounds, disqualify (real projectiles are deactivated) */
-        if (pos.x < min_x || pos.x > max_x || pos.y < min_y || pos.y > max_y)
-            return 1e9f;
-
-        /* distance^2 to player */
-        float pdx = pos.x - player_pos.x;
-        float pdy = pos.y - player_pos.y;
-        float pd2 = pdx * pdx + pdy * pdy;
-
-        if (pd2 < min_dist2)
-            min_dist2 = pd2;
-
-        if (min_dist2 <= hit_r2)
-            return sqrtf(min_dist2);
-
-        t += sim_dt;
-    }
-    return sqrtf(min_dist2);
+    TrajectoryEnv env = {w->planets, w->planet_count, &w->field};
+    world_get_proj_oob_bounds(w, &env.min_x, &env.min_y, &env.max_x, &env.max_y);
+    return trajectory_min_dist(&env, origin, player_pos, angle, strength, hit_radius);
 }
 
 /**
@@ -116,20 +49,12 @@ static void enemy_render(Entity *e, struct Renderer *r) {
     Enemy *en = (Enemy *)e;
     if (!en->alive)
         return;
-    // Use sprite sheet index = enemy type
-    SDL_Rect src = {0, 0, 0, 0};
-    if (en->e.texture) {
-        Services *svc = services_get();
-        if (svc && svc->texman) {
-            src = texman_sheet_src(svc->texman, TEX_ENEMIES_SHEET, (int)en->type);
-        }
-    }
     float w = en->e.size.x;
     float h = en->e.size.y;
     SDL_FRect dst = {en->e.pos.x - w * 0.5f, en->e.pos.y - h * 0.5f, w, h};
     // Convert angle to degrees; align similar to player (assume artwork faces up) -> apply angle_offset´
     float angle_deg = (en->e.angle + en->e.angle_offset) * (180.f / M_PI);
-    renderer_draw_texture(r, en->e.texture, (src.w > 0 ? &src : NULL), &dst, angle_deg);
+    renderer_draw_texture(r, en->e.texture, (en->e.sprite ? &en->e.sprite->src : NULL), &dst, angle_deg);
 }
 /**
  * @brief Per-frame entity update wrapper.
@@ -216,35 +141,12 @@ static void enemy_on_hit(Entity *e, Entity *hitter) {
         if (pr)
             pr->active = false;
 
-        // Add Explosion
+        // Impact at the projectile while the enemy survives, kill effect at its center otherwise
         if (en->world) {
-            Services *svc = services_get();
-            if (svc && svc->texman) {
-                int types = texman_explosion_type_count(svc->texman);
-                if (types > 0) {
-                    int type = en->explosion_type;
-                    if (type < 0)
-                        type = 0;
-                    if (type >= types)
-                        type = type % types; /* clamp/modulo to available range */
-                    float x;
-                    float y;
-                    float scale;
-                    // Use projectile position on hit where player don't die
-                    if (en->alive) {
-                        x = hitter->pos.x;
-                        y = hitter->pos.y;
-                        scale = 0.5f;
-                    }
-                    // Use enemy position if killed
-                    else {
-                        x = en->e.pos.x;
-                        y = en->e.pos.y;
-                        scale = 0.8f;
-                    }
-                    world_add_explosion(en->world, type, x, y, scale);
-                }
-            }
+            if (en->alive)
+                effects_emit_impact(&en->world->effects, en->explosion_type, hitter->pos.x, hitter->pos.y);
+            else
+                effects_emit_kill(&en->world->effects, en->explosion_type, en->e.pos.x, en->e.pos.y, 0.8f);
         }
     }
 }
@@ -285,6 +187,13 @@ static SDL_Texture *enemy_base_texture(void) {
         return NULL;
     return texman_get(svc->texman, TEX_ENEMIES_SHEET);
 }
+/* Sprite index = enemy type */
+static const Sprite *enemy_base_sprite(int type) {
+    Services *svc = services_get();
+    if (!svc || !svc->texman)
+        return NULL;
+    return texman_sprite(svc->texman, SPR_ENEMY_FIRST + type);
+}
 
 /**
  * @brief Progressive shot-search worker.
@@ -296,6 +205,9 @@ static SDL_Texture *enemy_base_texture(void) {
 static void enemy_update_shot_search(Enemy *en, World *w) {
     if (!en || !w || !w->player || !en->weapon)
         return;
+    // not this enemy's turn of the per-tick search budget (crowded levels)
+    if (!w->ai_search_turn)
+        return;
     // If cache invalid or player/enemy moved, reset progressive search
     Vec2 player_pos = w->player->e.pos;
     Vec2 origin = en->e.pos;
@@ -321,6 +233,9 @@ static void enemy_update_shot_search(Enemy *en, World *w) {
 
     // progressive sampling: few iterations per call
     int to_run = en->shot.search_per_frame;
+    int budget = quality_current()->ai_samples;
+    if (to_run > budget)
+        to_run = budget;
     int n = en->shot.search_grid_n > 1 ? en->shot.search_grid_n : 3;
     int cells = n * n;
     while (to_run-- > 0 && en->shot.search_done < en->shot.search_total && en->shot.best_dist > ENEMY_SHOT_HIT_RADIUS) {
@@ -459,6 +374,7 @@ Enemy *enemy_create(World *world, EnemyType type, float x, float y, int shooter_
     e->e.size.x = 32;
     e->e.size.y = 32; // default tile size; can tweak per type later
     e->e.texture = enemy_base_texture();
+    e->e.sprite = enemy_base_sprite((int)type);
     e->e.angle_offset = (M_PI * 0.5f);
     e->e.is_dynamic = true;
     e->e.collider.radius = sqrtf(e->e.size.x * e->e.size.x + e->e.size.y * e->e.size.y) * 0.5f + 1;
@@ -86,6 +86,7 @@ typedef struct Enemy {
     int16_t health;
     struct Weapon *weapon;
     struct World *world;
+    uint32_t handle; // EnemyHandle assigned by world_spawn_enemy
     /* Energy/economy for AI shooting */
     uint16_t   energy_max;
     float      energy; // current energy pool
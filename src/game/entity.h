@@ -51,6 +51,7 @@ struct Entity {
     float angle_offset; // render-only orientation adjustment (radians)
     bool active;
     SDL_Texture *texture;
+    const struct Sprite *sprite; // atlas sprite inside texture, resolved at spawn; NULL draws the whole texture
     EntityCollider collider; // embedded collider
     bool is_dynamic;         // participates in positional resolution if true
 };
@@ -78,13 +78,13 @@ Hud *hud_create(struct Services *svc, Player *player) {
         if (svc && svc->texman) {
             SDL_Texture *sheet = texman_get(svc->texman, TEX_ICONS_SHEET);
             if (sheet) {
-                SDL_Rect icon0 = texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 0);   // speed icon index 2 per user request
-                SDL_Rect icon1 = texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 1);   // cooldown icon
-                SDL_Rect icon_hp = texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 2); // health icon index 3
-                SDL_Rect icon_points = texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 4);
-                SDL_Rect icon_time = texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 5);     // time (idx6 user-facing)
-                SDL_Rect icon_kills = texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 6);    // kills (idx7 user-facing)
-                SDL_Rect icon_infinite = texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 7); // infinite (idx8 user-facing)
+                SDL_Rect icon0 = texman_sprite(svc->texman, SPR_ICON_FIRST)->src;   // speed icon index 2 per user request
+                SDL_Rect icon1 = texman_sprite(svc->texman, SPR_ICON_FIRST + 1)->src;   // cooldown icon
+                SDL_Rect icon_hp = texman_sprite(svc->texman, SPR_ICON_FIRST + 2)->src; // health icon index 3
+                SDL_Rect icon_points = texman_sprite(svc->texman, SPR_ICON_FIRST + 4)->src;
+                SDL_Rect icon_time = texman_sprite(svc->texman, SPR_ICON_FIRST + 5)->src;     // time (idx6 user-facing)
+                SDL_Rect icon_kills = texman_sprite(svc->texman, SPR_ICON_FIRST + 6)->src;    // kills (idx7 user-facing)
+                SDL_Rect icon_infinite = texman_sprite(svc->texman, SPR_ICON_FIRST + 7)->src; // infinite (idx8 user-facing)
                 if (h->shot_speed_bar_index >= 0)
                     hud_bar_set_icon(h, h->shot_speed_bar_index, sheet, icon0);
                 if (h->weapon_cd_bar_index >= 0)
@@ -165,10 +165,8 @@ void hud_render(Hud *h, struct Renderer *r) {
         float hgt = HUD_BG_HEIGHT;
         if (hgt > dh) hgt = dh; // clamp
         SDL_FRect bg = { 0.f, dh - hgt, dw, hgt};
-        SDL_SetRenderDrawColor(r->sdl, 8, 8, 16, HUD_BG_ALPHA);
-        SDL_RenderFillRectF(r->sdl, &bg);
-        SDL_SetRenderDrawColor(r->sdl, 40, 40, 60, HUD_BG_BORDER_ALPHA);
-        SDL_RenderDrawRectF(r->sdl, &bg);
+        renderer_draw_filled_rect(r, bg, (SDL_Color){8, 8, 16, HUD_BG_ALPHA});
+        renderer_draw_rect_outline(r, bg, (SDL_Color){40, 40, 60, HUD_BG_BORDER_ALPHA}, 1);
     }
     // Draw bars & stats after background
     for (int i = 0; i < h->bar_count; i++) hud_render_bar(h, &h->bars[i], r);
@@ -266,8 +264,7 @@ static void hud_render_bar(Hud *h, HudBar *b, struct Renderer *r) {
     }
     SDL_FRect base = b->rect; // absolute coordinates
     // background
-    SDL_SetRenderDrawColor(r->sdl, b->bg_color.r, b->bg_color.g, b->bg_color.b, b->bg_color.a);
-    SDL_RenderFillRectF(r->sdl, &base);
+    renderer_draw_filled_rect(r, base, b->bg_color);
     float v = b->value_fn(h->world, b->user_data);
     if (v < 0.f)
         v = 0.f;
@@ -280,11 +277,9 @@ static void hud_render_bar(Hud *h, HudBar *b, struct Renderer *r) {
     if (is_energy_bar && v < 0.2f) {
         fill_color = (SDL_Color){210, 140, 40, b->fill_color.a};
     }
-    SDL_SetRenderDrawColor(r->sdl, fill_color.r, fill_color.g, fill_color.b, fill_color.a);
-    SDL_RenderFillRectF(r->sdl, &fill);
+    renderer_draw_filled_rect(r, fill, fill_color);
 
-    SDL_SetRenderDrawColor(r->sdl, 0, 0, 0, 200);
-    SDL_RenderDrawRectF(r->sdl, &base);
+    renderer_draw_rect_outline(r, base, (SDL_Color){0, 0, 0, 200}, 1);
 }
 
 static void hud_render_stat(Hud *h, HudStat *s, struct Renderer *r) {
@@ -330,9 +325,9 @@ static void hud_stat_update_time(HudStat *stat, struct World *w, void *user) {
         stat->text[0] = '\0';
         if (w->svc && w->svc->texman && stat->icon_tex) {
             // main icon stays time (sheet index 5), extra icon is infinity (index 7)
-            stat->icon_src = texman_sheet_src(w->svc->texman, TEX_ICONS_SHEET, 5);
+            stat->icon_src = texman_sprite(w->svc->texman, SPR_ICON_FIRST + 5)->src;
             stat->extra_icon_tex = stat->icon_tex;
-            stat->extra_icon_src = texman_sheet_src(w->svc->texman, TEX_ICONS_SHEET, 7);
+            stat->extra_icon_src = texman_sprite(w->svc->texman, SPR_ICON_FIRST + 7)->src;
             stat->has_extra_icon = true;
         }
     }
@@ -341,7 +336,7 @@ static void hud_stat_update_time(HudStat *stat, struct World *w, void *user) {
         stat->has_extra_icon = false;
         stat->extra_icon_tex = NULL;
         if (w->svc && w->svc->texman && stat->icon_tex)
-            stat->icon_src = texman_sheet_src(w->svc->texman, TEX_ICONS_SHEET, 5);
+            stat->icon_src = texman_sprite(w->svc->texman, SPR_ICON_FIRST + 5)->src;
         float remaining = w->time_limit - w->time;
         if (remaining < 0.f)
             remaining = 0.f;
@@ -0,0 +1,364 @@
+#include "level_analyzer.h"
+#include <SDL2/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "enemy_types.h"
+#include "level_loader.h"
+#include "level_thumbs.h"
+#include "planet.h"
+#include "planet_field.h"
+#include "trajectory.h"
+#include "weapon.h"
+#include "../core/fs.h"
+#include "../core/log.h"
+#include "../core/types.h"
+
+#define ANALYZER_COLS (DISPLAY_W / LEVEL_ANALYZER_CELL)
+#define ANALYZER_ROWS (DISPLAY_H / LEVEL_ANALYZER_CELL)
+#define ANALYZER_CELLS (ANALYZER_COLS * ANALYZER_ROWS)
+#define ANALYZER_WORDS (LEVEL_ANALYZER_ANGLES / 64)
+#define ANALYZER_OOB_MARGIN 0.2f /* World default proj_oob_margin_factor */
+#define ANALYZER_HEATMAP_SCALE 4
+/* first window of enemy_update_shot_search(): direct angle +-0.6 rad, mid speed +-50% */
+#define ANALYZER_SEARCH_ANGLE 0.6f
+#define ANALYZER_SEARCH_STRENGTH 0.5f
+
+typedef struct AnalyzerJob {
+    const TrajectoryEnv *env;
+    const LevelEnemy *enemies;
+    int enemy_count;
+    float min_speed, max_speed;
+    uint64_t *hits;    /* [enemy][strength][position][angle word], one bit per angle */
+    SDL_atomic_t next; /* next (enemy, strength) task */
+} AnalyzerJob;
+
+static uint64_t *analyzer_rows(const AnalyzerJob *job, int enemy, int s) {
+    return job->hits + ((size_t)enemy * LEVEL_ANALYZER_STRENGTHS + s) * ANALYZER_CELLS * ANALYZER_WORDS;
+}
+
+static float analyzer_strength(const AnalyzerJob *job, int s) {
+    return job->min_speed + (job->max_speed - job->min_speed) * (float)s / (float)(LEVEL_ANALYZER_STRENGTHS - 1);
+}
+
+static bool analyzer_bit(const uint64_t *rows, int cell, int a) {
+    return (rows[(size_t)cell * ANALYZER_WORDS + a / 64] >> (a & 63)) & 1u;
+}
+
+/* Mark every candidate position within hit range of a point */
+static void analyzer_mark(uint64_t *rows, float x, float y, int a) {
+    const float r = ENEMY_SHOT_HIT_RADIUS;
+    const float cell = (float)LEVEL_ANALYZER_CELL;
+    int c0 = (int)ceilf((x - r) / cell - 0.5f), c1 = (int)floorf((x + r) / cell - 0.5f);
+    int r0 = (int)ceilf((y - r) / cell - 0.5f), r1 = (int)floorf((y + r) / cell - 0.5f);
+    if (c0 < 0) c0 = 0;
+    if (r0 < 0) r0 = 0;
+    if (c1 >= ANALYZER_COLS) c1 = ANALYZER_COLS - 1;
+    if (r1 >= ANALYZER_ROWS) r1 = ANALYZER_ROWS - 1;
+    for (int row = r0; row <= r1; ++row) {
+        float dy = ((float)row + 0.5f) * cell - y;
+        for (int col = c0; col <= c1; ++col) {
+            float dx = ((float)col + 0.5f) * cell - x;
+            if (dx * dx + dy * dy <= r * r)
+                rows[(size_t)(row * ANALYZER_COLS + col) * ANALYZER_WORDS + a / 64] |= (uint64_t)1 << (a & 63);
+        }
+    }
+}
+
+/* One task is one enemy at one launch speed, swept over every angle */
+static int analyzer_worker(void *data) {
+    AnalyzerJob *job = (AnalyzerJob *)data;
+    int tasks = job->enemy_count * LEVEL_ANALYZER_STRENGTHS;
+    for (;;) {
+        int task = SDL_AtomicAdd(&job->next, 1);
+        if (task >= tasks)
+            break;
+        int e = task / LEVEL_ANALYZER_STRENGTHS;
+        int s = task % LEVEL_ANALYZER_STRENGTHS;
+        Vec2 origin = {job->enemies[e].pos_x, job->enemies[e].pos_y};
+        float strength = analyzer_strength(job, s);
+        uint64_t *rows = analyzer_rows(job, e, s);
+        for (int a = 0; a < LEVEL_ANALYZER_ANGLES; ++a) {
+            float angle = (float)a * (2.f * (float)M_PI / (float)LEVEL_ANALYZER_ANGLES);
+            Vec2 pos = origin;
+            Vec2 vel = {cosf(angle) * strength, sinf(angle) * strength};
+            for (float t = 0.f; t < SIM_MAX_PROJECTILE_TIME; t += FIXED_DT) {
+                TrajectoryState state = trajectory_step(job->env, &pos, &vel, FIXED_DT);
+                if (state == TRAJECTORY_LOST)
+                    break;
+                analyzer_mark(rows, pos.x, pos.y, a);
+                if (state == TRAJECTORY_HIT_PLANET)
+                    break;
+            }
+        }
+    }
+    return 0;
+}
+
+static void analyzer_run(AnalyzerJob *job, int threads) {
+    if (threads <= 0)
+        threads = SDL_GetCPUCount();
+    if (threads < 1)
+        threads = 1;
+    if (threads > LEVEL_ANALYZER_MAX_THREADS)
+        threads = LEVEL_ANALYZER_MAX_THREADS;
+    SDL_AtomicSet(&job->next, 0);
+    SDL_Thread *workers[LEVEL_ANALYZER_MAX_THREADS] = {0};
+    /* The calling thread works too; tasks of a failed thread start are picked up by the others */
+    for (int i = 1; i < threads; i++)
+        workers[i] = SDL_CreateThread(analyzer_worker, "level_analyzer", job);
+    analyzer_worker(job);
+    for (int i = 1; i < threads; i++)
+        if (workers[i])
+            SDL_WaitThread(workers[i], NULL);
+}
+
+/* Chance that enemy_try_shoot() still hits when aiming along sample (a, s):
+ * half the shots jitter the angle by up to ja, the other half the speed by up to js */
+static float analyzer_hit_chance(const AnalyzerJob *job, int e, int cell, int a, int s, int wa, float js) {
+    const uint64_t *rows = analyzer_rows(job, e, s);
+    int angle_hits = 0;
+    for (int k = -wa; k <= wa; ++k)
+        angle_hits += analyzer_bit(rows, cell, (a + k + LEVEL_ANALYZER_ANGLES) % LEVEL_ANALYZER_ANGLES);
+    float strength = analyzer_strength(job, s);
+    float lo = strength * (1.f - js), hi = strength * (1.f + js);
+    int speed_hits = 0, speed_samples = 0;
+    for (int j = 0; j < LEVEL_ANALYZER_STRENGTHS; ++j) {
+        float v = analyzer_strength(job, j);
+        if (j != s && (v < lo || v > hi))
+            continue;
+        speed_samples++;
+        speed_hits += analyzer_bit(analyzer_rows(job, e, j), cell, a);
+    }
+    return 0.5f * ((float)angle_hits / (float)(2 * wa + 1) + (float)speed_hits / (float)speed_samples);
+}
+
+/* Mean hit chance over the hitting aims the enemy shot search can find from its
+ * first window around the direct angle (0 = none). *any is set if any shot of
+ * the sweep hits the position. */
+static float analyzer_aim_chance(const AnalyzerJob *job, int e, int cell, int wa, float js, bool *any) {
+    float cx = ((float)(cell % ANALYZER_COLS) + 0.5f) * LEVEL_ANALYZER_CELL;
+    float cy = ((float)(cell / ANALYZER_COLS) + 0.5f) * LEVEL_ANALYZER_CELL;
+    float direct = atan2f(cy - job->enemies[e].pos_y, cx - job->enemies[e].pos_x);
+    float mid = (job->min_speed + job->max_speed) * 0.5f;
+    float sum = 0.f;
+    int aims = 0;
+    *any = false;
+    for (int s = 0; s < LEVEL_ANALYZER_STRENGTHS; ++s) {
+        const uint64_t *row = analyzer_rows(job, e, s) + (size_t)cell * ANALYZER_WORDS;
+        bool searched = fabsf(analyzer_strength(job, s) - mid) <= mid * ANALYZER_SEARCH_STRENGTH;
+        for (int w = 0; w < ANALYZER_WORDS; ++w) {
+            for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                *any = true;
+                int a = w * 64 + __builtin_ctzll(bits);
+                float angle = (float)a * (2.f * (float)M_PI / (float)LEVEL_ANALYZER_ANGLES);
+                if (!searched || fabsf(atan2f(sinf(angle - direct), cosf(angle - direct))) > ANALYZER_SEARCH_ANGLE)
+                    continue;
+                sum += analyzer_hit_chance(job, e, cell, a, s, wa, js);
+                aims++;
+            }
+        }
+    }
+    return aims ? sum / (float)aims : 0.f;
+}
+
+static int analyzer_cmp_float(const void *a, const void *b) {
+    float fa = *(const float *)a, fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static float analyzer_median(float *values, int n) {
+    if (n <= 0)
+        return 0.f;
+    qsort(values, (size_t)n, sizeof(float), analyzer_cmp_float);
+    return n % 2 ? values[n / 2] : 0.5f * (values[n / 2 - 1] + values[n / 2]);
+}
+
+/* Level preview with every reachable position tinted yellow (many shots) to red (one shot) */
+static bool analyzer_write_heatmap(const char *path, const GameLevel *lvl, const float *best, const bool *open) {
+    const int w = LEVEL_THUMB_W * ANALYZER_HEATMAP_SCALE, h = LEVEL_THUMB_H * ANALYZER_HEATMAP_SCALE;
+    uint32_t *thumb = malloc((size_t)LEVEL_THUMB_W * LEVEL_THUMB_H * sizeof(uint32_t));
+    uint32_t *pixels = malloc((size_t)w * h * sizeof(uint32_t));
+    if (!thumb || !pixels) {
+        free(thumb);
+        free(pixels);
+        return false;
+    }
+    level_thumbs_draw(lvl, thumb);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            uint32_t d = thumb[(size_t)(y / ANALYZER_HEATMAP_SCALE) * LEVEL_THUMB_W + x / ANALYZER_HEATMAP_SCALE];
+            int cell_x = x * DISPLAY_W / (w * LEVEL_ANALYZER_CELL);
+            int cell_y = y * DISPLAY_H / (h * LEVEL_ANALYZER_CELL);
+            if (cell_x < ANALYZER_COLS && cell_y < ANALYZER_ROWS) {
+                int cell = cell_y * ANALYZER_COLS + cell_x;
+                float p = best[cell];
+                if (open[cell] && p > 0.f) {
+                    uint32_t tint = 0xFF000000u | 0xFF0000u | (uint32_t)(224.f * (1.f - p)) << 8 | 0x20u;
+                    uint32_t alpha = (uint32_t)(256.f * (0.35f + 0.4f * p));
+                    uint32_t rb = ((((tint & 0xFF00FFu) * alpha) + ((d & 0xFF00FFu) * (256u - alpha))) >> 8) & 0xFF00FFu;
+                    uint32_t g = ((((tint & 0x00FF00u) * alpha) + ((d & 0x00FF00u) * (256u - alpha))) >> 8) & 0x00FF00u;
+                    d = 0xFF000000u | rb | g;
+                }
+            }
+            pixels[(size_t)y * w + x] = d;
+        }
+    }
+    bool ok = false;
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormatFrom(pixels, w, h, 32, w * (int)sizeof(uint32_t), SDL_PIXELFORMAT_ARGB8888);
+    if (surface) {
+        ok = SDL_SaveBMP(surface, path) == 0;
+        SDL_FreeSurface(surface);
+    }
+    free(thumb);
+    free(pixels);
+    return ok;
+}
+
+/* Per enemy and overall numbers into <out_dir>/<base>.txt; fills best[] with the best hit chance per position */
+static bool analyzer_report(const char *path, const char *filename, const GameLevel *lvl, const AnalyzerJob *job,
+                            const bool *open, float *best, float *shots, LevelAnalysis *out) {
+    FILE *report = fopen(path, "w");
+    if (!report)
+        return false;
+    int enemy_count = job->enemy_count;
+    bool hit_any[ANALYZER_CELLS] = {0};
+    fprintf(report, "Level %s: %d enemies, %d planets\n", filename, enemy_count, job->env->planet_count);
+    fprintf(report, "Sweep: %d angles x %d speeds (%.0f-%.0f px/s) per enemy, %d player positions %d px apart\n\n",
+            LEVEL_ANALYZER_ANGLES, LEVEL_ANALYZER_STRENGTHS, job->min_speed, job->max_speed, ANALYZER_CELLS,
+            LEVEL_ANALYZER_CELL);
+    fprintf(report, "  id  type  diff  spawn       reach    found  shots/hit\n");
+    for (int e = 0; e < enemy_count; ++e) {
+        const LevelEnemy *le = &lvl->enemies[e];
+        const EnemyDef *def = le->type < ENEMY_TYPE_COUNT ? &ENEMY_DEFS[le->type] : NULL;
+        float scale = 1.f - (float)le->difficulty / 255.f;
+        float ja = def ? def->base_jitter_angle * scale : 0.f;
+        float js = def ? def->base_jitter_strength * scale : 0.f;
+        int wa = (int)(ja / (2.f * (float)M_PI / (float)LEVEL_ANALYZER_ANGLES));
+        int reachable = 0, found = 0;
+        for (int cell = 0; cell < ANALYZER_CELLS; ++cell) {
+            if (!open[cell])
+                continue;
+            bool any;
+            float p = analyzer_aim_chance(job, e, cell, wa, js, &any);
+            reachable += any;
+            if (le->difficulty > 0)
+                hit_any[cell] = hit_any[cell] || any;
+            if (p > 0.f)
+                shots[found++] = 1.f / p;
+            /* difficulty 0 never fires (enemy_ai_update) */
+            if (le->difficulty > 0 && p > best[cell])
+                best[cell] = p;
+        }
+        float open_count = out->open_positions ? (float)out->open_positions : 1.f;
+        fprintf(report, "%4u  %4u  %4u  %-9s  %5.1f%%  %5.1f%%  %9.2f%s\n", (unsigned)le->id, (unsigned)le->type,
+                (unsigned)le->difficulty, le->spawn_kind == 1 ? "on_death" : "on_start", 100.f * (float)reachable / open_count,
+                100.f * (float)found / open_count, analyzer_median(shots, found), le->difficulty == 0 ? "  (never fires)" : "");
+    }
+    int reachable = 0, found = 0;
+    for (int cell = 0; cell < ANALYZER_CELLS; ++cell) {
+        if (!open[cell])
+            continue;
+        reachable += hit_any[cell];
+        if (best[cell] > 0.f)
+            shots[found++] = 1.f / best[cell];
+    }
+    out->reachable_positions = reachable;
+    out->found_positions = found;
+    out->median_shots = analyzer_median(shots, found);
+    float open_count = out->open_positions ? (float)out->open_positions : 1.f;
+    fprintf(report, "\nOpen positions: %d, reachable %.1f%%, found %.1f%%, median shots per hit %.2f (best enemy per position)\n",
+            out->open_positions, 100.f * (float)reachable / open_count, 100.f * (float)found / open_count, out->median_shots);
+    fprintf(report, "reach: some shot of the sweep hits; found: a shot the enemy aim search tries hits\n");
+    return fclose(report) == 0;
+}
+
+bool level_analyze(const char *filename, const char *out_dir, int threads, LevelAnalysis *out) {
+    if (!filename || !out_dir || !out)
+        return false;
+    memset(out, 0, sizeof(*out));
+    Uint64 t0 = SDL_GetPerformanceCounter();
+
+    GameLevel lvl;
+    char err[128] = {0};
+    if (level_load(filename, &lvl, err, sizeof(err)) != 0) {
+        LOG_ERROR("analyzer", "%s: %s", filename, err);
+        return false;
+    }
+    int planet_count = (int)lvl.planets_count;
+    int enemy_count = (int)lvl.enemies_count;
+    Planet **planets = calloc(planet_count ? planet_count : 1, sizeof(Planet *));
+    uint64_t *hits = calloc((size_t)(enemy_count ? enemy_count : 1) * LEVEL_ANALYZER_STRENGTHS * ANALYZER_CELLS * ANALYZER_WORDS,
+                            sizeof(uint64_t));
+    float *best = calloc(ANALYZER_CELLS, sizeof(float));
+    float *shots = calloc(ANALYZER_CELLS, sizeof(float));
+    Weapon *weapon = weapon_create_default();
+    bool ok = planets && hits && best && shots && weapon;
+    for (int i = 0; ok && i < planet_count; ++i) {
+        const LevelPlanet *p = &lvl.planets[i];
+        planets[i] = planet_create(p->pos_x, p->pos_y, p->size, (float)M_PI * p->size * p->size, NULL, (SDL_Rect){0, 0, 0, 0});
+        ok = planets[i] != NULL;
+    }
+    if (!ok)
+        LOG_ERROR("analyzer", "%s: out of memory", filename);
+
+    PlanetField field = {0};
+    if (ok) {
+        /* same field the game builds for the level (baked when available) */
+        planet_field_build(&field, planets, planet_count, &lvl);
+        TrajectoryEnv env = {planets, planet_count, &field};
+        env.min_x = -ANALYZER_OOB_MARGIN * (float)DISPLAY_W;
+        env.min_y = -ANALYZER_OOB_MARGIN * (float)DISPLAY_H;
+        env.max_x = (float)DISPLAY_W * (1.f + ANALYZER_OOB_MARGIN);
+        env.max_y = (float)DISPLAY_H * (1.f + ANALYZER_OOB_MARGIN);
+        AnalyzerJob job = {&env, lvl.enemies, enemy_count, weapon->min_speed, weapon->max_speed, hits};
+        analyzer_run(&job, threads);
+
+        /* player positions: cell centers with room for the ship next to every planet */
+        bool open[ANALYZER_CELLS];
+        for (int cell = 0; cell < ANALYZER_CELLS; ++cell) {
+            float cx = ((float)(cell % ANALYZER_COLS) + 0.5f) * LEVEL_ANALYZER_CELL;
+            float cy = ((float)(cell / ANALYZER_COLS) + 0.5f) * LEVEL_ANALYZER_CELL;
+            open[cell] = true;
+            for (int i = 0; i < planet_count && open[cell]; ++i) {
+                float dx = planets[i]->e.pos.x - cx, dy = planets[i]->e.pos.y - cy;
+                float clear = planets[i]->radius + LEVEL_ANALYZER_CELL * 0.5f;
+                open[cell] = dx * dx + dy * dy > clear * clear;
+            }
+            out->open_positions += open[cell];
+        }
+        out->enemies = enemy_count;
+
+        char base[64];
+        snprintf(base, sizeof(base), "%s", filename);
+        char *dot = strrchr(base, '.');
+        if (dot && dot != base)
+            *dot = '\0';
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.txt", out_dir, base);
+        fs_ensure_parent_dirs(path);
+        if (!analyzer_report(path, filename, &lvl, &job, open, best, shots, out)) {
+            LOG_ERROR("analyzer", "Failed to write %s", path);
+            ok = false;
+        }
+        snprintf(path, sizeof(path), "%s/%s.bmp", out_dir, base);
+        if (ok && !analyzer_write_heatmap(path, &lvl, best, open)) {
+            LOG_ERROR("analyzer", "Failed to write %s", path);
+            ok = false;
+        }
+    }
+
+    out->ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    planet_field_free(&field);
+    for (int i = 0; planets && i < planet_count; ++i)
+        if (planets[i])
+            planet_destroy(planets[i]);
+    free(planets);
+    free(hits);
+    free(best);
+    free(shots);
+    weapon_destroy(weapon);
+    level_free(&lvl);
+    return ok;
+}
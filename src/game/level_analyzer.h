@@ -0,0 +1,48 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+/* Offline difficulty analysis of a campaign level (PC: --analyze-levels).
+ *
+ * Every enemy spawn point fires a dense sweep of shots (LEVEL_ANALYZER_ANGLES
+ * around the full circle times LEVEL_ANALYZER_STRENGTHS speeds across the
+ * enemy weapon range) through the same simulation the enemy shot search uses
+ * (trajectory.h). One trajectory serves every candidate player position: a
+ * position, LEVEL_ANALYZER_CELL px apart over the display, counts as hit by a
+ * shot when the shot passes within ENEMY_SHOT_HIT_RADIUS of it.
+ *
+ * "Reach" counts positions some shot of the sweep hits, "found" those hit by
+ * a shot inside the first window of the enemy shot search (direct angle
+ * +-0.6 rad, mid speed +-50%). "Shots per hit" models enemy_try_shoot(): the
+ * enemy aims with one of those hitting shots and then jitters either the angle
+ * or the speed by its type's jitter, scaled down by its difficulty byte; the
+ * figure is the expected number of shots, averaged over the hitting aims.
+ *
+ * The sweep runs on all cores; each level writes <out_dir>/<level>.bmp (the
+ * level preview with found positions tinted yellow to red as enemies need
+ * fewer shots) and <out_dir>/<level>.txt (per enemy numbers).
+ */
+
+#define LEVEL_ANALYZER_CELL 20
+#define LEVEL_ANALYZER_ANGLES 512 // multiple of 64
+#define LEVEL_ANALYZER_STRENGTHS 32
+#define LEVEL_ANALYZER_MAX_THREADS 16
+
+typedef struct LevelAnalysis {
+    int enemies;
+    int open_positions;      // candidate player positions clear of planets
+    int reachable_positions; // hit by at least one shot of the sweep
+    int found_positions;     // hit by a shot the enemy aim search tries
+    float median_shots;      // per found position, best enemy; median over positions
+    double ms;
+} LevelAnalysis;
+
+/**
+ * @brief Analyze one level and write its heatmap and report
+ * @param filename Level file name (resolved like level_load)
+ * @param out_dir Output directory (created if missing)
+ * @param threads Worker count, <= 0 for one per CPU
+ * @param out Summary
+ * @return true on success
+ */
+bool level_analyze(const char *filename, const char *out_dir, int threads, LevelAnalysis *out);
@@ -0,0 +1,94 @@
+#include "level_background.h"
+#include <stdlib.h>
+#include "planet.h"
+#include "../services/renderer.h"
+#include "../core/log.h"
+
+LevelBackground *level_background_create(int width, int height) {
+    LevelBackground *bg = calloc(1, sizeof(LevelBackground));
+    if (!bg) {
+        LOG_ERROR("level_bg", "Failed to allocate level background");
+        return NULL;
+    }
+    bg->width = width;
+    bg->height = height;
+    bg->dirty = true;
+    return bg;
+}
+
+void level_background_destroy(LevelBackground *bg) {
+    if (!bg)
+        return;
+    if (bg->target)
+        SDL_DestroyTexture(bg->target);
+    free(bg);
+}
+
+void level_background_invalidate(LevelBackground *bg) {
+    if (bg)
+        bg->dirty = true;
+}
+
+static void level_background_draw_layer(struct Renderer *r, SDL_Texture *nebula,
+                                        struct Planet *const *planets, int planet_count) {
+    renderer_draw_texture(r, nebula, NULL, NULL, 0);
+    for (int i = 0; i < planet_count; ++i) {
+        Planet *p = planets[i];
+        if (p && p->e.vt && p->e.vt->render)
+            p->e.vt->render((Entity *)p, r);
+    }
+}
+
+static bool level_background_bake(LevelBackground *bg, struct Renderer *r, SDL_Texture *nebula,
+                                  struct Planet *const *planets, int planet_count) {
+    if (!bg->target) {
+        bg->target = SDL_CreateTexture(r->sdl, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, bg->width, bg->height);
+        if (!bg->target) {
+            LOG_WARN("level_bg", "Render target unavailable, drawing background per frame: %s", SDL_GetError());
+            bg->unsupported = true;
+            return false;
+        }
+        /* Layer is fully opaque: copying it without blending saves fill-rate */
+        SDL_SetTextureBlendMode(bg->target, SDL_BLENDMODE_NONE);
+    }
+
+    /* Draw straight into the target, bypassing the frame's render queue */
+    bool was_deferred = renderer_set_deferred(r, false);
+    SDL_Texture *prev = SDL_GetRenderTarget(r->sdl);
+    if (SDL_SetRenderTarget(r->sdl, bg->target) != 0) {
+        LOG_WARN("level_bg", "Failed to bind background target: %s", SDL_GetError());
+        SDL_DestroyTexture(bg->target);
+        bg->target = NULL;
+        bg->unsupported = true;
+        renderer_set_deferred(r, was_deferred);
+        return false;
+    }
+    SDL_SetRenderDrawColor(r->sdl, 0, 0, 0, 255);
+    SDL_RenderClear(r->sdl);
+    level_background_draw_layer(r, nebula, planets, planet_count);
+    SDL_SetRenderTarget(r->sdl, prev);
+    renderer_set_deferred(r, was_deferred);
+
+    bg->baked_nebula = nebula;
+    bg->dirty = false;
+    LOG_DEBUG("level_bg", "Baked background layer (%d planets)", planet_count);
+    return true;
+}
+
+bool level_background_render(LevelBackground *bg, struct Renderer *r, SDL_Texture *nebula,
+                             struct Planet *const *planets, int planet_count) {
+    if (!r)
+        return false;
+    if (!bg || bg->unsupported) {
+        renderer_draw_texture(r, nebula, NULL, NULL, 0);
+        return false;
+    }
+    if (bg->dirty || !bg->target || bg->baked_nebula != nebula) {
+        if (!level_background_bake(bg, r, nebula, planets, planet_count)) {
+            level_background_draw_layer(r, nebula, planets, planet_count);
+            return true;
+        }
+    }
+    renderer_draw_texture(r, bg->target, NULL, NULL, 0.f);
+    return true;
+}
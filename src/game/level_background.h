@@ -0,0 +1,31 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+
+struct Renderer;
+struct Planet;
+
+/* Static level background layer.
+ *
+ * Planets never move after a level is populated, so the nebula and every planet
+ * sprite are composited once into a screen-sized render target. Each frame then
+ * starts with a single full-screen copy instead of one textured draw per planet.
+ * The cache is rebuilt only after level_background_invalidate() or when the
+ * nebula texture itself is replaced.
+ */
+typedef struct LevelBackground {
+    SDL_Texture *target;         // screen-sized render target holding the baked layer
+    SDL_Texture *baked_nebula;   // nebula texture used for the current bake
+    int width, height;
+    bool dirty;                  // planets changed since last bake
+    bool unsupported;            // render target creation failed; draw immediately instead
+} LevelBackground;
+
+LevelBackground *level_background_create(int width, int height);
+void level_background_destroy(LevelBackground *bg);
+/* Mark the cached layer stale (call whenever a planet is added, removed or changed). */
+void level_background_invalidate(LevelBackground *bg);
+/* Draw nebula + planets. Returns true when the planets are part of the copied layer
+ * and must not be drawn again; false means the caller still has to draw them. */
+bool level_background_render(LevelBackground *bg, struct Renderer *r, SDL_Texture *nebula,
+                             struct Planet *const *planets, int planet_count);
@@ -2,6 +2,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <SDL2/SDL.h>
+#include "../core/vfs.h"
 
 #pragma pack(push,1)
 typedef struct {
@@ -38,14 +40,143 @@ typedef struct {
 } EnemyEntry;
 #pragma pack(pop)
 
-static const char *spawn_kind_name(uint8_t k) {
+_Static_assert(sizeof(LevelFileHeader) == 64, "v2 header layout");
+_Static_assert(sizeof(LevelSection) == 16, "v2 section layout");
+_Static_assert(sizeof(LevelPlanet) == 16, "v2 planet record layout");
+_Static_assert(sizeof(LevelEnemy) == 28, "v2 enemy record layout");
+_Static_assert(sizeof(LevelBakedHeader) == 40, "v2 baked section header layout");
 
-    switch (k) {
-        case 0: return "on_start";
-        case 1: return "on_death";
-    default: return "unknown";
+#define LEVEL_ERR(code, ...) do { if (err && errlen) snprintf(err, errlen, __VA_ARGS__); return code; } while (0)
 
+static void level_copy_header(GameLevel *out, uint16_t version, uint32_t time_limit, uint16_t goal_kills, const uint32_t rating[3],
+                              float px, float py, uint32_t health) {
+    out->version = version;
+    out->time_limit = time_limit;
+    out->goal_kills = goal_kills;
+    out->rating[0] = rating[0]; out->rating[1] = rating[1]; out->rating[2] = rating[2];
+    out->player_pos_x = px; out->player_pos_y = py; out->player_health = health;
 }
+
+// Version 1: packed records, converted into one allocation
+static int level_parse_v1(GameLevel *out, const uint8_t *cur, const uint8_t *end, char *err, size_t errlen) {
+
+    FileHeader h;
+    if ((size_t)(end - cur) < sizeof(h))
+        LEVEL_ERR(3, "failed to read header");
+    memcpy(&h, cur, sizeof(h));
+    cur += sizeof(h);
+    level_copy_header(out, h.version, h.time_limit, h.goal_kills, h.rating, h.player_pos_x, h.player_pos_y, h.player_health);
+
+    // start_text (NUL terminated, or up to the end of the file)
+    const uint8_t *nul = memchr(cur, '\0', (size_t)(end - cur));
+    size_t si = nul ? (size_t)(nul - cur) : (size_t)(end - cur);
+    const uint8_t *text = cur;
+    cur += nul ? si + 1 : si;
+
+    if ((size_t)(end - cur) / sizeof(PlanetEntry) < h.planets_count)
+        LEVEL_ERR(8, "failed to read planet");
+    const uint8_t *planets = cur;
+    cur += (size_t)h.planets_count * sizeof(PlanetEntry);
+    if ((size_t)(end - cur) / sizeof(EnemyEntry) < h.enemies_count)
+        LEVEL_ERR(10, "failed to read enemy");
+    const uint8_t *enemies = cur;
+
+    // enemies first so every block stays aligned, text last
+    size_t enemy_bytes = sizeof(LevelEnemy) * h.enemies_count;
+    size_t planet_bytes = sizeof(LevelPlanet) * h.planets_count;
+    uint8_t *block = malloc(enemy_bytes + planet_bytes + si + 1);
+    if (!block)
+        LEVEL_ERR(5, "alloc failed");
+    out->owned = block;
+
+    LevelEnemy *le = (LevelEnemy *)block;
+    for (uint32_t i = 0; i < h.enemies_count; ++i) {
+        EnemyEntry ee;
+        memcpy(&ee, enemies + i * sizeof(ee), sizeof(ee));
+        memset(&le[i], 0, sizeof(le[i]));
+        le[i].id = ee.id; le[i].type = ee.type;
+        le[i].pos_x = ee.pos_x; le[i].pos_y = ee.pos_y;
+        le[i].difficulty = ee.difficulty; le[i].health = ee.health;
+        le[i].spawn_kind = ee.spawn_kind; le[i].spawn_arg = ee.spawn_arg; le[i].spawn_delay = ee.spawn_delay;
+    }
+    LevelPlanet *lp = (LevelPlanet *)(block + enemy_bytes);
+    for (uint32_t i = 0; i < h.planets_count; ++i) {
+        PlanetEntry pe;
+        memcpy(&pe, planets + i * sizeof(pe), sizeof(pe));
+        memset(&lp[i], 0, sizeof(lp[i]));
+        lp[i].type = pe.type; lp[i].size = pe.size; lp[i].pos_x = pe.pos_x; lp[i].pos_y = pe.pos_y;
+    }
+    char *sbuf = (char *)(block + enemy_bytes + planet_bytes);
+    memcpy(sbuf, text, si);
+    sbuf[si] = '\0';
+
+    out->start_text = sbuf;
+    out->planets = h.planets_count ? lp : NULL;
+    out->enemies = h.enemies_count ? le : NULL;
+    out->planets_count = h.planets_count;
+    out->enemies_count = h.enemies_count;
+    return 0;
+}
+
+static uint32_t level_crc_v2(const uint8_t *data, size_t size) {
+    static const uint8_t zero[4] = {0};
+    size_t at = offsetof(LevelFileHeader, crc);
+    uint32_t crc = vfs_crc32(0, data, at);
+    crc = vfs_crc32(crc, zero, sizeof(zero));
+    return vfs_crc32(crc, data + at + sizeof(zero), size - at - sizeof(zero));
+}
+
+// Version 2: validate the header and section table, then point into the file
+static int level_parse_v2(GameLevel *out, const VfsFile *file, char *err, size_t errlen) {
+
+    const uint8_t *base = (const uint8_t *)file->data;
+    if (((uintptr_t)base % LEVEL_SECTION_ALIGN) != 0)
+        LEVEL_ERR(3, "file buffer not %d-byte aligned", LEVEL_SECTION_ALIGN);
+    if (file->size < sizeof(LevelFileHeader))
+        LEVEL_ERR(3, "failed to read header");
+    const LevelFileHeader *h = (const LevelFileHeader *)base;
+    if (h->header_size != sizeof(LevelFileHeader) || h->file_size != file->size)
+        LEVEL_ERR(3, "truncated or damaged header");
+    // Packed copies were already verified by the VFS
+    if (!file->packed && level_crc_v2(base, file->size) != h->crc)
+        LEVEL_ERR(11, "checksum mismatch");
+    if ((h->table_offset % _Alignof(LevelSection)) != 0 ||
+        (uint64_t)h->table_offset + (uint64_t)h->section_count * sizeof(LevelSection) > file->size)
+        LEVEL_ERR(3, "bad section table");
+    level_copy_header(out, h->version, h->time_limit, h->goal_kills, h->rating, h->player_pos_x, h->player_pos_y, h->player_health);
+
+    out->sections = (const LevelSection *)(base + h->table_offset);
+    out->section_count = h->section_count;
+    for (uint32_t i = 0; i < h->section_count; ++i) {
+        const LevelSection *sec = &out->sections[i];
+        if ((uint64_t)sec->offset + sec->size > file->size || (sec->offset % LEVEL_SECTION_ALIGN) != 0)
+            LEVEL_ERR(3, "section %u out of range", (unsigned)sec->id);
+        const uint8_t *data = base + sec->offset;
+        switch (sec->id) {
+        case LEVEL_SECTION_STRINGS:
+            if (sec->size == 0 || data[sec->size - 1] != '\0')
+                LEVEL_ERR(3, "unterminated start text");
+            out->start_text = (const char *)data;
+            break;
+        case LEVEL_SECTION_PLANETS:
+            if ((uint64_t)sec->count * sizeof(LevelPlanet) > sec->size)
+                LEVEL_ERR(8, "failed to read planet");
+            out->planets = sec->count ? (const LevelPlanet *)data : NULL;
+            out->planets_count = sec->count;
+            break;
+        case LEVEL_SECTION_ENEMIES:
+            if ((uint64_t)sec->count * sizeof(LevelEnemy) > sec->size)
+                LEVEL_ERR(10, "failed to read enemy");
+            out->enemies = sec->count ? (const LevelEnemy *)data : NULL;
+            out->enemies_count = sec->count;
+            break;
+        default:
+            break;
+        }
+    }
+    if (!out->start_text)
+        out->start_text = "";
+    return 0;
 }
 
 int level_load(const char *filename, GameLevel *out, char *err, size_t errlen) {
@@ -55,100 +186,85 @@ int level_load(const char *filename, GameLevel *out, char *err, size_t errlen) {
         return 1;
 
 }
+    memset(out, 0, sizeof(*out));
 
-    // Build path under assets/levels if filename is not absolute
+    // Levels are read through the VFS: from the asset pack when mounted, else assets/levels/
     char path[512];
     if (filename[0] == '/' || (filename[1] == ':' && filename[2] == '\\')) {
         strncpy(path, filename, sizeof(path)-1);
         path[sizeof(path)-1] = '\0';
     } else {
-        snprintf(path, sizeof(path), "assets/levels/%s", filename);
+        snprintf(path, sizeof(path), "levels/%s", filename);
     }
 
-    FILE *f = fopen(path, "rb");
-    if (!f) {
+    if (!vfs_open(path, &out->file)) {
         if (err && errlen) snprintf(err, errlen, "failed to open '%s'", path);
         return 2;
     }
-
-    FileHeader h;
-    if (fread(&h, sizeof(h), 1, f) != 1) {
+    const uint8_t *data = (const uint8_t *)out->file.data;
+    size_t size = out->file.size;
+    if (size < 6) {
         if (err && errlen) snprintf(err, errlen, "failed to read header");
-        fclose(f); return 3;
+        level_free(out); return 3;
     }
-    if (memcmp(h.magic, "GHLV", 4) != 0) {
-        if (err && errlen) snprintf(err, errlen, "bad magic"); fclose(f); return 4;
+    if (memcmp(data, "GHLV", 4) != 0) {
+        if (err && errlen) snprintf(err, errlen, "bad magic");
+        level_free(out); return 4;
     }
+    uint16_t version;
+    memcpy(&version, data + 4, sizeof(version));
 
-    // fill basic header fields
-    memset(out, 0, sizeof(*out));
-    out->version = h.version;
-    out->time_limit = h.time_limit;
-    out->goal_kills = h.goal_kills;
-    out->rating[0] = h.rating[0]; out->rating[1] = h.rating[1]; out->rating[2] = h.rating[2];
-    out->player_pos_x = h.player_pos_x; out->player_pos_y = h.player_pos_y; out->player_health = h.player_health;
-    out->planets_count = h.planets_count; out->enemies_count = h.enemies_count;
-
-    // read start_text
-    size_t cap = 256;
-    char *sbuf = (char*)malloc(cap);
-    if (!sbuf) {
-        if (err && errlen) snprintf(err, errlen, "alloc failed"); fclose(f); return 5;
-    }
-    size_t si = 0; int c;
-    while ((c = fgetc(f)) != EOF && c != '\0') {
-        if (si + 1 >= cap) {
-            cap *= 2; char *n = (char*)realloc(sbuf, cap);
-            if (!n) { free(sbuf); if (err && errlen) snprintf(err, errlen, "alloc failed"); fclose(f); return 6;
-        }
-            sbuf = n;
-        }
-        sbuf[si++] = (char)c;
+    int rc;
+    if (version >= LEVEL_VERSION_V2) {
+        rc = level_parse_v2(out, &out->file, err, errlen);
+    } else {
+        rc = level_parse_v1(out, data, data + size, err, errlen);
+        // v1 data now lives in 'owned'; the file is no longer needed
+        vfs_close(&out->file);
     }
-    sbuf[si] = '\0';
-    out->start_text = sbuf;
+    if (rc != 0)
+        level_free(out);
+    return rc;
+}
 
-    // read planets
-    out->planets = NULL; out->enemies = NULL;
-    if (out->planets_count) {
-        out->planets = (LevelPlanet*)malloc(sizeof(LevelPlanet) * out->planets_count);
-        if (!out->planets) { if (err && errlen) snprintf(err, errlen, "alloc failed"); fclose(f); return 7;
-    }
-        for (uint32_t i = 0; i < out->planets_count; ++i) {
-            PlanetEntry pe;
-            if (fread(&pe, sizeof(pe), 1, f) != 1) { if (err && errlen) snprintf(err, errlen, "failed to read planet"); fclose(f); return 8;
-        }
-            out->planets[i].type = pe.type; out->planets[i].size = pe.size; out->planets[i].pos_x = pe.pos_x; out->planets[i].pos_y = pe.pos_y;
-        }
-    }
+const void *level_section(const GameLevel *lvl, uint32_t id, uint32_t *size) {
 
-    // read enemies
-    if (out->enemies_count) {
-        out->enemies = (LevelEnemy*)malloc(sizeof(LevelEnemy) * out->enemies_count);
-        if (!out->enemies) { if (err && errlen) snprintf(err, errlen, "alloc failed"); fclose(f); return 9;
-    }
-        for (uint32_t i = 0; i < out->enemies_count; ++i) {
-            EnemyEntry ee;
-            if (fread(&ee, sizeof(ee), 1, f) != 1) { if (err && errlen) snprintf(err, errlen, "failed to read enemy"); fclose(f); return 10;
-        }
-            out->enemies[i].id = ee.id; out->enemies[i].type = ee.type;
-            out->enemies[i].pos_x = ee.pos_x; out->enemies[i].pos_y = ee.pos_y;
-            out->enemies[i].difficulty = ee.difficulty; out->enemies[i].health = ee.health;
-            out->enemies[i].spawn_kind = ee.spawn_kind; out->enemies[i].spawn_arg = ee.spawn_arg; out->enemies[i].spawn_delay = ee.spawn_delay;
-        }
+    if (size) *size = 0;
+    if (!lvl || !lvl->sections)
+        return NULL;
+    for (uint32_t i = 0; i < lvl->section_count; ++i) {
+        if (lvl->sections[i].id != id)
+            continue;
+        if (size) *size = lvl->sections[i].size;
+        return (const uint8_t *)lvl->file.data + lvl->sections[i].offset;
     }
+    return NULL;
 
-    fclose(f);
-    return 0;
 }
 
 void level_free(GameLevel *lvl) {
 
     if (!lvl) return;
-    if (lvl->start_text) free(lvl->start_text);
-    if (lvl->planets) free(lvl->planets);
-    if (lvl->enemies) free(lvl->enemies);
+    free(lvl->owned);
+    vfs_close(&lvl->file);
+    lvl->owned = NULL;
     lvl->start_text = NULL; lvl->planets = NULL; lvl->enemies = NULL;
+    lvl->sections = NULL; lvl->section_count = 0;
+
+}
+
+double level_benchmark(const char *filename, int iterations) {
+
+    if (iterations < 1) iterations = 1;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int i = 0; i < iterations; ++i) {
+        GameLevel lvl;
+        if (level_load(filename, &lvl, NULL, 0) != 0)
+            return -1.0;
+        level_free(&lvl);
+    }
+    double us = (double)(SDL_GetPerformanceCounter() - t0) * 1e6 / (double)SDL_GetPerformanceFrequency();
+    return us / iterations;
 
 }
 
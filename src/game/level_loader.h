@@ -3,25 +3,91 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "../core/vfs.h"
 
 // Simple runtime representation of a level loaded from binary .lvl files.
-// The loader reads files produced by the tools/level_compiler.py format.
+// The loader reads files produced by assets/levels/level_compiler.py.
+//
+// Version 2 files are section-indexed and every record is stored exactly as
+// LevelPlanet / LevelEnemy below (little endian, naturally aligned), so the
+// loader hands out views into the mapped file instead of copying:
+//   LevelFileHeader (64 bytes), LevelSection table, then the sections, each
+//   starting on a 16 byte boundary. The header CRC32 covers the whole file
+//   with the crc field read as zero.
+// Version 1 files (packed records after a NUL-terminated start text) are
+// still accepted and converted on load.
+
+#define LEVEL_VERSION_V1 1
+#define LEVEL_VERSION_V2 2
+#define LEVEL_SECTION_ALIGN 16
+
+typedef enum LevelSectionId {
+    LEVEL_SECTION_STRINGS = 1, // start text, NUL terminated
+    LEVEL_SECTION_PLANETS = 2, // LevelPlanet[count]
+    LEVEL_SECTION_ENEMIES = 3, // LevelEnemy[count]
+    // Optional data precomputed from the planets (compiler --bake), each a
+    // LevelBakedHeader followed by its payload; see game/planet_field.h
+    LEVEL_SECTION_GRAVITY = 4,   // float[rows][cols][2] acceleration at each grid node
+    LEVEL_SECTION_SDF = 5,       // float[rows][cols] distance to the nearest planet surface
+    LEVEL_SECTION_BROADPHASE = 6 // uint32 start[cols*rows+1], then uint16 planet indices
+} LevelSectionId;
+
+typedef struct {
+    char magic[4];          // "GHLV"
+    uint16_t version;       // LEVEL_VERSION_V2
+    uint16_t header_size;
+    uint32_t file_size;
+    uint32_t crc;
+    uint32_t section_count;
+    uint32_t table_offset;
+    uint32_t time_limit;
+    uint16_t goal_kills;
+    uint16_t reserved;
+    uint32_t rating[3];
+    float player_pos_x;
+    float player_pos_y;
+    uint32_t player_health;
+    uint8_t reserved2[8];
+} LevelFileHeader;
+
+typedef struct {
+    uint32_t id;     // LevelSectionId; unknown ids are skipped
+    uint32_t offset; // from the start of the file
+    uint32_t size;   // bytes
+    uint32_t count;  // records
+} LevelSection;
 
 typedef struct {
     uint8_t type;
+    uint8_t reserved[3];
     float size;
     float pos_x;
     float pos_y;
 } LevelPlanet;
 
+typedef struct {
+    uint16_t version;     // PLANET_FIELD_VERSION
+    uint16_t header_size;
+    uint32_t crc;         // CRC32 of the payload that follows
+    uint32_t planets_crc; // CRC32 of the planet section it was computed from
+    uint16_t cols, rows;
+    float origin_x, origin_y;
+    float cell;           // grid spacing in pixels
+    // physics the gravity grid was computed with; a mismatch means it is stale
+    float gravity_const;  // PROJ_GRAVITY_CONST
+    float epsilon;        // PROJ_EPSILON
+    float mass_factor;    // PLANET_MASS_FACTOR
+} LevelBakedHeader;
+
 typedef struct {
     uint16_t id;        // as stored in file (JSON id)
     uint8_t type;
+    uint8_t difficulty;
     float pos_x;
     float pos_y;
-    uint8_t difficulty;
     uint32_t health;
     uint8_t spawn_kind; // 0=on_start,1=on_death
+    uint8_t reserved[3];
     uint32_t spawn_arg; // stores ID for on_death
     uint32_t spawn_delay;
 } LevelEnemy;
@@ -40,17 +106,30 @@ typedef struct {
     uint32_t planets_count;
     uint32_t enemies_count;
 
-    // allocated arrays / strings (must be freed with level_free)
-    char *start_text;
-    LevelPlanet *planets;
-    LevelEnemy *enemies;
+    // views into the level file (v2) or into 'owned' (v1); valid until level_free
+    const char *start_text;
+    const LevelPlanet *planets;
+    const LevelEnemy *enemies;
+
+    // backing storage (released by level_free)
+    VfsFile file;
+    const LevelSection *sections;
+    uint32_t section_count;
+    void *owned;
 } GameLevel;
 
 // Loads a level from the assets/levels folder (relative name like "1.lvl" or a path).
 // On success returns 0 and fills 'out'. On error returns non-zero and places a message into err (if provided).
 int level_load(const char *filename, GameLevel *out, char *err, size_t errlen);
 
+// Returns the payload of a v2 section (NULL if absent or for v1 files) and its size in 'size' (optional).
+const void *level_section(const GameLevel *lvl, uint32_t id, uint32_t *size);
+
 // Frees memory previously allocated in GameLevel by level_load.
 void level_free(GameLevel *lvl);
 
+// Loads 'filename' 'iterations' times and returns the average time per load in microseconds
+// (negative if the level fails to load).
+double level_benchmark(const char *filename, int iterations);
+
 #endif // GH_LEVEL_LOADER_H
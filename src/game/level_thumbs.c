@@ -0,0 +1,251 @@
+#include "level_thumbs.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "campaign_levels.h"
+#include "../core/fs.h"
+#include "../core/log.h"
+#include "../core/types.h"
+
+#define THUMB_CACHE_MAGIC "GHTB"
+#define THUMB_PIXELS ((size_t)LEVEL_THUMB_W * LEVEL_THUMB_H)
+
+#define THUMB_BACKGROUND 0xFF0A0D1Cu
+#define THUMB_PLAYER 0xFF4CE05Au
+#define THUMB_ENEMY 0xFFE8483Cu
+#define THUMB_ENEMY_LATE 0xFFF0A030u /* spawned when another enemy dies */
+
+/* Average colour of each sprite in images/planets_atlas.png, by planet type */
+static const uint32_t PLANET_COLORS[16] = {
+    0xFFA83D1Du, 0xFFC57218u, 0xFF31865Cu, 0xFF458428u, 0xFF085C7Cu, 0xFF82386Bu, 0xFF967E5Du, 0xFF90304Eu,
+    0xFF98805Eu, 0xFFC06916u, 0xFF3C9577u, 0xFF3DA8ACu, 0xFF4C872Au, 0xFFB99251u, 0xFF92551Cu, 0xFF794620u,
+};
+
+typedef struct ThumbCacheHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t width;
+    uint16_t height;
+    uint16_t reserved;
+    uint32_t hash;
+} ThumbCacheHeader;
+
+enum { THUMB_QUEUED = 0, THUMB_READY, THUMB_FAILED };
+
+typedef struct LevelThumb {
+    char filename[CAMPAIGN_LEVEL_MAX_FILENAME];
+    uint32_t hash;   /* content hash from the campaign index, 0 = not cacheable */
+    uint32_t asked;  /* request serial of the last lookup; newest is built first */
+    int state;
+    SDL_Texture *tex;
+} LevelThumb;
+
+static struct {
+    LevelThumb *items;
+    int count, capacity;
+    uint32_t serial;
+} g_thumbs;
+
+/* Alpha-blend one colour into a pixel (coverage 0..1) */
+static void thumb_blend(uint32_t *px, uint32_t color, float coverage) {
+    if (coverage <= 0.f)
+        return;
+    if (coverage > 1.f)
+        coverage = 1.f;
+    uint32_t a = (uint32_t)(coverage * 256.f);
+    uint32_t d = *px;
+    uint32_t rb = ((((color & 0xFF00FFu) * a) + ((d & 0xFF00FFu) * (256u - a))) >> 8) & 0xFF00FFu;
+    uint32_t g = ((((color & 0x00FF00u) * a) + ((d & 0x00FF00u) * (256u - a))) >> 8) & 0x00FF00u;
+    *px = 0xFF000000u | rb | g;
+}
+
+static uint32_t thumb_shade(uint32_t color, float f) {
+    uint32_t r = (uint32_t)((float)((color >> 16) & 0xFF) * f);
+    uint32_t g = (uint32_t)((float)((color >> 8) & 0xFF) * f);
+    uint32_t b = (uint32_t)((float)(color & 0xFF) * f);
+    return 0xFF000000u | (r > 255 ? 255 : r) << 16 | (g > 255 ? 255 : g) << 8 | (b > 255 ? 255 : b);
+}
+
+/* Filled disc with a one pixel soft edge; shaded discs get lighter toward the upper left */
+static void thumb_disc(uint32_t *pixels, float cx, float cy, float radius, uint32_t color, bool shaded) {
+    int x0 = (int)floorf(cx - radius - 1.f), x1 = (int)ceilf(cx + radius + 1.f);
+    int y0 = (int)floorf(cy - radius - 1.f), y1 = (int)ceilf(cy + radius + 1.f);
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > LEVEL_THUMB_W) x1 = LEVEL_THUMB_W;
+    if (y1 > LEVEL_THUMB_H) y1 = LEVEL_THUMB_H;
+    for (int y = y0; y < y1; ++y) {
+        float dy = (float)y + 0.5f - cy;
+        uint32_t *row = pixels + (size_t)y * LEVEL_THUMB_W;
+        for (int x = x0; x < x1; ++x) {
+            float dx = (float)x + 0.5f - cx;
+            float d = sqrtf(dx * dx + dy * dy);
+            float coverage = radius + 0.5f - d;
+            if (coverage <= 0.f)
+                continue;
+            uint32_t c = color;
+            if (shaded && radius > 0.f)
+                c = thumb_shade(color, 1.05f - 0.35f * (dx + dy) / (2.f * radius));
+            thumb_blend(&row[x], c, coverage);
+        }
+    }
+}
+
+void level_thumbs_draw(const GameLevel *lvl, uint32_t *pixels) {
+    if (!pixels)
+        return;
+    for (size_t i = 0; i < THUMB_PIXELS; ++i)
+        pixels[i] = THUMB_BACKGROUND;
+    if (!lvl)
+        return;
+    const float sx = (float)LEVEL_THUMB_W / (float)DISPLAY_W;
+    const float sy = (float)LEVEL_THUMB_H / (float)DISPLAY_H;
+    for (uint32_t i = 0; i < lvl->planets_count; ++i) {
+        const LevelPlanet *p = &lvl->planets[i];
+        uint32_t color = PLANET_COLORS[p->type % 16];
+        thumb_disc(pixels, p->pos_x * sx, p->pos_y * sy, p->size * sx, color, true);
+    }
+    for (uint32_t i = 0; i < lvl->enemies_count; ++i) {
+        const LevelEnemy *e = &lvl->enemies[i];
+        uint32_t color = e->spawn_kind == 1 ? THUMB_ENEMY_LATE : THUMB_ENEMY;
+        thumb_disc(pixels, e->pos_x * sx, e->pos_y * sy, 2.f, color, false);
+    }
+    /* (0,0) means the player is placed at random */
+    if (lvl->player_pos_x != 0.f || lvl->player_pos_y != 0.f) {
+        float px = lvl->player_pos_x * sx, py = lvl->player_pos_y * sy;
+        thumb_disc(pixels, px, py, 4.f, 0xFFFFFFFFu, false);
+        thumb_disc(pixels, px, py, 3.f, THUMB_PLAYER, false);
+    }
+}
+
+static void thumb_cache_path(uint32_t hash, char *buf, size_t len) {
+    snprintf(buf, len, "%s/thumb_v%d_%08x.bin", fs_cache_dir(), LEVEL_THUMB_VERSION, (unsigned)hash);
+}
+
+static SDL_Texture *thumb_texture(SDL_Renderer *sdl, const uint32_t *pixels) {
+    SDL_Texture *tex = SDL_CreateTexture(sdl, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, LEVEL_THUMB_W, LEVEL_THUMB_H);
+    if (!tex)
+        return NULL;
+    SDL_UpdateTexture(tex, NULL, pixels, LEVEL_THUMB_W * (int)sizeof(uint32_t));
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_NONE);
+    return tex;
+}
+
+/* Cache hit: upload straight from the mapping */
+static SDL_Texture *thumb_cache_load(SDL_Renderer *sdl, uint32_t hash) {
+    char path[256];
+    thumb_cache_path(hash, path, sizeof(path));
+    FsMapping map;
+    if (!fs_map_file(path, &map))
+        return NULL;
+    const ThumbCacheHeader *hdr = (const ThumbCacheHeader *)map.data;
+    bool ok = map.size == sizeof(*hdr) + THUMB_PIXELS * sizeof(uint32_t) && memcmp(hdr->magic, THUMB_CACHE_MAGIC, 4) == 0 &&
+              hdr->version == LEVEL_THUMB_VERSION && hdr->width == LEVEL_THUMB_W && hdr->height == LEVEL_THUMB_H &&
+              hdr->hash == hash;
+    SDL_Texture *tex = ok ? thumb_texture(sdl, (const uint32_t *)((const uint8_t *)map.data + sizeof(*hdr))) : NULL;
+    fs_unmap_file(&map);
+    return tex;
+}
+
+static void thumb_cache_store(uint32_t hash, const uint32_t *pixels) {
+    ThumbCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, THUMB_CACHE_MAGIC, 4);
+    hdr.version = LEVEL_THUMB_VERSION;
+    hdr.width = LEVEL_THUMB_W;
+    hdr.height = LEVEL_THUMB_H;
+    hdr.hash = hash;
+    char path[256];
+    thumb_cache_path(hash, path, sizeof(path));
+    if (!fs_write_file_atomic(path, &hdr, sizeof(hdr), pixels, THUMB_PIXELS * sizeof(uint32_t)))
+        LOG_WARN("level_thumbs", "Failed to store %s", path);
+}
+
+static LevelThumb *thumb_find(const char *filename) {
+    for (int i = 0; i < g_thumbs.count; ++i) {
+        if (strncmp(g_thumbs.items[i].filename, filename, CAMPAIGN_LEVEL_MAX_FILENAME) == 0)
+            return &g_thumbs.items[i];
+    }
+    return NULL;
+}
+
+SDL_Texture *level_thumbs_get(const char *filename) {
+    if (!filename || !filename[0])
+        return NULL;
+    LevelThumb *t = thumb_find(filename);
+    if (!t) {
+        if (g_thumbs.count == g_thumbs.capacity) {
+            int capacity = g_thumbs.capacity ? g_thumbs.capacity * 2 : 32;
+            LevelThumb *items = realloc(g_thumbs.items, (size_t)capacity * sizeof(*items));
+            if (!items)
+                return NULL;
+            g_thumbs.items = items;
+            g_thumbs.capacity = capacity;
+        }
+        t = &g_thumbs.items[g_thumbs.count++];
+        memset(t, 0, sizeof(*t));
+        snprintf(t->filename, sizeof(t->filename), "%s", filename);
+        const CampaignIndexEntry *entry = campaign_levels_index_find(filename);
+        t->hash = entry ? entry->content_hash : 0;
+        t->state = THUMB_QUEUED;
+    }
+    t->asked = ++g_thumbs.serial;
+    return t->tex;
+}
+
+bool level_thumbs_step(SDL_Renderer *sdl) {
+    if (!sdl)
+        return false;
+    LevelThumb *t = NULL;
+    for (int i = 0; i < g_thumbs.count; ++i) {
+        LevelThumb *c = &g_thumbs.items[i];
+        if (c->state == THUMB_QUEUED && (!t || c->asked > t->asked))
+            t = c;
+    }
+    if (!t)
+        return false;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    bool cached = false;
+    if (t->hash) {
+        t->tex = thumb_cache_load(sdl, t->hash);
+        cached = t->tex != NULL;
+    }
+    if (!t->tex) {
+        GameLevel lvl;
+        char err[128] = "out of memory";
+        uint32_t *pixels = malloc(THUMB_PIXELS * sizeof(uint32_t));
+        if (pixels && level_load(t->filename, &lvl, err, sizeof(err)) == 0) {
+            level_thumbs_draw(&lvl, pixels);
+            level_free(&lvl);
+            t->tex = thumb_texture(sdl, pixels);
+            if (t->tex && t->hash)
+                thumb_cache_store(t->hash, pixels);
+        } else if (pixels) {
+            LOG_WARN("level_thumbs", "No preview for %s: %s", t->filename, err);
+        }
+        free(pixels);
+    }
+    t->state = t->tex ? THUMB_READY : THUMB_FAILED;
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    LOG_DEBUG("level_thumbs", "Thumbnail %s %s in %.2f ms", t->filename, cached ? "loaded from cache" : "drawn", ms);
+    return t->tex != NULL;
+}
+
+void level_thumbs_drop_textures(void) {
+    for (int i = 0; i < g_thumbs.count; ++i) {
+        LevelThumb *t = &g_thumbs.items[i];
+        if (t->tex)
+            SDL_DestroyTexture(t->tex);
+        t->tex = NULL;
+        if (t->state == THUMB_READY)
+            t->state = THUMB_QUEUED;
+    }
+}
+
+void level_thumbs_shutdown(void) {
+    level_thumbs_drop_textures();
+    free(g_thumbs.items);
+    memset(&g_thumbs, 0, sizeof(g_thumbs));
+}
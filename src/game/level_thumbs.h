@@ -0,0 +1,56 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "level_loader.h"
+
+#define LEVEL_THUMB_W 192
+#define LEVEL_THUMB_H 108
+/* Bump whenever the thumbnail drawing changes so stale cache files are ignored */
+#define LEVEL_THUMB_VERSION 1
+
+/* Campaign level previews.
+ *
+ * A thumbnail shows a level's planets, the player start and the enemy spawn
+ * points, drawn on the CPU into an ARGB8888 buffer (no render target, nothing
+ * touches the frame being presented). Finished thumbnails are stored in the
+ * cache directory under the level's content hash from the campaign index, so
+ * an unchanged level is only ever drawn once.
+ *
+ * Lookups never block: level_thumbs_get() queues a missing thumbnail and
+ * returns NULL, and level_thumbs_step() builds one queued thumbnail per call
+ * (the one asked for most recently first). The campaign menu calls it on idle
+ * frames so previews stream in without slowing down navigation.
+ */
+
+/**
+ * @brief Draw a level preview
+ * @param lvl Loaded level
+ * @param pixels Destination, LEVEL_THUMB_W*LEVEL_THUMB_H ARGB8888 pixels, tightly packed
+ */
+void level_thumbs_draw(const GameLevel *lvl, uint32_t *pixels);
+
+/**
+ * @brief Thumbnail texture of a campaign level; queues it if not built yet
+ * @param filename Level file name as listed in the campaign index
+ * @return Texture, or NULL until level_thumbs_step() has produced it
+ */
+SDL_Texture *level_thumbs_get(const char *filename);
+
+/**
+ * @brief Build the most recently requested missing thumbnail (cache file or drawing)
+ * @param sdl Renderer used to create the texture (main thread)
+ * @return true if a thumbnail became available
+ */
+bool level_thumbs_step(SDL_Renderer *sdl);
+
+/**
+ * @brief Release all thumbnail textures (they come back from the disk cache on demand)
+ */
+void level_thumbs_drop_textures(void);
+
+/**
+ * @brief Release textures and bookkeeping
+ */
+void level_thumbs_shutdown(void);
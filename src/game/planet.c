@@ -2,7 +2,7 @@
 #include <stdlib.h>
 #include "../services/renderer.h"
 #include "projectile.h"
-#include "explosion.h"
+#include "../services/explosion_gen.h"
 #include "world.h"
 #include "../services/texture_manager.h"
 #include "../services/services.h"
@@ -30,14 +30,7 @@ static void planet_on_hit_entity(Entity *e, Entity *hitter) {
         if (pr) pr->active = false; // destroy projectile on impact
         Planet *p = (Planet*)e;
         if (p->world){
-            Services *svc = services_get();
-            if (svc && svc->texman){
-                int types = texman_explosion_type_count(svc->texman);
-                if (types>0){
-                    int type = rand() % types;
-                    world_add_explosion(p->world, type, hitter->pos.x, hitter->pos.y, 0.5);
-}
-            }
+            effects_emit_planet_hit(&p->world->effects, rand() % EXPLOSION_GEN_TYPES, hitter->pos.x, hitter->pos.y);
         }
     }
 }
@@ -0,0 +1,296 @@
+#include "planet_field.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "planet.h"
+#include "../core/log.h"
+#include "../core/vfs.h"
+
+#define FIELD_MAX_NODES (1 << 20)
+
+static size_t field_align(size_t n) {
+    return (n + 15) & ~(size_t)15;
+}
+
+static int field_clamp_cell(float v, int n) {
+    if (!(v > 0.f))
+        return 0;
+    if (v >= (float)(n - 1))
+        return n - 1;
+    return (int)v;
+}
+
+void planet_field_free(PlanetField *f) {
+    if (!f)
+        return;
+    free(f->block);
+    memset(f, 0, sizeof(*f));
+}
+
+/* One allocation for the grids, the broadphase and the dedup stamps */
+static bool field_alloc(PlanetField *f, int cols, int rows, int bcols, int brows, uint32_t entries, int planet_count) {
+    size_t nodes = (size_t)cols * rows;
+    size_t cells = (size_t)bcols * brows;
+    size_t accel = field_align(nodes * 2 * sizeof(float));
+    size_t sdf = field_align(nodes * sizeof(float));
+    size_t start = field_align((cells + 1) * sizeof(uint32_t));
+    size_t list = field_align((size_t)entries * sizeof(uint16_t));
+    size_t stamp = field_align((size_t)planet_count * sizeof(uint32_t));
+    uint8_t *block = calloc(1, accel + sdf + start + list + stamp);
+    if (!block)
+        return false;
+    f->block = block;
+    f->accel = (float *)block;
+    f->sdf = (float *)(block + accel);
+    f->cell_start = (uint32_t *)(block + accel + sdf);
+    f->cell_planets = (uint16_t *)(block + accel + sdf + start);
+    f->stamp = (uint32_t *)(block + accel + sdf + start + list);
+    f->cols = cols;
+    f->rows = rows;
+    f->bcols = bcols;
+    f->brows = brows;
+    f->planet_count = planet_count;
+    return true;
+}
+
+static void field_compute_grids(PlanetField *f, Planet *const *planets, int count) {
+    for (int r = 0; r < f->rows; ++r) {
+        float y = f->origin_y + (float)r * f->cell;
+        for (int c = 0; c < f->cols; ++c) {
+            float x = f->origin_x + (float)c * f->cell;
+            float ax = 0.f, ay = 0.f, dist = 1e30f;
+            for (int i = 0; i < count; ++i) {
+                const Planet *pl = planets[i];
+                float dx = pl->e.pos.x - x;
+                float dy = pl->e.pos.y - y;
+                float dist2 = dx * dx + dy * dy;
+                float d = sqrtf(dist2);
+                if (d - pl->radius < dist)
+                    dist = d - pl->radius;
+                if (dist2 < PROJ_EPSILON)
+                    continue;
+                float inv_dist = 1.0f / d;
+                float accel = (pl->mass * PROJ_GRAVITY_CONST) * inv_dist * inv_dist;
+                ax += accel * dx * inv_dist;
+                ay += accel * dy * inv_dist;
+            }
+            size_t n = (size_t)r * f->cols + c;
+            f->accel[n * 2] = ax;
+            f->accel[n * 2 + 1] = ay;
+            f->sdf[n] = dist;
+        }
+    }
+}
+
+/* Cell range covered by a circle's bounding box */
+static void field_cell_range(const PlanetField *f, float x, float y, float radius, int *c0, int *r0, int *c1, int *r1) {
+    *c0 = field_clamp_cell((x - radius - f->borigin_x) * f->binv_cell, f->bcols);
+    *c1 = field_clamp_cell((x + radius - f->borigin_x) * f->binv_cell, f->bcols);
+    *r0 = field_clamp_cell((y - radius - f->borigin_y) * f->binv_cell, f->brows);
+    *r1 = field_clamp_cell((y + radius - f->borigin_y) * f->binv_cell, f->brows);
+}
+
+static void field_compute_broadphase(PlanetField *f, Planet *const *planets, int count) {
+    int c0, r0, c1, r1;
+    for (int i = 0; i < count; ++i) {
+        field_cell_range(f, planets[i]->e.pos.x, planets[i]->e.pos.y, planets[i]->radius, &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; ++r)
+            for (int c = c0; c <= c1; ++c)
+                f->cell_start[r * f->bcols + c + 1]++;
+    }
+    int cells = f->bcols * f->brows;
+    for (int i = 0; i < cells; ++i)
+        f->cell_start[i + 1] += f->cell_start[i];
+    /* Fill: start[cell] walks to the end of its cell, then everything shifts back by one */
+    for (int i = 0; i < count; ++i) {
+        field_cell_range(f, planets[i]->e.pos.x, planets[i]->e.pos.y, planets[i]->radius, &c0, &r0, &c1, &r1);
+        for (int r = r0; r <= r1; ++r)
+            for (int c = c0; c <= c1; ++c)
+                f->cell_planets[f->cell_start[r * f->bcols + c]++] = (uint16_t)i;
+    }
+    for (int i = cells; i > 0; --i)
+        f->cell_start[i] = f->cell_start[i - 1];
+    f->cell_start[0] = 0;
+}
+
+static uint32_t field_broadphase_entries(int cols, int rows, float ox, float oy, float cell, Planet *const *planets, int count) {
+    PlanetField probe = {0};
+    probe.bcols = cols;
+    probe.brows = rows;
+    probe.borigin_x = ox;
+    probe.borigin_y = oy;
+    probe.binv_cell = 1.f / cell;
+    uint32_t entries = 0;
+    for (int i = 0; i < count; ++i) {
+        int c0, r0, c1, r1;
+        field_cell_range(&probe, planets[i]->e.pos.x, planets[i]->e.pos.y, planets[i]->radius, &c0, &r0, &c1, &r1);
+        entries += (uint32_t)((c1 - c0 + 1) * (r1 - r0 + 1));
+    }
+    return entries;
+}
+
+/* Header and payload of a baked section, if it is current and intact */
+static const uint8_t *field_section(const GameLevel *lvl, uint32_t id, uint32_t planets_crc, const LevelBakedHeader **hdr,
+                                    uint32_t *payload_size) {
+    uint32_t size = 0;
+    const uint8_t *data = (const uint8_t *)level_section(lvl, id, &size);
+    if (!data || size < sizeof(LevelBakedHeader))
+        return NULL;
+    const LevelBakedHeader *h = (const LevelBakedHeader *)data;
+    if (h->version != PLANET_FIELD_VERSION || h->header_size != sizeof(LevelBakedHeader) || h->planets_crc != planets_crc)
+        return NULL;
+    if (h->cols < 2 || h->rows < 2 || (size_t)h->cols * h->rows > FIELD_MAX_NODES || !(h->cell > 0.f))
+        return NULL;
+    if (h->gravity_const != PROJ_GRAVITY_CONST || h->epsilon != PROJ_EPSILON || h->mass_factor != (float)PLANET_MASS_FACTOR) {
+        LOG_INFO("planet_field", "Baked section %u was computed with other physics constants", (unsigned)id);
+        return NULL;
+    }
+    const uint8_t *payload = data + sizeof(LevelBakedHeader);
+    *payload_size = size - (uint32_t)sizeof(LevelBakedHeader);
+    /* packed files were checked by the VFS already */
+    if (!lvl->file.packed && vfs_crc32(0, payload, *payload_size) != h->crc) {
+        LOG_WARN("planet_field", "Baked section %u has a bad checksum", (unsigned)id);
+        return NULL;
+    }
+    *hdr = h;
+    return payload;
+}
+
+static bool field_from_level(PlanetField *f, const GameLevel *lvl, int count) {
+    uint32_t planets_size = 0;
+    const void *planets_data = level_section(lvl, LEVEL_SECTION_PLANETS, &planets_size);
+    if (!planets_data || lvl->planets_count != (uint32_t)count)
+        return false;
+    uint32_t planets_crc = vfs_crc32(0, planets_data, planets_size);
+
+    const LevelBakedHeader *gh, *sh, *bh;
+    uint32_t gsize, ssize, bsize;
+    const uint8_t *gravity = field_section(lvl, LEVEL_SECTION_GRAVITY, planets_crc, &gh, &gsize);
+    const uint8_t *sdf = field_section(lvl, LEVEL_SECTION_SDF, planets_crc, &sh, &ssize);
+    const uint8_t *broad = field_section(lvl, LEVEL_SECTION_BROADPHASE, planets_crc, &bh, &bsize);
+    if (!gravity || !sdf || !broad)
+        return false;
+    size_t nodes = (size_t)gh->cols * gh->rows;
+    if (gsize != nodes * 2 * sizeof(float) || ssize != nodes * sizeof(float) || sh->cols != gh->cols ||
+        sh->rows != gh->rows || sh->origin_x != gh->origin_x || sh->origin_y != gh->origin_y || sh->cell != gh->cell)
+        return false;
+    size_t cells = (size_t)bh->cols * bh->rows;
+    if (bsize < (cells + 1) * sizeof(uint32_t))
+        return false;
+    const uint32_t *start = (const uint32_t *)broad;
+    uint32_t entries = start[cells];
+    if (bsize != (cells + 1) * sizeof(uint32_t) + (size_t)entries * sizeof(uint16_t) || start[0] != 0)
+        return false;
+    const uint16_t *list = (const uint16_t *)(broad + (cells + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < cells; ++i)
+        if (start[i] > start[i + 1])
+            return false;
+    for (uint32_t i = 0; i < entries; ++i)
+        if (list[i] >= count)
+            return false;
+
+    if (!field_alloc(f, gh->cols, gh->rows, bh->cols, bh->rows, entries, count))
+        return false;
+    memcpy(f->accel, gravity, gsize);
+    memcpy(f->sdf, sdf, ssize);
+    memcpy(f->cell_start, start, (cells + 1) * sizeof(uint32_t));
+    memcpy(f->cell_planets, list, (size_t)entries * sizeof(uint16_t));
+    f->origin_x = gh->origin_x;
+    f->origin_y = gh->origin_y;
+    f->cell = gh->cell;
+    f->borigin_x = bh->origin_x;
+    f->borigin_y = bh->origin_y;
+    f->binv_cell = 1.f / bh->cell;
+    f->baked = true;
+    return true;
+}
+
+bool planet_field_build(PlanetField *f, struct Planet *const *planets, int count, const GameLevel *lvl) {
+    if (!f)
+        return false;
+    planet_field_free(f);
+    if (!planets || count <= 0 || count > UINT16_MAX)
+        return false;
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    if (!lvl || !field_from_level(f, lvl, count)) {
+        float margin_x = PLANET_FIELD_MARGIN * (float)DISPLAY_W;
+        float margin_y = PLANET_FIELD_MARGIN * (float)DISPLAY_H;
+        float ox = -margin_x, oy = -margin_y;
+        float span_x = (float)DISPLAY_W + 2.f * margin_x, span_y = (float)DISPLAY_H + 2.f * margin_y;
+        int cols = (int)ceilf(span_x / PLANET_FIELD_CELL) + 1;
+        int rows = (int)ceilf(span_y / PLANET_FIELD_CELL) + 1;
+        int bcols = (int)ceilf(span_x / PLANET_FIELD_BROAD_CELL);
+        int brows = (int)ceilf(span_y / PLANET_FIELD_BROAD_CELL);
+        uint32_t entries = field_broadphase_entries(bcols, brows, ox, oy, PLANET_FIELD_BROAD_CELL, planets, count);
+        if (!field_alloc(f, cols, rows, bcols, brows, entries, count)) {
+            LOG_ERROR("planet_field", "Failed to allocate planet field");
+            return false;
+        }
+        f->origin_x = f->borigin_x = ox;
+        f->origin_y = f->borigin_y = oy;
+        f->cell = PLANET_FIELD_CELL;
+        f->binv_cell = 1.f / PLANET_FIELD_BROAD_CELL;
+        field_compute_grids(f, planets, count);
+        field_compute_broadphase(f, planets, count);
+    }
+    f->inv_cell = 1.f / f->cell;
+    /* bilinear distance is off by at most the cell diagonal; stay clear of that */
+    f->near = fmaxf(PLANET_FIELD_NEAR, f->cell * 1.5f);
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    LOG_DEBUG("planet_field", "%s %dx%d field for %d planets in %.2f ms", f->baked ? "Loaded baked" : "Computed", f->cols,
+              f->rows, count, ms);
+    return true;
+}
+
+bool planet_field_accel(const PlanetField *f, float x, float y, Vec2 *out) {
+    if (!f || !f->accel)
+        return false;
+    float fx = (x - f->origin_x) * f->inv_cell;
+    float fy = (y - f->origin_y) * f->inv_cell;
+    if (!(fx >= 0.f && fy >= 0.f && fx < (float)(f->cols - 1) && fy < (float)(f->rows - 1)))
+        return false;
+    int c = (int)fx, r = (int)fy;
+    float tx = fx - (float)c, ty = fy - (float)r;
+    size_t i = (size_t)r * f->cols + c;
+    size_t j = i + f->cols;
+    const float *s = f->sdf;
+    float top = s[i] + (s[i + 1] - s[i]) * tx;
+    float bottom = s[j] + (s[j + 1] - s[j]) * tx;
+    if (top + (bottom - top) * ty < f->near)
+        return false;
+    const float *a = f->accel;
+    float ax0 = a[i * 2] + (a[i * 2 + 2] - a[i * 2]) * tx;
+    float ax1 = a[j * 2] + (a[j * 2 + 2] - a[j * 2]) * tx;
+    float ay0 = a[i * 2 + 1] + (a[i * 2 + 3] - a[i * 2 + 1]) * tx;
+    float ay1 = a[j * 2 + 1] + (a[j * 2 + 3] - a[j * 2 + 1]) * tx;
+    out->x = ax0 + (ax1 - ax0) * ty;
+    out->y = ay0 + (ay1 - ay0) * ty;
+    return true;
+}
+
+int planet_field_query(PlanetField *f, float x, float y, float radius, uint16_t *out, int max) {
+    if (!f || !f->cell_start)
+        return -1;
+    if (++f->stamp_gen == 0) {
+        memset(f->stamp, 0, (size_t)f->planet_count * sizeof(uint32_t));
+        f->stamp_gen = 1;
+    }
+    int c0, r0, c1, r1, n = 0;
+    field_cell_range(f, x, y, radius, &c0, &r0, &c1, &r1);
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            int cell = r * f->bcols + c;
+            for (uint32_t k = f->cell_start[cell]; k < f->cell_start[cell + 1]; ++k) {
+                uint16_t p = f->cell_planets[k];
+                if (f->stamp[p] == f->stamp_gen)
+                    continue;
+                if (n == max)
+                    return -1;
+                f->stamp[p] = f->stamp_gen;
+                out[n++] = p;
+            }
+        }
+    }
+    return n;
+}
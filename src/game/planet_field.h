@@ -0,0 +1,82 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../core/types.h"
+#include "level_loader.h"
+
+struct Planet;
+
+/* Bump whenever the meaning of the baked sections changes so old level files are recomputed */
+#define PLANET_FIELD_VERSION 2
+
+/* Everything derived from the static planets of a level.
+ *
+ * - gravity: acceleration of all planets sampled on a grid over the display
+ *   plus PLANET_FIELD_MARGIN, read back with bilinear filtering
+ * - sdf: distance to the nearest planet surface on the same grid. Closer than
+ *   'near' the inverse-square field is too steep for the grid, so callers fall
+ *   back to the exact per-planet sum (which also handles planet hits)
+ * - broadphase: coarse cells listing the planets that overlap them, so the
+ *   collision pass only tests planets next to an entity
+ *
+ * Levels compiled with --bake carry all three (LEVEL_SECTION_GRAVITY/SDF/
+ * BROADPHASE); otherwise they are computed when the planets are known.
+ */
+typedef struct PlanetField {
+    int cols, rows;           // gravity/sdf nodes
+    float origin_x, origin_y; // position of node (0,0)
+    float cell, inv_cell;
+    float near;               // sdf below which planet_field_accel declines
+    float *accel;             // rows*cols*2
+    float *sdf;               // rows*cols
+    int bcols, brows;         // broadphase cells
+    float borigin_x, borigin_y;
+    float binv_cell;
+    uint32_t *cell_start;     // bcols*brows+1 offsets into cell_planets
+    uint16_t *cell_planets;
+    int planet_count;
+    uint32_t *stamp;          // per planet, deduplicates planet_field_query results
+    uint32_t stamp_gen;
+    void *block;              // single allocation behind the arrays above
+    bool baked;               // taken from the level file
+} PlanetField;
+
+/**
+ * @brief Build the field for a set of planets
+ * @param f Field (previous contents are released)
+ * @param planets Planets, in level order
+ * @param count Planet count
+ * @param lvl Level the planets came from; its baked sections are used when valid (may be NULL)
+ * @return true on success; on failure the field is empty and callers use the exact paths
+ */
+bool planet_field_build(PlanetField *f, struct Planet *const *planets, int count, const GameLevel *lvl);
+
+/**
+ * @brief Release the field
+ * @param f Field (reset to empty)
+ */
+void planet_field_free(PlanetField *f);
+
+/**
+ * @brief Sampled planet gravity at a point
+ * @param f Field
+ * @param x Point X
+ * @param y Point Y
+ * @param out Acceleration in px/s^2
+ * @return false if the point is near a planet, outside the grid or there is no
+ *         field; sum the planets exactly in that case
+ */
+bool planet_field_accel(const PlanetField *f, float x, float y, Vec2 *out);
+
+/**
+ * @brief Planets whose broadphase cells overlap a circle's bounding box
+ * @param f Field
+ * @param x Center X
+ * @param y Center Y
+ * @param radius Circle radius
+ * @param out Receives planet indices, each at most once
+ * @param max Capacity of out
+ * @return Number of indices written, or -1 if there is no broadphase (test every planet)
+ */
+int planet_field_query(PlanetField *f, float x, float y, float radius, uint16_t *out, int max);
@@ -36,20 +36,7 @@ static void player_trigger_death_effect(Player *p)
         return;
     if (!p->world)
         return;
-    Services *svc = services_get();
-    if (!svc || !svc->texman)
-        return;
-    int types = texman_explosion_type_count(svc->texman);
-    int type = 0;
-    if (types > 0)
-    {
-        if (types >= 3)
-            type = 2;
-        else
-            type = types - 1;
-    }
-    float scale = 1.4f;
-    world_add_explosion(p->world, type, p->e.pos.x, p->e.pos.y, scale);
+    effects_emit_kill(&p->world->effects, 2, p->e.pos.x, p->e.pos.y, 1.4f);
     p->death_explosion_triggered = true;
 }
 
@@ -63,7 +50,7 @@ static void player_render(Entity *e, struct Renderer *r)
 
     };
     float angle_deg = (p->e.angle + p->e.angle_offset) * (180.0f / PI_F);
-    renderer_draw_texture(r, p->e.texture, NULL, &dst, angle_deg);
+    renderer_draw_texture(r, p->e.texture, (p->e.sprite ? &p->e.sprite->src : NULL), &dst, angle_deg);
 }
 static void player_update(Entity *e, float dt)
 {
@@ -258,26 +245,13 @@ static void player_on_hit_entity(Entity *e, Entity *hitter)
         player_apply_damage(p, dmg);
         if (pr)
             pr->active = false; // deactivate projectile only on valid hit
-        /* Add a small explosion effect for player hits. Use explosion type 1
-         * if available; fall back to 0 if the texture manager provides fewer
-         * types. Position at the projectile hit while player still alive,
-         * otherwise at the player's position. Scale mirrors enemy logic. */
+        /* Small blue impact at the projectile hit while the player is
+         * still alive (death has its own effect). */
         if (p->world && p->alive)
         {
-            Services *svc = services_get();
-            if (svc && svc->texman)
-            {
-                int types = texman_explosion_type_count(svc->texman);
-                int type = 1;
-                if (types <= 1)
-                    type = 0;
-                else if (type >= types)
-                    type = type % types;
-                float x = hitter ? hitter->pos.x : p->e.pos.x;
-                float y = hitter ? hitter->pos.y : p->e.pos.y;
-                float scale = 0.5f;
-                world_add_explosion(p->world, type, x, y, scale);
-            }
+            float x = hitter ? hitter->pos.x : p->e.pos.x;
+            float y = hitter ? hitter->pos.y : p->e.pos.y;
+            effects_emit_impact(&p->world->effects, 1, x, y);
         }
     }
 }
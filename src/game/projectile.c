@@ -6,10 +6,12 @@
 #include "../services/renderer.h"
 #include "../core/types.h"
 #include "planet.h"
+#include "planet_field.h"
 #include "../services/texture_manager.h"
 #include "player.h"
 #include "enemy.h"
 #include "../core/log.h"
+#include "../services/quality.h"
 
 static Entity *projectile_create_entity(void *params) {
 
@@ -45,7 +47,8 @@ static void trail_add_point(Trail *t, Vec2 p) {
 }
 static void trail_render(const Trail *t, Uint8 base_r, Uint8 base_g, Uint8 base_b, struct Renderer *r) {
     // Mehrere Segmente für Krümmung + Farbverlauf, aber nur eine Linie pro Segment (niedrige Draw Calls)
-    int n = t->length;
+    const QualityTier *q = quality_current();
+    int n = t->length < q->trail_len ? t->length : q->trail_len;
     if (n <= 1)
         return;
     int headIdx = (t->head - 1 + TRAIL_LEN) % TRAIL_LEN;
@@ -72,8 +75,7 @@ static void trail_render(const Trail *t, Uint8 base_r, Uint8 base_g, Uint8 base_
         float dy = b.y - a.y;
         float len2 = dx * dx + dy * dy;
         if (len2 < 0.0001f) {
-            SDL_SetRenderDrawColor(r->sdl, rcol, gcol, bcol, alpha);
-            SDL_RenderDrawPointF(r->sdl, a.x, a.y);
+            renderer_draw_line(r, a.x, a.y, a.x, a.y, (SDL_Color){rcol, gcol, bcol, alpha});
             continue;
         }
         float inv_len = 1.f / sqrtf(len2);
@@ -83,20 +85,21 @@ static void trail_render(const Trail *t, Uint8 base_r, Uint8 base_g, Uint8 base_
         // Erzeuge Offsets in ganzen Pixeln bis zur gewünschten Halbbreite
         float hw = t->core_half_width;
         int max_off = (int)floorf(hw + 0.01f);
+        if (max_off > q->trail_half_width)
+            max_off = q->trail_half_width;
         if (max_off < 0)
             max_off = 0;
-        SDL_SetRenderDrawColor(r->sdl, rcol, gcol, bcol, alpha);
         // Center Linie
-        SDL_RenderDrawLineF(r->sdl, a.x, a.y, b.x, b.y);
+        renderer_draw_line(r, a.x, a.y, b.x, b.y, (SDL_Color){rcol, gcol, bcol, alpha});
         // Symmetrische Offsets
         for (int o = 1; o <= max_off; ++o) {
             float ox = nx * (float)o;
             float oy = ny * (float)o;
             // leicht geringere Alpha für äußere Linien
             Uint8 oa = (Uint8)(alpha * (1.0f - (float)o / (float)(max_off + 1)));
-            SDL_SetRenderDrawColor(r->sdl, rcol, gcol, bcol, oa);
-            SDL_RenderDrawLineF(r->sdl, a.x + ox, a.y + oy, b.x + ox, b.y + oy);
-            SDL_RenderDrawLineF(r->sdl, a.x - ox, a.y - oy, b.x - ox, b.y - oy);
+            SDL_Color oc = {rcol, gcol, bcol, oa};
+            renderer_draw_line(r, a.x + ox, a.y + oy, b.x + ox, b.y + oy, oc);
+            renderer_draw_line(r, a.x - ox, a.y - oy, b.x - ox, b.y - oy, oc);
         }
     }
 }
@@ -108,18 +111,13 @@ static void projectile_render_entity(Entity *e, struct Renderer *r) {
     Projectile *p = (Projectile *)e;
     if (!p->active)
         return;
+    RenderLayer prev_layer = renderer_set_layer(r, RENDER_LAYER_TRAILS);
     trail_render(&p->trail, p->color_r, p->color_g, p->color_b, r);
+    renderer_set_layer(r, prev_layer);
     float sz = p->e.size.x > 0 ? p->e.size.x : 8.f;
     SDL_FRect dst = {p->e.pos.x - sz * 0.5f, p->e.pos.y - sz * 0.5f, sz, sz};
-    if (p->e.texture) {
-        /* Assume projectile texture is full sheet; fetch src rect via variant */
-        Services *services = services_get();
-        struct TextureManager *texman = services ? services->texman : NULL;
-        SDL_Rect src = {0,0,0,0};
-        if (texman)
-            src = texman_projectile_src(texman, p->variant);
-        renderer_draw_texture(r, p->e.texture, (src.w?&src:NULL), &dst, 0);
-    }
+    if (p->e.texture)
+        renderer_draw_texture(r, p->e.texture, (p->e.sprite ? &p->e.sprite->src : NULL), &dst, 0);
 }
 static void projectile_on_hit_entity(Entity *e, Entity *hitter) {
     (void)hitter;
@@ -131,12 +129,17 @@ static const EntityVTable PROJECTILE_VT = {projectile_create_entity, projectile_
 
 Projectile *projectile_create(Entity *owner, Vec2 pos, Vec2 vel, SDL_Texture *tex, int damage, Uint8 cr, Uint8 cg, Uint8 cb) {
 
-    Projectile *p = calloc(1, sizeof(Projectile));
+    Projectile *p = malloc(sizeof(Projectile));
     if (!p) {
         LOG_ERROR("projectile", "Failed to allocate projectile");
         return NULL;
 
 }
+    projectile_init(p, owner, pos, vel, tex, damage, cr, cg, cb);
+    return p;
+}
+void projectile_init(Projectile *p, Entity *owner, Vec2 pos, Vec2 vel, SDL_Texture *tex, int damage, Uint8 cr, Uint8 cg, Uint8 cb) {
+    memset(p, 0, sizeof(*p));
     p->e.vt = &PROJECTILE_VT;
     p->e.pos = pos;
     p->e.vel = vel;
@@ -160,7 +163,6 @@ Projectile *projectile_create(Entity *owner, Vec2 pos, Vec2 vel, SDL_Texture *te
     p->e.collider.poly_count = 0;
     p->e.collider.shape = COLLIDER_SHAPE_CIRCLE;
     p->e.is_dynamic = false; // do not push others
-    return p;
 }
 void projectile_destroy(Projectile *p) {
     free(p);
@@ -207,10 +209,17 @@ void projectile_update(Projectile *p, const ProjectileUpdateCtx *ctx) {
         return;
     p->flight_time += ctx->dt;
     // Apply gravity from planets only (collision handled by generic system after integration)
-    for (int i = 0; i < ctx->planet_count && p->active; ++i){
-        struct Planet *pl = ctx->planets[i];
-        if (!pl) continue;
-        projectile_apply_gravity_from_planet(p, pl, ctx->dt);
+    Vec2 accel;
+    if (planet_field_accel(ctx->field, p->e.pos.x, p->e.pos.y, &accel)) {
+        // Away from planets the sampled field stands in for the per-planet sum
+        p->e.vel.x += accel.x * ctx->dt;
+        p->e.vel.y += accel.y * ctx->dt;
+    } else {
+        for (int i = 0; i < ctx->planet_count && p->active; ++i){
+            struct Planet *pl = ctx->planets[i];
+            if (!pl) continue;
+            projectile_apply_gravity_from_planet(p, pl, ctx->dt);
+        }
     }
     if (!p->active)
         return;
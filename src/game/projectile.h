@@ -25,13 +25,16 @@ typedef struct Projectile {
     Trail  trail;           // optischer Trail
 } Projectile;
 Projectile *projectile_create(Entity *owner, Vec2 pos, Vec2 vel, SDL_Texture *tex, int damage, Uint8 cr, Uint8 cg, Uint8 cb);
+// Reset a projectile in place (recycled storage); same result as projectile_create
+void projectile_init(Projectile *p, Entity *owner, Vec2 pos, Vec2 vel, SDL_Texture *tex, int damage, Uint8 cr, Uint8 cg, Uint8 cb);
 void projectile_destroy(Projectile *p);
 void projectile_update_trail(Projectile *p);
 
 // Context for per-projectile update (gravity from planets, collisions, bounds)
-struct Planet; struct Player; struct Enemy;
+struct Planet; struct Player; struct Enemy; struct PlanetField;
 typedef struct ProjectileUpdateCtx {
     struct Planet **planets; int planet_count;
+    const struct PlanetField *field; // sampled gravity away from planets (may be NULL)
     struct Player *player;
     struct Enemy **enemies; int enemy_count;
     float min_x, max_x, min_y, max_y; // out-of-bounds rectangle
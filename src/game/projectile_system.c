@@ -6,6 +6,7 @@
 #include "player.h"
 #include "enemy.h"
 #include "weapon.h"
+#include "../core/log.h"
 
 void projectile_system_init(ProjectileSystem *ps, TextureManager *tm) {
 
@@ -16,11 +17,33 @@ void projectile_system_init(ProjectileSystem *ps, TextureManager *tm) {
         ps->texman = tm;
     }
 }
+static int grow_capacity(int capacity, int min_capacity, int initial) {
+    int n = capacity > 0 ? capacity : initial;
+    while (n < min_capacity)
+        n *= 2;
+    return n;
+}
+static bool reserve_spare(ProjectileSystem *ps, int min_capacity) {
+    if (ps->spare_capacity >= min_capacity)
+        return true;
+    int cap = grow_capacity(ps->spare_capacity, min_capacity, 32);
+    Projectile **arr = realloc(ps->spare, sizeof(*arr) * (size_t)cap);
+    if (!arr)
+        return false;
+    ps->spare = arr;
+    ps->spare_capacity = cap;
+    return true;
+}
+/* Retired projectiles go back to the spare list instead of the allocator */
 static void destroy_projectile(ProjectileSystem *ps, Projectile *p) {
     if (!p)
         return;
-    (void)ps; /* textures now always resident; no release */
-    projectile_destroy(p);
+    /* sprites live in the pinned atlas; nothing to release */
+    if (!reserve_spare(ps, ps->spare_count + 1)) {
+        projectile_destroy(p);
+        return;
+    }
+    ps->spare[ps->spare_count++] = p;
 }
 void projectile_system_shutdown(ProjectileSystem *ps) {
     if (!ps)
@@ -28,12 +51,36 @@ void projectile_system_shutdown(ProjectileSystem *ps) {
     for (int s = 0; s < ps->shooter_count; s++) {
         ShooterPool *pool = &ps->shooters[s];
         for (int i = 0; i < pool->head; i++) {
-            destroy_projectile(ps, pool->items[i]);
+            projectile_destroy(pool->items[i]);
 }
-        pool->head = 0;
-    pool->occupied = 0;
-    pool->pending_unregister = 0;
+        free(pool->items);
     }
+    for (int i = 0; i < ps->spare_count; i++)
+        projectile_destroy(ps->spare[i]);
+    free(ps->spare);
+    free(ps->shooters);
+    ps->shooters = NULL;
+    ps->shooter_count = 0;
+    ps->shooter_capacity = 0;
+    ps->spare = NULL;
+    ps->spare_count = 0;
+    ps->spare_capacity = 0;
+}
+bool projectile_system_reserve(ProjectileSystem *ps, int shooters) {
+    if (!ps)
+        return false;
+    if (ps->shooter_capacity >= shooters)
+        return true;
+    int cap = grow_capacity(ps->shooter_capacity, shooters, WORLD_INITIAL_ENEMIES + 1);
+    ShooterPool *arr = realloc(ps->shooters, sizeof(*arr) * (size_t)cap);
+    if (!arr) {
+        LOG_ERROR("projectile", "Failed to grow shooter pools to %d", cap);
+        return false;
+    }
+    memset(arr + ps->shooter_capacity, 0, sizeof(*arr) * (size_t)(cap - ps->shooter_capacity));
+    ps->shooters = arr;
+    ps->shooter_capacity = cap;
+    return true;
 }
 int projectile_system_register_shooter(ProjectileSystem *ps) {
     if (!ps)
@@ -47,7 +94,7 @@ int projectile_system_register_shooter(ProjectileSystem *ps) {
             return i;
 }
     }
-    if (ps->shooter_count >= MAX_SHOOTERS)
+    if (!projectile_system_reserve(ps, ps->shooter_count + 1))
         return -1;
     int idx = ps->shooter_count++;
     ps->shooters[idx].occupied = 1;
@@ -84,6 +131,16 @@ bool projectile_system_fire(ProjectileSystem *ps, float world_time, int shooter_
     // cooldown handled externally by weapon system; only capacity check here
     if (pool->head >= MAX_PROJECTILES_PER_SHOOTER)
         return false;
+    if (pool->head >= pool->capacity) {
+        int cap = grow_capacity(pool->capacity, pool->head + 1, PROJ_POOL_INITIAL);
+        if (cap > MAX_PROJECTILES_PER_SHOOTER)
+            cap = MAX_PROJECTILES_PER_SHOOTER;
+        Projectile **items = realloc(pool->items, sizeof(*items) * (size_t)cap);
+        if (!items)
+            return false;
+        pool->items = items;
+        pool->capacity = cap;
+    }
     Vec2 dir = {cosf(angle), sinf(angle)
 };
     if (strength <= 0.f)
@@ -105,31 +162,25 @@ bool projectile_system_fire(ProjectileSystem *ps, float world_time, int shooter_
             variant = en->weapon->projectile_variant;
     }
     }
-    /* Clamp variant */
-    int maxv = texman_projectile_variant_count(ps->texman);
-    if (maxv > 0) {
-        if (variant < 0)
-            variant = 0;
-        if (variant >= maxv)
-            variant = maxv - 1;
+    /* Sprite & colour come from the prebuilt style table (variant clamped there) */
+    const ProjectileStyle *style = texman_projectile_style(ps->texman, variant);
+    Projectile *p;
+    if (ps->spare_count > 0) {
+        p = ps->spare[--ps->spare_count];
+        projectile_init(p, owner, owner->pos, vel, style->sprite->tex, damage, style->r, style->g, style->b);
+    } else {
+        p = projectile_create(owner, owner->pos, vel, style->sprite->tex, damage, style->r, style->g, style->b);
+        if (!p)
+            return false;
     }
-    /* Texture & color */
-    SDL_Texture *sheet = texman_projectiles_texture(ps->texman);
-    SDL_Rect src = texman_projectile_src(ps->texman, variant);
-    Uint8 cr = 255, cg = 255, cb = 255;
-    texman_projectile_variant_color(ps->texman, variant, &cr, &cg, &cb);
-    SDL_Texture *proj_tex = sheet; /* store sheet; projectile render can choose src rect */
-    Projectile *p = projectile_create(owner, owner->pos, vel, proj_tex, damage, cr, cg, cb);
-    if (p)
-        p->variant = variant;
-    if (!p)
-        return false;
+    p->e.sprite = style->sprite;
+    p->variant = variant;
     pool->items[pool->head++] = p;
     pool->last_fire_time = world_time; // keep timestamp for possible future logic (e.g., muzzle flash)
     return true;
 }
 // physics subsystem removed: gravity handled in projectile.c via planet masses
-void projectile_system_update(ProjectileSystem *ps, struct Planet **planets, int planet_count, struct Player *player, struct Enemy **enemies, int enemy_count, float oob_margin_factor, int display_w, int display_h, float dt, float world_time) {
+void projectile_system_update(ProjectileSystem *ps, struct Planet **planets, int planet_count, const struct PlanetField *field, struct Player *player, struct Enemy **enemies, int enemy_count, float oob_margin_factor, int display_w, int display_h, float dt, float world_time) {
     if (!ps)
         return;
     float margin_x = oob_margin_factor * (float)display_w;
@@ -138,6 +189,7 @@ void projectile_system_update(ProjectileSystem *ps, struct Planet **planets, int
     memset(&ctx, 0, sizeof(ctx));
     ctx.planets = planets;
     ctx.planet_count = planet_count;
+    ctx.field = field;
     ctx.player = player;
     ctx.enemies = enemies;
     ctx.enemy_count = enemy_count;
@@ -5,25 +5,32 @@
 #include "../services/renderer.h"
 
 typedef struct ShooterPool {
-    struct Projectile *items[MAX_PROJECTILES_PER_SHOOTER];
+    struct Projectile **items; // in flight; grows up to MAX_PROJECTILES_PER_SHOOTER
     int head;
+    int capacity;
     float last_fire_time;
     int occupied; // 0 = free slot, 1 = in use
     int pending_unregister; // 1 = waiting to be freed when head reaches 0
 } ShooterPool;
 
 typedef struct ProjectileSystem {
-    ShooterPool shooters[MAX_SHOOTERS];
+    ShooterPool *shooters; // grows with registrations; levels reserve one per enemy up front
     int shooter_count;
+    int shooter_capacity;
+    struct Projectile **spare; // retired projectiles, reused by the next shot
+    int spare_count;
+    int spare_capacity;
     TextureManager *texman; // for tinted projectile textures
 } ProjectileSystem;
 
 void projectile_system_init(ProjectileSystem *ps, TextureManager *tm);
 void projectile_system_shutdown(ProjectileSystem *ps);
+/* Make room for this many shooters so registering them later does not reallocate */
+bool projectile_system_reserve(ProjectileSystem *ps, int shooters);
 int projectile_system_register_shooter(ProjectileSystem *ps);
 void projectile_system_unregister_shooter(ProjectileSystem *ps, int shooter_index);
 bool projectile_system_fire(ProjectileSystem *ps, float world_time, int shooter_index, Entity *owner, float angle, float strength);
 struct Player;
 struct Enemy; // forward
-void projectile_system_update(ProjectileSystem *ps, struct Planet **planets, int planet_count, struct Player *player, struct Enemy **enemies, int enemy_count, float oob_margin_factor, int display_w, int display_h, float dt, float world_time);
+void projectile_system_update(ProjectileSystem *ps, struct Planet **planets, int planet_count, const struct PlanetField *field, struct Player *player, struct Enemy **enemies, int enemy_count, float oob_margin_factor, int display_w, int display_h, float dt, float world_time);
 void projectile_system_render(ProjectileSystem *ps, Renderer *r);
@@ -0,0 +1,241 @@
+#include "spawn_schedule.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../core/log.h"
+
+typedef struct SpawnId {
+    uint32_t id;
+    uint32_t entry;
+} SpawnId;
+
+static int spawn_id_cmp(const void *a, const void *b) {
+    const SpawnId *x = (const SpawnId *)a;
+    const SpawnId *y = (const SpawnId *)b;
+    if (x->id != y->id)
+        return x->id < y->id ? -1 : 1;
+    return x->entry < y->entry ? -1 : (x->entry > y->entry);
+}
+
+/* First entry carrying this id (the old scan matched the first one too) */
+static uint32_t spawn_find_id(const SpawnId *ids, uint32_t n, uint32_t id) {
+    uint32_t lo = 0, hi = n;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (ids[mid].id < id)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return (lo < n && ids[lo].id == id) ? ids[lo].entry : UINT32_MAX;
+}
+
+/* Equal times pop in entry order, like the level's spawn table */
+static bool timer_before(const SpawnTimer *a, const SpawnTimer *b) {
+    if (a->time != b->time)
+        return a->time < b->time;
+    return a->entry < b->entry;
+}
+
+static bool queue_push(SpawnSchedule *s, float time, uint32_t entry) {
+    if (s->queue_count >= s->queue_capacity) {
+        uint32_t cap = s->queue_capacity ? s->queue_capacity * 2 : 16;
+        SpawnTimer *q = realloc(s->queue, sizeof(*q) * cap);
+        if (!q) {
+            LOG_ERROR("spawn", "Failed to queue spawn of entry %u", (unsigned)entry);
+            return false;
+        }
+        s->queue = q;
+        s->queue_capacity = cap;
+    }
+    SpawnTimer t = {time, entry};
+    uint32_t i = s->queue_count++;
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (!timer_before(&t, &s->queue[parent]))
+            break;
+        s->queue[i] = s->queue[parent];
+        i = parent;
+    }
+    s->queue[i] = t;
+    s->entries[entry].scheduled_time = time;
+    return true;
+}
+
+static SpawnTimer queue_pop(SpawnSchedule *s) {
+    SpawnTimer top = s->queue[0];
+    SpawnTimer last = s->queue[--s->queue_count];
+    if (s->queue_count == 0)
+        return top;
+    uint32_t i = 0;
+    for (;;) {
+        uint32_t c = 2 * i + 1;
+        if (c >= s->queue_count)
+            break;
+        if (c + 1 < s->queue_count && timer_before(&s->queue[c + 1], &s->queue[c]))
+            c++;
+        if (!timer_before(&s->queue[c], &last))
+            break;
+        s->queue[i] = s->queue[c];
+        i = c;
+    }
+    s->queue[i] = last;
+    return top;
+}
+
+static bool spawn_entry(SpawnSchedule *s, World *w, uint32_t idx) {
+    SpawnEntry *se = &s->entries[idx];
+    const LevelEnemy *le = &se->template;
+    EnemyHandle h = world_spawn_enemy(w, (int)le->type, le->pos_x, le->pos_y, le->difficulty, le->health);
+    if (h == ENEMY_HANDLE_NONE)
+        return false;
+    se->spawned = 1;
+    se->handle = h;
+    se->scheduled_time = -1.0f;
+    s->spawned_count++;
+    // only entries something waits for need to be found again from a death
+    if (s->sub_start[idx + 1] == s->sub_start[idx])
+        return true;
+    int slot = ENEMY_HANDLE_SLOT(h);
+    if (slot >= s->slot_entry_capacity) {
+        int cap = w->enemy_slot_capacity > slot ? w->enemy_slot_capacity : slot + 1;
+        uint32_t *arr = realloc(s->slot_entry, sizeof(*arr) * (size_t)cap);
+        if (!arr) {
+            LOG_ERROR("spawn", "Lost on_death followers of enemy id=%u", (unsigned)le->id);
+            return true;
+        }
+        memset(arr + s->slot_entry_capacity, 0, sizeof(*arr) * (size_t)(cap - s->slot_entry_capacity));
+        s->slot_entry = arr;
+        s->slot_entry_capacity = cap;
+    }
+    s->slot_entry[slot] = idx + 1;
+    return true;
+}
+
+bool spawn_schedule_init(SpawnSchedule *s, const GameLevel *lvl, World *w) {
+    memset(s, 0, sizeof(*s));
+    if (!lvl || !w || lvl->enemies_count == 0)
+        return true;
+    uint32_t n = lvl->enemies_count;
+    s->entries = calloc(n, sizeof(*s->entries));
+    s->sub_start = calloc((size_t)n + 1, sizeof(*s->sub_start));
+    SpawnId *ids = malloc(sizeof(*ids) * n);
+    uint32_t *targets = malloc(sizeof(*targets) * n);
+    if (!s->entries || !s->sub_start || !ids || !targets) {
+        free(ids);
+        free(targets);
+        spawn_schedule_free(s);
+        return false;
+    }
+    s->count = n;
+    for (uint32_t i = 0; i < n; ++i) {
+        SpawnEntry *se = &s->entries[i];
+        se->template = lvl->enemies[i];
+        se->handle = ENEMY_HANDLE_NONE;
+        se->scheduled_time = -1.0f;
+        ids[i] = (SpawnId){se->template.id, i};
+    }
+
+    // subscription table: on_death entries grouped by the entry they wait for
+    qsort(ids, n, sizeof(*ids), spawn_id_cmp);
+    uint32_t sub_count = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const LevelEnemy *le = &s->entries[i].template;
+        targets[i] = UINT32_MAX;
+        if (le->spawn_kind != 1 || le->spawn_arg == 0)
+            continue;
+        targets[i] = spawn_find_id(ids, n, le->spawn_arg);
+        if (targets[i] == UINT32_MAX) {
+            LOG_WARN("spawn", "on_death target id=%u of id=%u not found", (unsigned)le->spawn_arg, (unsigned)le->id);
+            continue;
+        }
+        s->sub_start[targets[i] + 1]++;
+        sub_count++;
+    }
+    for (uint32_t i = 0; i < n; ++i)
+        s->sub_start[i + 1] += s->sub_start[i];
+    if (sub_count) {
+        s->subs = malloc(sizeof(*s->subs) * sub_count);
+        if (!s->subs) {
+            free(ids);
+            free(targets);
+            spawn_schedule_free(s);
+            return false;
+        }
+        // ids is done with; reuse it as per-target fill cursors
+        for (uint32_t i = 0; i < n; ++i)
+            ids[i].entry = s->sub_start[i];
+        for (uint32_t i = 0; i < n; ++i) {
+            if (targets[i] != UINT32_MAX)
+                s->subs[ids[targets[i]].entry++] = i;
+        }
+    }
+    free(ids);
+    free(targets);
+
+    w->track_enemy_deaths = true;
+    // on_start spawns: queue the delayed ones, spawn the rest now (retried next tick on failure)
+    for (uint32_t i = 0; i < n; ++i) {
+        const LevelEnemy *le = &s->entries[i].template;
+        if (le->spawn_kind != 0)
+            continue;
+        if (le->spawn_delay > 0)
+            queue_push(s, w->time + (float)le->spawn_delay, i);
+        else if (!spawn_entry(s, w, i))
+            queue_push(s, w->time, i);
+    }
+    return true;
+}
+
+void spawn_schedule_update(SpawnSchedule *s, World *w) {
+    if (!s || !w || !s->count)
+        return;
+    /* Deaths only queue their followers (delay 0 = due now): the handle slots
+     * of every reported death are resolved before anything spawns and may
+     * reuse one of them. */
+    const EnemyHandle *dead = NULL;
+    int dead_count = world_take_enemy_deaths(w, &dead);
+    for (int i = 0; i < dead_count; ++i) {
+        int slot = ENEMY_HANDLE_SLOT(dead[i]);
+        if (slot < 0 || slot >= s->slot_entry_capacity || !s->slot_entry[slot])
+            continue;
+        uint32_t target = s->slot_entry[slot] - 1;
+        if (s->entries[target].handle != dead[i])
+            continue;
+        s->slot_entry[slot] = 0;
+        for (uint32_t k = s->sub_start[target]; k < s->sub_start[target + 1]; ++k) {
+            uint32_t idx = s->subs[k];
+            SpawnEntry *se = &s->entries[idx];
+            if (se->spawned || se->scheduled_time >= 0.0f)
+                continue;
+            queue_push(s, w->time + (float)se->template.spawn_delay, idx);
+        }
+    }
+
+    // due timers: delayed on_start spawns, on_death followers, retries
+    while (s->queue_count > 0 && s->queue[0].time <= w->time) {
+        SpawnTimer t = queue_pop(s);
+        s->entries[t.entry].scheduled_time = -1.0f;
+        if (s->entries[t.entry].spawned)
+            continue;
+        if (!spawn_entry(s, w, t.entry)) {
+            LOG_WARN("spawn", "Spawn of id=%u failed, retrying next tick", (unsigned)s->entries[t.entry].template.id);
+            queue_push(s, t.time, t.entry);
+            break;
+        }
+    }
+}
+
+bool spawn_schedule_done(const SpawnSchedule *s) {
+    return s && s->spawned_count >= s->count;
+}
+
+void spawn_schedule_free(SpawnSchedule *s) {
+    if (!s)
+        return;
+    free(s->entries);
+    free(s->queue);
+    free(s->sub_start);
+    free(s->subs);
+    free(s->slot_entry);
+    memset(s, 0, sizeof(*s));
+}
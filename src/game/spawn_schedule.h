@@ -0,0 +1,61 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "level_loader.h"
+#include "world.h"
+
+/* Enemy spawns of a level, driven by events instead of per-tick scans.
+ *
+ * Delayed spawns wait in a min-heap on their due time; on_death spawns are
+ * listed under the entry they wait for (subscription table built once at
+ * load) and fire when the world reports that entry's enemy as removed. A tick
+ * with no due timer and no death costs one heap peek.
+ */
+typedef struct SpawnEntry {
+    LevelEnemy template;
+    int spawned;          // boolean
+    EnemyHandle handle;   // enemy spawned from this entry, ENEMY_HANDLE_NONE before
+    float scheduled_time; // queued for this world time (-1 = not queued)
+} SpawnEntry;
+
+typedef struct SpawnTimer {
+    float time;
+    uint32_t entry;
+} SpawnTimer;
+
+typedef struct SpawnSchedule {
+    SpawnEntry *entries;
+    uint32_t count;
+    uint32_t spawned_count;
+    SpawnTimer *queue;      // min-heap on (time, entry)
+    uint32_t queue_count;
+    uint32_t queue_capacity;
+    uint32_t *sub_start;    // count + 1 offsets into subs
+    uint32_t *subs;         // on_death entries, grouped by the entry they wait for
+    uint32_t *slot_entry;   // world enemy handle slot -> entry + 1 (0 = none)
+    int slot_entry_capacity;
+} SpawnSchedule;
+
+/**
+ * @brief Build the schedule for a level and spawn its immediate on_start enemies
+ * @param s Schedule to fill
+ * @param lvl Loaded level
+ * @param w World to spawn into; death tracking is switched on
+ * @return false when out of memory
+ */
+bool spawn_schedule_init(SpawnSchedule *s, const GameLevel *lvl, World *w);
+
+/**
+ * @brief Spawn due timers and on_death followers of enemies removed since the last call
+ * @param s Schedule
+ * @param w World
+ */
+void spawn_schedule_update(SpawnSchedule *s, World *w);
+
+/**
+ * @brief Every entry has spawned
+ */
+bool spawn_schedule_done(const SpawnSchedule *s);
+
+void spawn_schedule_free(SpawnSchedule *s);
@@ -0,0 +1,71 @@
+#include "trajectory.h"
+#include <math.h>
+#include "planet.h"
+#include "planet_field.h"
+
+TrajectoryState trajectory_step(const TrajectoryEnv *env, Vec2 *pos, Vec2 *vel, float dt) {
+    /* gravity from planets; the sampled field is only valid clear of every
+     * planet, so no hit test is needed on that path */
+    Vec2 field_accel;
+    if (planet_field_accel(env->field, pos->x, pos->y, &field_accel)) {
+        vel->x += field_accel.x * dt;
+        vel->y += field_accel.y * dt;
+    } else {
+        for (int i = 0; i < env->planet_count; ++i) {
+            const struct Planet *pl = env->planets[i];
+            if (!pl)
+                continue;
+            float dx = pl->e.pos.x - pos->x;
+            float dy = pl->e.pos.y - pos->y;
+            float dist2 = dx * dx + dy * dy;
+            /* extremely close singularity guard */
+            if (dist2 < PROJ_EPSILON)
+                return TRAJECTORY_LOST;
+            /* projectile destroyed by planet */
+            if (dist2 <= pl->radius_sq)
+                return TRAJECTORY_HIT_PLANET;
+
+            /* apply gravity (inverse-square) */
+            float inv_dist = 1.0f / sqrtf(dist2);
+            float inv_dist2 = inv_dist * inv_dist;
+            float accel = (pl->mass * PROJ_GRAVITY_CONST) * inv_dist2;
+            vel->x += accel * dx * inv_dist * dt;
+            vel->y += accel * dy * inv_dist * dt;
+        }
+    }
+
+    /* integrate */
+    pos->x += vel->x * dt;
+    pos->y += vel->y * dt;
+
+    /* real projectiles are deactivated outside the bounds */
+    if (pos->x < env->min_x || pos->x > env->max_x || pos->y < env->min_y || pos->y > env->max_y)
+        return TRAJECTORY_LOST;
+    return TRAJECTORY_FLYING;
+}
+
+float trajectory_min_dist(const TrajectoryEnv *env, Vec2 origin, Vec2 target, float angle, float strength, float hit_radius) {
+    if (!env)
+        return 1e9f;
+    Vec2 pos = origin;
+    Vec2 vel = (Vec2){cosf(angle) * strength, sinf(angle) * strength};
+    /* Work in squared distances to avoid sqrt inside the loop */
+    float min_dist2 = 1e30f;
+    float hit_r2 = hit_radius * hit_radius;
+
+    for (float t = 0.f; t < SIM_MAX_PROJECTILE_TIME; t += FIXED_DT) {
+        TrajectoryState state = trajectory_step(env, &pos, &vel, FIXED_DT);
+        if (state == TRAJECTORY_LOST)
+            return 1e9f;
+
+        /* distance^2 to target; a planet hit still counts the point of impact */
+        float pdx = pos.x - target.x;
+        float pdy = pos.y - target.y;
+        float pd2 = pdx * pdx + pdy * pdy;
+        if (pd2 < min_dist2)
+            min_dist2 = pd2;
+        if (state == TRAJECTORY_HIT_PLANET || min_dist2 <= hit_r2)
+            return sqrtf(min_dist2);
+    }
+    return sqrtf(min_dist2);
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <stdbool.h>
+
+#include "../core/types.h"
+
+struct Planet;
+struct PlanetField;
+
+/* Fixed-step projectile flight under planet gravity, without a World.
+ *
+ * This is the simulation the enemy shot search evaluates its candidates with;
+ * the offline level analyzer (--analyze-levels) runs the same code so its
+ * numbers match what enemies can actually hit in game.
+ */
+typedef struct TrajectoryEnv {
+    struct Planet *const *planets;
+    int planet_count;
+    const struct PlanetField *field; // sampled gravity away from planets (may be NULL)
+    float min_x, min_y, max_x, max_y; // projectiles outside are gone (world_get_proj_oob_bounds)
+} TrajectoryEnv;
+
+typedef enum TrajectoryState {
+    TRAJECTORY_FLYING = 0,
+    TRAJECTORY_HIT_PLANET, // pos is the point of impact (not advanced)
+    TRAJECTORY_LOST        // left the bounds or hit a planet center
+} TrajectoryState;
+
+/**
+ * @brief Advance a projectile by one step: gravity, planet hits, integration and bounds
+ * @param env Planets and bounds
+ * @param pos Position, advanced unless a planet was hit
+ * @param vel Velocity
+ * @param dt Step in seconds
+ * @return State after the step
+ */
+TrajectoryState trajectory_step(const TrajectoryEnv *env, Vec2 *pos, Vec2 *vel, float dt);
+
+/**
+ * @brief Closest approach of a shot to a target
+ *
+ * Simulates at FIXED_DT for up to SIM_MAX_PROJECTILE_TIME seconds and stops
+ * early once the shot comes within hit_radius, hits a planet or is lost.
+ *
+ * @param env Planets and bounds
+ * @param origin Muzzle position
+ * @param target Target position
+ * @param angle Launch angle in radians
+ * @param strength Launch speed in px/s
+ * @param hit_radius Distance that counts as a hit
+ * @return Minimum distance to target, 1e9 if the shot is lost
+ */
+float trajectory_min_dist(const TrajectoryEnv *env, Vec2 origin, Vec2 target, float angle, float strength, float hit_radius);
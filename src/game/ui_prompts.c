@@ -6,14 +6,13 @@
 #include "../services/services.h"
 #include "../services/texture_manager.h"
 
-static float ui_prompt_icon_width(SDL_Texture *tex, float target_height) {
+static float ui_prompt_icon_width(const Sprite *sprite, float target_height) {
 
-    if (!tex || target_height <= 0.f)
+    if (!sprite || !sprite->tex || target_height <= 0.f)
         return 0.f;
-    int w = 0, h = 0;
-    if (SDL_QueryTexture(tex, NULL, NULL, &w, &h) != 0 || h <= 0)
+    if (sprite->src.h <= 0)
         return target_height;
-    return target_height * ((float)w / (float)h);
+    return target_height * ((float)sprite->src.w / (float)sprite->src.h);
 
 }
 
@@ -33,13 +32,13 @@ void ui_draw_prompts(struct Renderer *r, struct Services *svc, bool show_ok, boo
     if (!show_ok && !show_back)
         return;
 
-    SDL_Texture *tex_ok = NULL;
-    SDL_Texture *tex_back = NULL;
+    const Sprite *spr_ok = NULL;
+    const Sprite *spr_back = NULL;
     if (svc->texman) {
         if (show_ok)
-            tex_ok = texman_get(svc->texman, TEX_UI_BUTTON_CROSS);
+            spr_ok = texman_sprite(svc->texman, SPR_BUTTON_CROSS);
         if (show_back)
-            tex_back = texman_get(svc->texman, TEX_UI_BUTTON_CIRCLE);
+            spr_back = texman_sprite(svc->texman, SPR_BUTTON_CIRCLE);
     }
 
     const char *ok_label = "Ok";
@@ -58,8 +57,8 @@ void ui_draw_prompts(struct Renderer *r, struct Services *svc, bool show_ok, boo
     if (show_back)
         back_size.x += 5;
 
-    float ok_icon_width = show_ok ? ui_prompt_icon_width(tex_ok, icon_height) : 0.f;
-    float back_icon_width = show_back ? ui_prompt_icon_width(tex_back, icon_height) : 0.f;
+    float ok_icon_width = show_ok ? ui_prompt_icon_width(spr_ok, icon_height) : 0.f;
+    float back_icon_width = show_back ? ui_prompt_icon_width(spr_back, icon_height) : 0.f;
 
     float ok_block_width = 0.f;
     if (show_ok) {
@@ -100,9 +99,9 @@ void ui_draw_prompts(struct Renderer *r, struct Services *svc, bool show_ok, boo
     float y = (float)svc->display_h - padding - icon_height;
     float current_x = start_x;
 
-    if (show_ok && ok_icon_width > 0.f && tex_ok) {
+    if (show_ok && ok_icon_width > 0.f) {
         SDL_FRect icon_rect = {current_x, y, ok_icon_width, icon_height};
-        renderer_draw_texture(r, tex_ok, NULL, &icon_rect, 0.f);
+        renderer_draw_texture(r, spr_ok->tex, &spr_ok->src, &icon_rect, 0.f);
         current_x += ok_icon_width + icon_text_spacing;
     }
     if (show_ok) {
@@ -113,9 +112,9 @@ void ui_draw_prompts(struct Renderer *r, struct Services *svc, bool show_ok, boo
     if (show_back) {
 
         current_x = show_ok ? (start_x + ok_block_width + prompt_spacing) : start_x;
-        if (back_icon_width > 0.f && tex_back) {
+        if (back_icon_width > 0.f) {
             SDL_FRect icon_rect = {current_x, y, back_icon_width, icon_height};
-            renderer_draw_texture(r, tex_back, NULL, &icon_rect, 0.f);
+            renderer_draw_texture(r, spr_back->tex, &spr_back->src, &icon_rect, 0.f);
             current_x += back_icon_width + icon_text_spacing;
         }
         float back_text_y = ui_prompt_text_y(y + 2, icon_height, back_size);
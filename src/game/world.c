@@ -6,13 +6,14 @@
 #include "enemy.h"
 #include "planet.h"
 #include "projectile.h"
-#include "explosion.h"
 #include "hud.h"
 #include "collision.h"
+#include "level_background.h"
 #include "../services/renderer.h"
 #include "../services/texture_manager.h"
 #include "../services/services.h"
 #include "../services/audio.h"
+#include "../services/quality.h"
 #include "../core/rand.h"
 #include "../core/log.h"
 #include <stdio.h>
@@ -96,10 +97,12 @@ World *world_create(struct Services *svc, u32 seed)
     w->svc = svc;
     w->seed = seed;
     w->proj_oob_margin_factor = 0.2f; // default as requested
+    w->enemy_free_slot = -1;
     projectile_system_init(&w->projsys, svc->texman);
-    w->explosion_count = 0;
+    effects_init(&w->effects, svc->texman, seed);
 
     rng_seed(&w->rng, seed);
+    w->background = level_background_create(svc->display_w, svc->display_h);
 
     /* Note: planet and player placement moved to explicit helper functions
      * so scenes can control when and how worlds are populated. */
@@ -162,7 +165,7 @@ void world_populate_planets(World *w, unsigned int max_planet_area_percent, floa
             if (w->planet_count > 0)
             {
                 Planet *np = w->planets[w->planet_count - 1];
-                np->src = texman_sheet_src(w->svc->texman, TEX_PLANETS_SHEET, type);
+                np->src = texman_sprite(w->svc->texman, SPR_PLANET_FIRST + type)->src;
             }
             planets_area += mass;
             placed++;
@@ -190,7 +193,7 @@ void world_populate_planets(World *w, unsigned int max_planet_area_percent, floa
             if (w->planet_count > 0)
             {
                 Planet *np = w->planets[w->planet_count - 1];
-                np->src = texman_sheet_src(w->svc->texman, TEX_PLANETS_SHEET, type);
+                np->src = texman_sprite(w->svc->texman, SPR_PLANET_FIRST + type)->src;
             }
             planets_area += mass;
             sum_radii += radius;
@@ -223,7 +226,6 @@ void world_destroy(World *w)
 {
     if (!w)
         return;
-    /* Destroy explosions (if we add storage later) */
     projectile_system_shutdown(&w->projsys);
     {
         for (int i = 0; i < w->planet_count; i++)
@@ -231,19 +233,58 @@ void world_destroy(World *w)
                 planet_destroy(w->planets[i]);
         free(w->planets);
     }
+    for (int i = 0; i < w->enemy_count; i++)
+        if (w->enemies[i])
+            enemy_destroy(w->enemies[i]);
+    free(w->enemies);
+    free(w->enemy_slots);
+    free(w->enemy_deaths);
+    free(w->collision_list);
+    free(w->collision_pairs);
     if (w->player)
         player_destroy(w->player);
-    for (int i = 0; i < w->explosion_count; i++)
-        if (w->explosions[i])
-            explosion_destroy(w->explosions[i]);
     if (w->hud)
         hud_destroy(w->hud);
+    level_background_destroy(w->background);
+    planet_field_free(&w->field);
     free(w);
 }
+/* Retire the enemy's handle and report its death */
+static void world_release_enemy(World *w, Enemy *en)
+{
+    int slot = ENEMY_HANDLE_SLOT(en->handle);
+    if (slot < 0 || slot >= w->enemy_slot_count || w->enemy_slots[slot].enemy != en)
+        return;
+    EnemySlot *es = &w->enemy_slots[slot];
+    es->enemy = NULL;
+    es->gen = (uint16_t)(es->gen + 1);
+    if (es->gen == 0)
+        es->gen = 1;
+    es->next_free = w->enemy_free_slot;
+    w->enemy_free_slot = slot;
+    if (!w->track_enemy_deaths)
+        return;
+    if (w->enemy_death_count >= w->enemy_death_capacity)
+    {
+        int cap = w->enemy_death_capacity > 0 ? w->enemy_death_capacity * 2 : WORLD_INITIAL_ENEMIES;
+        EnemyHandle *arr = realloc(w->enemy_deaths, sizeof(*arr) * (size_t)cap);
+        if (!arr)
+        {
+            LOG_ERROR("world", "Dropped death event of enemy %08x", (unsigned)en->handle);
+            return;
+        }
+        w->enemy_deaths = arr;
+        w->enemy_death_capacity = cap;
+    }
+    w->enemy_deaths[w->enemy_death_count++] = en->handle;
+}
+
 void world_update(World *w, float dt)
 {
     if (!w)
         return;
+    if (w->field_dirty)
+        world_build_planet_field(w, NULL);
     w->time += dt;
     // Time limit check
     if (w->time_limit >= 0.f && !w->time_over_triggered)
@@ -262,17 +303,28 @@ void world_update(World *w, float dt)
     if (w->player && w->player->e.vt && w->player->e.vt->update)
         w->player->e.vt->update((Entity *)w->player, dt);
 
+    // Shot searches are budgeted per tick: with many enemies they take turns
+    {
+        int demand = w->enemy_count * (quality_current()->ai_samples + 1);
+        w->ai_stride = (demand + WORLD_AI_SAMPLES_PER_TICK - 1) / WORLD_AI_SAMPLES_PER_TICK;
+        if (w->ai_stride < 1)
+            w->ai_stride = 1;
+        w->ticks++;
+    }
+
     // Enemies update & deferred removal compaction
     for (int i = 0; i < w->enemy_count; ++i)
     {
         Enemy *en = w->enemies[i];
         if (!en)
             continue;
+        w->ai_search_turn = (int)((w->ticks + (u32)i) % (u32)w->ai_stride) == 0;
         if (!en->alive && en->e.vt && en->e.vt->destroy)
         {
             // unregister shooter before destroying enemy so projectile_system can reuse the slot
             if (en->shooter_index >= 0)
                 projectile_system_unregister_shooter(&w->projsys, en->shooter_index);
+            world_release_enemy(w, en);
             en->e.vt->destroy((Entity *)en);
             w->enemies[i] = NULL; // mark for removal
             continue;
@@ -290,9 +342,9 @@ void world_update(World *w, float dt)
                 continue;
             w->enemies[write++] = en;
         }
-        w->enemy_count = write;
-        for (int i = write; i < MAX_ENEMIES; ++i)
+        for (int i = write; i < w->enemy_count; ++i)
             w->enemies[i] = NULL;
+        w->enemy_count = write;
     }
     /* NOTE: enemy spawning is now the responsibility of the active scene.
      * World no longer performs automatic spawning so scenes can fully
@@ -306,32 +358,20 @@ void world_update(World *w, float dt)
             pl->e.vt->update((Entity *)pl, dt);
     }
 
-    // Explosions aktualisieren und ggfs. entfernen
-    int write = 0;
-    for (int i = 0; i < w->explosion_count; i++)
-    {
-        Explosion *ex = w->explosions[i];
-        if (!ex)
-            continue;
-        if (ex->e.vt && ex->e.vt->update)
-            ex->e.vt->update((Entity *)ex, dt);
-        if (ex->active)
-            w->explosions[write++] = ex;
-        else
-            explosion_destroy(ex);
-    }
-    w->explosion_count = write;
+    effects_update(&w->effects, dt);
     // gravity sources added once at planet creation; no per-frame rebuild
-    projectile_system_update(&w->projsys, w->planets, w->planet_count, w->player, w->enemies, w->enemy_count, w->proj_oob_margin_factor, w->svc->display_w, w->svc->display_h, dt, w->time);
+    projectile_system_update(&w->projsys, w->planets, w->planet_count, &w->field, w->player, w->enemies, w->enemy_count, w->proj_oob_margin_factor, w->svc->display_w, w->svc->display_h, dt, w->time);
     // Run generic collision system (Phase1: player/enemy/planet)
     collision_run(w, dt);
     if (w->hud)
         hud_update(w->hud, w, dt);
 }
-static void world_render_entities(World *w, struct Renderer *r)
+static void world_render_entities(World *w, struct Renderer *r, bool skip_planets)
 {
-    // Planets
-    for (int i = 0; i < w->planet_count; i++)
+    RenderLayer prev_layer = renderer_set_layer(r, RENDER_LAYER_PLANETS);
+
+    // Planets (skipped when already composited into the background layer)
+    for (int i = 0; i < w->planet_count && !skip_planets; i++)
     {
         Planet *p = w->planets[i];
         if (!p)
@@ -341,9 +381,11 @@ static void world_render_entities(World *w, struct Renderer *r)
     }
 
     // Projectiles
+    renderer_set_layer(r, RENDER_LAYER_PROJECTILES);
     projectile_system_render(&w->projsys, r);
 
     // Player
+    renderer_set_layer(r, RENDER_LAYER_SHIPS);
     if (w->player && w->player->e.vt && w->player->e.vt->render)
         w->player->e.vt->render((Entity *)w->player, r);
 
@@ -357,50 +399,131 @@ static void world_render_entities(World *w, struct Renderer *r)
             en->e.vt->render((Entity *)en, r);
     }
 
-    // Explosions
-    for (int i = 0; i < w->explosion_count; i++)
-    {
-        Explosion *ex = w->explosions[i];
-        if (!ex)
-            continue;
-        if (ex->e.vt && ex->e.vt->render)
-            ex->e.vt->render((Entity *)ex, r);
-    }
+    // Explosions + debris
+    renderer_set_layer(r, RENDER_LAYER_EFFECTS);
+    effects_render(&w->effects, r);
+    renderer_set_layer(r, prev_layer);
+}
+void world_render_background(World *w, struct Renderer *r)
+{
+    if (!w || !w->svc)
+        return;
+    SDL_Texture *nebula = texman_get(w->svc->texman, TEX_BG_STARFIELD);
+    RenderLayer prev_layer = renderer_set_layer(r, RENDER_LAYER_BACKGROUND);
+    w->planets_in_background = level_background_render(w->background, r, nebula, w->planets, w->planet_count);
+    renderer_set_layer(r, prev_layer);
 }
 void world_render(World *w, struct Renderer *r)
 {
     if (!w)
         return;
-    world_render_entities(w, r);
+    bool planets_baked = w->planets_in_background;
+    w->planets_in_background = false;
+    world_render_entities(w, r, planets_baked);
+    RenderLayer prev_layer = renderer_set_layer(r, RENDER_LAYER_HUD);
     if (w->hud)
         hud_render(w->hud, r);
 // optional collider debug draw (compile-time)
 #ifdef DEBUG_COLLISION
     collision_debug_draw(w, r);
 #endif
+    renderer_set_layer(r, prev_layer);
+}
+void world_capture(World *w, struct Renderer *capture)
+{
+    if (!w || !capture)
+        return;
+    /* Planets are always recorded; the replay drops them if the background layer holds them */
+    world_render_entities(w, capture, false);
+    RenderLayer prev_layer = renderer_set_layer(capture, RENDER_LAYER_HUD);
+    if (w->hud)
+        hud_render(w->hud, capture);
+    renderer_set_layer(capture, prev_layer);
+}
+static int world_grow_capacity(int capacity, int min_capacity, int initial)
+{
+    int n = capacity > 0 ? capacity : initial;
+    while (n < min_capacity)
+        n *= 2;
+    return n;
+}
+
+bool world_reserve(World *w, int planets, int enemies)
+{
+    if (!w)
+        return false;
+    if (planets > w->planet_capacity)
+    {
+        int cap = world_grow_capacity(w->planet_capacity, planets, WORLD_INITIAL_PLANETS);
+        Planet **arr = realloc(w->planets, sizeof(*arr) * (size_t)cap);
+        if (!arr)
+        {
+            LOG_ERROR("world", "Failed to grow planets array to %d", cap);
+            return false;
+        }
+        w->planets = arr;
+        w->planet_capacity = cap;
+    }
+    if (enemies > w->enemy_capacity)
+    {
+        int cap = world_grow_capacity(w->enemy_capacity, enemies, WORLD_INITIAL_ENEMIES);
+        Enemy **arr = realloc(w->enemies, sizeof(*arr) * (size_t)cap);
+        if (!arr)
+        {
+            LOG_ERROR("world", "Failed to grow enemies array to %d", cap);
+            return false;
+        }
+        w->enemies = arr;
+        w->enemy_capacity = cap;
+    }
+    if (enemies > w->enemy_slot_capacity)
+    {
+        int cap = world_grow_capacity(w->enemy_slot_capacity, enemies, WORLD_INITIAL_ENEMIES);
+        if (cap > 0xFFFF)
+            cap = 0xFFFF; // slot + 1 has to fit the handle's low 16 bits
+        if (cap < enemies)
+            return false;
+        EnemySlot *arr = realloc(w->enemy_slots, sizeof(*arr) * (size_t)cap);
+        if (!arr)
+        {
+            LOG_ERROR("world", "Failed to grow enemy handle table to %d", cap);
+            return false;
+        }
+        w->enemy_slots = arr;
+        w->enemy_slot_capacity = cap;
+    }
+    // one shooter per enemy plus the player
+    return projectile_system_reserve(&w->projsys, enemies + 1);
 }
+
 bool world_add_planet(World *w, float x, float y, float radius, uint8_t type)
 {
     if (!w)
         return false;
-    float mass = M_PI * radius * radius;
+    float mass = PLANET_MASS_FACTOR * radius * radius;
     SDL_Texture *tex = texman_get(w->svc->texman, TEX_PLANETS_SHEET);
-    SDL_Rect src = texman_sheet_src(w->svc->texman, TEX_PLANETS_SHEET, type);
+    SDL_Rect src = texman_sprite(w->svc->texman, SPR_PLANET_FIRST + type)->src;
     Planet *p = planet_create(x, y, radius, mass, tex, src);
     if (!p)
         return false;
     p->world = w; /* back-reference for spawning effects */
-    Planet **new_arr = realloc(w->planets, sizeof(Planet *) * (w->planet_count + 1));
-    if (!new_arr)
+    if (!world_reserve(w, w->planet_count + 1, 0))
     {
-        LOG_ERROR("world", "Failed to reallocate planets array");
         planet_destroy(p);
         return false;
     }
-    w->planets = new_arr;
     w->planets[w->planet_count++] = p;
+    level_background_invalidate(w->background);
+    w->field_dirty = true;
     return true;
 }
+void world_build_planet_field(World *w, const GameLevel *lvl)
+{
+    if (!w)
+        return;
+    planet_field_build(&w->field, w->planets, w->planet_count, lvl);
+    w->field_dirty = false;
+}
 bool world_add_player(World *w, float x, float y)
 {
     SDL_Texture *tex = texman_get(w->svc->texman, TEX_PLAYER);
@@ -411,6 +534,7 @@ bool world_add_player(World *w, float x, float y)
     w->player = player_create(tex);
     if (!w->player)
         return false;
+    w->player->e.sprite = texman_sprite(w->svc->texman, SPR_PLAYER);
     w->player->e.pos.x = x;
     w->player->e.pos.y = y;
     int si = world_register_shooter(w);
@@ -419,26 +543,60 @@ bool world_add_player(World *w, float x, float y)
     return true;
 }
 
-bool world_spawn_enemy(World *w, int kind, float x, float y, uint8_t difficulty, uint32_t health)
+EnemyHandle world_spawn_enemy(World *w, int kind, float x, float y, uint8_t difficulty, uint32_t health)
 {
 
     if (!w)
-        return false;
-    if (w->enemy_count >= MAX_ENEMIES)
-        return false;
+        return ENEMY_HANDLE_NONE;
+    // live enemies and used handle slots match, so this also makes room for the handle
+    if (!world_reserve(w, 0, w->enemy_count + 1))
+        return ENEMY_HANDLE_NONE;
     int shooter_index = world_register_shooter(w);
-    float angle = 0.0f;
     Enemy *en = enemy_create(w, (EnemyType)kind, x, y, shooter_index, difficulty);
     if (!en)
-        return false;
+        return ENEMY_HANDLE_NONE;
     if (health > 0)
     {
         if (health > (uint32_t)INT16_MAX)
             health = (uint32_t)INT16_MAX;
         en->health = (int16_t)health;
     }
+    int slot = w->enemy_free_slot;
+    if (slot >= 0)
+    {
+        w->enemy_free_slot = w->enemy_slots[slot].next_free;
+    }
+    else
+    {
+        slot = w->enemy_slot_count++;
+        w->enemy_slots[slot].gen = 1;
+    }
+    w->enemy_slots[slot].enemy = en;
+    w->enemy_slots[slot].next_free = -1;
+    en->handle = ((EnemyHandle)w->enemy_slots[slot].gen << 16) | (EnemyHandle)(slot + 1);
     w->enemies[w->enemy_count++] = en;
-    return true;
+    return en->handle;
+}
+struct Enemy *world_get_enemy(World *w, EnemyHandle h)
+{
+    if (!w)
+        return NULL;
+    int slot = ENEMY_HANDLE_SLOT(h);
+    if (slot < 0 || slot >= w->enemy_slot_count)
+        return NULL;
+    const EnemySlot *es = &w->enemy_slots[slot];
+    if (!es->enemy || es->gen != (uint16_t)(h >> 16))
+        return NULL;
+    return es->enemy;
+}
+int world_take_enemy_deaths(World *w, const EnemyHandle **out)
+{
+    if (!w || !out)
+        return 0;
+    *out = w->enemy_deaths;
+    int n = w->enemy_death_count;
+    w->enemy_death_count = 0;
+    return n;
 }
 int world_register_shooter(World *w)
 {
@@ -457,18 +615,6 @@ bool world_fire_projectile(World *w, int shooter_index, Entity *owner, float ang
     }
     return fired;
 }
-bool world_add_explosion(World *w, int type, float x, float y, float scale)
-{
-    if (!w)
-        return false;
-    if (w->explosion_count >= MAX_EXPLOSIONS)
-        return false;
-    Explosion *ex = explosion_create(type, x, y, scale);
-    if (!ex)
-        return false;
-    w->explosions[w->explosion_count++] = ex;
-    return true;
-}
 void world_set_time_limit(World *w, float seconds)
 {
     if (!w)
@@ -5,25 +5,61 @@
 #include "../core/rand.h"
 
 #include "projectile_system.h"
+#include "effects.h"
+#include "planet_field.h"
+
+/* Generational enemy handle: low 16 bits are the slot + 1, high 16 bits the
+ * slot's generation. Once its enemy is removed a handle never resolves again;
+ * 0 is never a valid handle. */
+typedef uint32_t EnemyHandle;
+#define ENEMY_HANDLE_NONE 0u
+#define ENEMY_HANDLE_SLOT(h) ((int)((h) & 0xFFFFu) - 1)
+
+typedef struct EnemySlot {
+    struct Enemy *enemy; // NULL while free
+    uint16_t gen;
+    int next_free;       // free list link, -1 = end
+} EnemySlot;
 
 typedef struct World {
     struct Services *svc;
     struct Rng rng;
     u32 seed;
     struct Player *player;
-    struct Enemy *enemies[MAX_ENEMIES];
+    struct Enemy **enemies;
     int enemy_count;
+    int enemy_capacity;
+    EnemySlot *enemy_slots; // handle table
+    int enemy_slot_count;
+    int enemy_slot_capacity;
+    int enemy_free_slot;    // -1 = none
+    bool track_enemy_deaths;  // collect removed enemies for world_take_enemy_deaths
+    EnemyHandle *enemy_deaths;
+    int enemy_death_count;
+    int enemy_death_capacity;
     struct Planet **planets;
     int planet_count;
+    int planet_capacity;
+    Entity **collision_list; // collision_run scratch, grows with the entity count
+    int collision_capacity;
+    struct Pair *collision_pairs; // hits/contacts found by collision_run, resolved after detection
+    int collision_pair_count;
+    int collision_pair_capacity;
+    int ai_stride;       // enemies run their shot search every ai_stride ticks (budget)
+    bool ai_search_turn; // set by world_update for the enemy being updated
+    u32 ticks;
     ProjectileSystem projsys;
-    struct Explosion *explosions[MAX_EXPLOSIONS];
-    int explosion_count;
+    EffectPool effects; // explosions + debris
     int score, kills;
     bool active;
     bool paused;
     float proj_oob_margin_factor; // fraction of display size as extra margin (e.g. 0.2f)
     float time; // accumulated world time
     struct Hud *hud; // UI overlay owned by world
+    struct LevelBackground *background; // baked nebula + planets layer
+    bool planets_in_background; // set per frame by world_render_background
+    PlanetField field; // gravity/distance grids and planet broadphase
+    bool field_dirty;  // planets changed; rebuilt before the next update
     // Time limit handling
     float time_limit; // seconds; -1 = infinite
     int   time_over_triggered; // guard so callback fires once
@@ -49,13 +85,27 @@ World *world_create(struct Services *svc, u32 seed);
 void world_destroy(World *w);
 void world_update(World *w, float dt);
 void world_render(World *w, struct Renderer *r);
+/* Draw the static level layer (nebula + planets). Scenes call this before world_render. */
+void world_render_background(World *w, struct Renderer *r);
+/* Record entities + HUD into a capture renderer (see renderer_init_capture); no SDL calls. */
+void world_capture(World *w, struct Renderer *capture);
 
+/* Size planet, enemy and shooter storage for a level up front (never shrinks) */
+bool world_reserve(World *w, int planets, int enemies);
 bool world_add_planet(World *w, float x, float y, float radius, uint8_t type);
+/* Build the planet field now, from the level's baked sections when they match (lvl may be NULL).
+ * Otherwise it is computed on the first update after planets were added. */
+void world_build_planet_field(World *w, const GameLevel *lvl);
 bool world_add_player(World *w, float x, float y);
-bool world_spawn_enemy(World *w, int kind, float x, float y, uint8_t difficulty, uint32_t health);
+/* Returns the new enemy's handle, ENEMY_HANDLE_NONE on failure */
+EnemyHandle world_spawn_enemy(World *w, int kind, float x, float y, uint8_t difficulty, uint32_t health);
+/* Resolve a handle; NULL once the enemy has been removed */
+struct Enemy *world_get_enemy(World *w, EnemyHandle h);
+/* Enemies removed since the last call (needs track_enemy_deaths). The array
+ * stays valid until the next world_update. */
+int world_take_enemy_deaths(World *w, const EnemyHandle **out);
 int world_register_shooter(World *w);
 bool world_fire_projectile(World *w, int shooter_index, Entity *owner, float angle, float strength);
-bool world_add_explosion(World *w, int type, float x, float y, float scale);
 void world_set_time_limit(World *w, float seconds); // -1 for infinite
 
 /* Helper for external code (scenes) to find free placement for spawns. */
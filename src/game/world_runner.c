@@ -0,0 +1,173 @@
+#include "world_runner.h"
+#include <stdlib.h>
+#include "world.h"
+#include "../core/types.h"
+#include "../core/log.h"
+
+#define WORLD_RUNNER_REPORT_SECONDS 5
+
+static void world_runner_capture(WorldRunner *wr, int slot) {
+    RenderSnapshot *snap = &wr->slots[slot];
+    renderer_init_capture(&wr->capture, snap);
+    world_capture(wr->world, &wr->capture);
+    snap->tick = wr->tick;
+}
+
+static void world_runner_publish(WorldRunner *wr) {
+    SDL_LockMutex(wr->slot_lock);
+    int tmp = wr->ready_slot;
+    wr->ready_slot = wr->write_slot;
+    wr->write_slot = tmp;
+    wr->ready_fresh = true;
+    SDL_UnlockMutex(wr->slot_lock);
+}
+
+static int world_runner_thread(void *user) {
+    WorldRunner *wr = (WorldRunner *)user;
+    for (;;) {
+        SDL_LockMutex(wr->wake_lock);
+        while (!wr->quit && wr->pending_steps == 0)
+            SDL_CondWait(wr->wake, wr->wake_lock);
+        if (wr->quit) {
+            SDL_UnlockMutex(wr->wake_lock);
+            break;
+        }
+        wr->pending_steps--;
+        SDL_UnlockMutex(wr->wake_lock);
+
+        SDL_LockMutex(wr->world_lock);
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        world_update(wr->world, (float)FIXED_DT);
+        wr->tick++;
+        world_runner_capture(wr, wr->write_slot);
+        wr->sim_ticks += SDL_GetPerformanceCounter() - t0;
+        SDL_UnlockMutex(wr->world_lock);
+
+        world_runner_publish(wr);
+        SDL_AtomicAdd(&wr->steps_done, 1);
+    }
+    return 0;
+}
+
+WorldRunner *world_runner_create(struct World *w) {
+    if (!w)
+        return NULL;
+    WorldRunner *wr = calloc(1, sizeof(WorldRunner));
+    if (!wr) {
+        LOG_ERROR("world_runner", "Failed to allocate world runner");
+        return NULL;
+    }
+    wr->world = w;
+    wr->write_slot = 0;
+    wr->ready_slot = 1;
+    wr->read_slot = 2;
+    wr->world_lock = SDL_CreateMutex();
+    wr->slot_lock = SDL_CreateMutex();
+    wr->wake_lock = SDL_CreateMutex();
+    wr->wake = SDL_CreateCond();
+    if (!wr->world_lock || !wr->slot_lock || !wr->wake_lock || !wr->wake) {
+        LOG_WARN("world_runner", "Failed to create sync primitives: %s", SDL_GetError());
+        world_runner_destroy(wr);
+        return NULL;
+    }
+
+    /* Seed the read slot so the first frames have something to show */
+    world_runner_capture(wr, wr->read_slot);
+
+    wr->report_at = SDL_GetPerformanceCounter() + SDL_GetPerformanceFrequency() * WORLD_RUNNER_REPORT_SECONDS;
+    wr->thread = SDL_CreateThread(world_runner_thread, "world_sim", wr);
+    if (!wr->thread) {
+        LOG_WARN("world_runner", "Failed to start simulation thread: %s", SDL_GetError());
+        world_runner_destroy(wr);
+        return NULL;
+    }
+    LOG_INFO("world_runner", "Simulation thread started");
+    return wr;
+}
+
+void world_runner_destroy(WorldRunner *wr) {
+    if (!wr)
+        return;
+    if (wr->thread) {
+        SDL_LockMutex(wr->wake_lock);
+        wr->quit = true;
+        SDL_CondSignal(wr->wake);
+        SDL_UnlockMutex(wr->wake_lock);
+        SDL_WaitThread(wr->thread, NULL);
+        wr->thread = NULL;
+    }
+    for (int i = 0; i < WORLD_RUNNER_SLOTS; ++i)
+        render_snapshot_free(&wr->slots[i]);
+    if (wr->wake)
+        SDL_DestroyCond(wr->wake);
+    if (wr->wake_lock)
+        SDL_DestroyMutex(wr->wake_lock);
+    if (wr->slot_lock)
+        SDL_DestroyMutex(wr->slot_lock);
+    if (wr->world_lock)
+        SDL_DestroyMutex(wr->world_lock);
+    free(wr);
+}
+
+void world_runner_step(WorldRunner *wr) {
+    if (!wr)
+        return;
+    SDL_LockMutex(wr->wake_lock);
+    /* If the worker falls behind, drop steps instead of building an ever-growing backlog */
+    if (wr->pending_steps < WORLD_RUNNER_MAX_PENDING)
+        wr->pending_steps++;
+    SDL_CondSignal(wr->wake);
+    SDL_UnlockMutex(wr->wake_lock);
+}
+
+static void world_runner_report(WorldRunner *wr) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (now < wr->report_at)
+        return;
+    double freq = (double)SDL_GetPerformanceFrequency();
+    uint64_t steps = (uint64_t)SDL_AtomicGet(&wr->steps_done);
+    uint64_t delta_steps = steps - wr->report_steps;
+    double sim_ms = (double)wr->sim_ticks * 1000.0 / freq;
+    double wait_ms = (double)wr->wait_ticks * 1000.0 / freq;
+    double hidden_ms = sim_ms > wait_ms ? sim_ms - wait_ms : 0.0;
+    LOG_INFO("world_runner", "steps=%llu sim=%.3fms/step main_wait=%.3fms/step hidden=%.1f%%",
+             (unsigned long long)delta_steps,
+             delta_steps ? sim_ms / (double)delta_steps : 0.0,
+             delta_steps ? wait_ms / (double)delta_steps : 0.0,
+             sim_ms > 0.0 ? hidden_ms * 100.0 / sim_ms : 0.0);
+    wr->sim_ticks = 0;
+    wr->wait_ticks = 0;
+    wr->report_steps = steps;
+    wr->report_at = now + (Uint64)(freq * WORLD_RUNNER_REPORT_SECONDS);
+}
+
+void world_runner_lock(WorldRunner *wr) {
+    if (!wr)
+        return;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    SDL_LockMutex(wr->world_lock);
+    wr->wait_ticks += SDL_GetPerformanceCounter() - t0;
+    world_runner_report(wr);
+}
+
+void world_runner_unlock(WorldRunner *wr) {
+    if (wr)
+        SDL_UnlockMutex(wr->world_lock);
+}
+
+void world_runner_render(WorldRunner *wr, struct Renderer *r) {
+    if (!wr || !r)
+        return;
+    /* planets_in_background is only ever touched on the main thread */
+    bool skip_planets = wr->world->planets_in_background;
+    wr->world->planets_in_background = false;
+    SDL_LockMutex(wr->slot_lock);
+    if (wr->ready_fresh) {
+        int tmp = wr->read_slot;
+        wr->read_slot = wr->ready_slot;
+        wr->ready_slot = tmp;
+        wr->ready_fresh = false;
+    }
+    SDL_UnlockMutex(wr->slot_lock);
+    renderer_replay_snapshot(r, &wr->slots[wr->read_slot], skip_planets);
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../services/render_snapshot.h"
+#include "../services/renderer.h"
+
+struct World;
+
+#define WORLD_RUNNER_SLOTS 3
+#define WORLD_RUNNER_MAX_PENDING 4
+
+/* Optional threaded simulation (WORLD_SIM_THREAD).
+ *
+ * A worker thread steps world_update at FIXED_DT whenever the owning scene
+ * requests a step and records the result into one slot of a triple buffer of
+ * RenderSnapshots. The main thread keeps every SDL call: it replays the newest
+ * published snapshot while the next step is already being simulated.
+ *
+ * Scene code that reads or mutates the world must hold world_runner_lock().
+ * Planets are treated as immutable after population and may be read by the
+ * main thread (background layer) without the lock.
+ */
+typedef struct WorldRunner {
+    struct World *world;
+    SDL_Thread *thread;
+    SDL_mutex *world_lock;   // held by the worker during a step and by scene logic
+    SDL_mutex *slot_lock;    // guards the triple buffer indices
+    SDL_mutex *wake_lock;
+    SDL_cond *wake;
+    int pending_steps;       // guarded by wake_lock
+    bool quit;               // guarded by wake_lock
+    RenderSnapshot slots[WORLD_RUNNER_SLOTS];
+    int write_slot, ready_slot, read_slot;
+    bool ready_fresh;        // guarded by slot_lock
+    Renderer capture;        // capture-only renderer used by the worker
+    uint64_t tick;
+    /* timing (perf counter ticks) */
+    SDL_atomic_t steps_done;
+    uint64_t sim_ticks;      // worker time spent stepping (guarded by world_lock)
+    uint64_t wait_ticks;     // main thread time blocked on the worker
+    uint64_t report_at;
+    uint64_t report_steps;
+} WorldRunner;
+
+/* Start a worker for the given world. Returns NULL if threads are unavailable;
+ * callers then keep stepping the world inline. */
+WorldRunner *world_runner_create(struct World *w);
+/* Stop and join the worker. The world itself is not destroyed. */
+void world_runner_destroy(WorldRunner *wr);
+/* Queue one FIXED_DT step (non-blocking). */
+void world_runner_step(WorldRunner *wr);
+/* Exclusive world access for scene logic on the main thread. */
+void world_runner_lock(WorldRunner *wr);
+void world_runner_unlock(WorldRunner *wr);
+/* Replay the most recent snapshot (main thread, after world_render_background). */
+void world_runner_render(WorldRunner *wr, struct Renderer *r);
@@ -1,21 +1,120 @@
 #include "app/app.h"
 #include <SDL2/SDL.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/types.h"
+#include "core/log.h"
+#include "core/vfs.h"
+#include "game/campaign_levels.h"
+#include "game/level_analyzer.h"
+#include "game/level_loader.h"
+#include "scenes/scene_campaign.h"
+
+#ifndef PLATFORM_VITA
+/* --bench-levels [iterations]: time level_load over every campaign level and exit */
+static int bench_levels(int iterations) {
+
+    vfs_mount("./assets");
+    CampaignLevelList list = {0};
+    if (campaign_levels_scan(&list, NULL) != 0 || list.count == 0) {
+        LOG_ERROR("bench", "No levels found");
+        vfs_unmount();
+        return 1;
+    }
+    int failed = 0;
+    double total = 0.0;
+    for (int i = 0; i < list.count; ++i) {
+        GameLevel lvl;
+        char err[128] = {0};
+        if (level_load(list.items[i].filename, &lvl, err, sizeof(err)) != 0) {
+            LOG_ERROR("bench", "%s: %s", list.items[i].filename, err);
+            failed++;
+            continue;
+        }
+        unsigned version = lvl.version;
+        level_free(&lvl);
+        double us = level_benchmark(list.items[i].filename, iterations);
+        total += us;
+        LOG_INFO("bench", "%-24s v%u %8.2f us/load", list.items[i].filename, version, us);
+    }
+    LOG_INFO("bench", "%d levels, %d iterations each: %.2f us total per pass", list.count - failed, iterations, total);
+    campaign_levels_free(&list);
+    vfs_unmount();
+    return failed ? 1 : 0;
+
+}
+
+/* --analyze-levels [out_dir]: difficulty heatmaps and shot statistics for every campaign level */
+static int analyze_levels(const char *out_dir) {
+
+    vfs_mount("./assets");
+    CampaignLevelList list = {0};
+    if (campaign_levels_scan(&list, NULL) != 0 || list.count == 0) {
+        LOG_ERROR("analyzer", "No levels found");
+        vfs_unmount();
+        return 1;
+    }
+    int failed = 0;
+    double total = 0.0;
+    for (int i = 0; i < list.count; ++i) {
+        LevelAnalysis a;
+        if (!level_analyze(list.items[i].filename, out_dir, 0, &a)) {
+            failed++;
+            continue;
+        }
+        total += a.ms;
+        float open = a.open_positions ? (float)a.open_positions : 1.f;
+        LOG_INFO("analyzer", "%-24s %2d enemies %5.1f%% reach %5.1f%% found %5.2f shots/hit %8.1f ms", list.items[i].filename,
+                 a.enemies, 100.f * (float)a.reachable_positions / open, 100.f * (float)a.found_positions / open,
+                 a.median_shots, a.ms);
+    }
+    LOG_INFO("analyzer", "%d levels in %.1f ms, reports in %s", list.count - failed, total, out_dir);
+    campaign_levels_free(&list);
+    vfs_unmount();
+    return failed ? 1 : 0;
+
+}
+#endif
 
 int main(int argc, char **argv) {
 
+#ifndef PLATFORM_VITA
+    if (argc >= 2 && strcmp(argv[1], "--bench-levels") == 0)
+        return bench_levels(argc >= 3 ? atoi(argv[2]) : 1000);
+    if (argc >= 2 && strcmp(argv[1], "--analyze-levels") == 0)
+        return analyze_levels(argc >= 3 ? argv[2] : "level_analysis");
+#else
     (void)argc;
     (void)argv;
+#endif
     if (!app_create())
         return 1;
+#ifndef PLATFORM_VITA
+    /* --level <file>: skip the menus and play one level, e.g. stress/stress_swarm.lvl */
+    if (argc >= 3 && strcmp(argv[1], "--level") == 0) {
+        scene_campaign_set_level(argv[2]);
+        app_set_scene(SCENE_CAMPAIGN);
+    }
+#endif
     bool running = true;
     while (running) {
         SDL_Event e;
+        bool got_event = false;
+        /* Nothing changed last frame: sleep until an event arrives instead of spinning */
+        if (app_is_idle() && SDL_WaitEventTimeout(&e, APP_IDLE_WAIT_MS)) {
+            got_event = true;
+            if (e.type == SDL_QUIT)
+                running = false;
+        }
         while (SDL_PollEvent(&e)) {
+            got_event = true;
             if (e.type == SDL_QUIT)
                 running = false;
 
 }
+        if (got_event)
+            app_request_redraw();
         app_update();
     }
     app_destroy();
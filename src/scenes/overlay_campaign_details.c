@@ -66,6 +66,21 @@ static void overlay_campaign_details_load(OverlayCampaignDetailsState *st)
 
     snprintf(st->level_filename, sizeof(st->level_filename), "%s", s_pending_level_filename);
 
+    /* Everything shown here is in the level index; only unindexed levels are opened */
+    const CampaignIndexEntry *entry = campaign_levels_index_find(st->level_filename);
+    if (entry)
+    {
+        st->time_limit = entry->time_limit;
+        st->goal_kills = entry->goal_kills;
+        st->rating[0] = entry->rating[0];
+        st->rating[1] = entry->rating[1];
+        st->rating[2] = entry->rating[2];
+        const char *text = campaign_levels_index_text(entry);
+        st->start_text = overlay_campaign_details_strdup(text[0] ? text : "Ready?");
+        st->load_ok = 1;
+        return;
+    }
+
     GameLevel lvl = {0};
     char err[256] = {0};
     if (level_load(st->level_filename, &lvl, err, sizeof(err)) != 0)
@@ -192,7 +207,7 @@ static float overlay_campaign_details_render_start_text(const OverlayCampaignDet
         return y;
 
     SDL_FRect dst = {x, y, (float)size.x, (float)size.y};
-    SDL_RenderCopyF(r->sdl, tex, NULL, &dst);
+    renderer_draw_texture(r, tex, NULL, &dst, 0.f);
     return y + (float)size.y;
 }
 
@@ -279,9 +294,9 @@ void overlay_campaign_details_render(Scene *s, struct Renderer *r)
     y += line_spacing * 0.5f;
 
     SDL_Texture *icons_sheet = (svc && svc->texman) ? texman_get(svc->texman, TEX_ICONS_SHEET) : NULL;
-    SDL_Rect icon_time = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 5) : (SDL_Rect){0};
-    SDL_Rect icon_rating = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 4) : (SDL_Rect){0};
-    SDL_Rect icon_goal = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 6) : (SDL_Rect){0};
+    SDL_Rect icon_time = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 5)->src : (SDL_Rect){0};
+    SDL_Rect icon_rating = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 4)->src : (SDL_Rect){0};
+    SDL_Rect icon_goal = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 6)->src : (SDL_Rect){0};
 
     char time_value[64];
     if (st->time_limit != 0)
@@ -314,7 +329,7 @@ void overlay_campaign_details_render(Scene *s, struct Renderer *r)
         if (st->time_limit == 0)
         {
             // Hacky as fuck - no time! The competition is ending in 2 days :D
-            SDL_Rect infinity_symbol = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 7) : (SDL_Rect){0};
+            SDL_Rect infinity_symbol = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 7)->src : (SDL_Rect){0};
             overlay_campaign_details_render_icon_row(r, icons_sheet, infinity_symbol, text_x + icon_time.w, y, icon_height, icon_text_spacing, "");
         }
     }
@@ -10,12 +10,14 @@
 #include "../game/campaign_levels.h"
 #include "../game/campaign_progress.h"
 #include "scene_campaign_menu.h"
+#include "scene_campaign.h"
 #include "../core/log.h"
 #include "../core/types.h"
 
 /* forward decl */
 static void overlay_endgame_copy_saved_to_state(struct OverlayEndgameState *st);
 static void overlay_endgame_record_campaign_progress(const OverlayEndgameState *st);
+static int overlay_endgame_stars(const OverlayEndgameState *st);
 
 static int s_saved_kills = 0;
 static int s_saved_points = 0;
@@ -70,6 +72,19 @@ void overlay_endgame_enter(Scene *s) {
     st->input_block_time = 0.5f; /* 500 ms */
     overlay_endgame_copy_saved_to_state(st);
     overlay_endgame_record_campaign_progress(st);
+
+    /* After a win, build the next level on a worker while the results are shown */
+    if (st->has_level_result && st->goals_all_met && overlay_endgame_stars(st) > 0 && s_saved_level_filename[0]) {
+        int count = campaign_levels_index_load();
+        for (int i = 0; i + 1 < count; ++i) {
+            if (strcmp(campaign_levels_index_entry(i)->filename, s_saved_level_filename) == 0) {
+                snprintf(st->next_level, sizeof(st->next_level), "%s", campaign_levels_index_entry(i + 1)->filename);
+                break;
+            }
+        }
+    }
+    if (st->next_level[0])
+        scene_campaign_prefetch(st->next_level);
 }
 void overlay_endgame_leave(Scene *s) {
     OverlayEndgameState *st = (OverlayEndgameState *)s->state;
@@ -85,7 +100,16 @@ void overlay_endgame_handle_input(Scene *s, const struct InputState *in) {
         return;
     }
     int confirm = in->confirm ? 1 : 0;
+    if (st->next_level[0] && (in->menu_up || in->menu_down))
+        st->selected = 1 - st->selected;
     if (confirm && !st->prev_confirm) {
+        if (st->next_level[0] && st->selected == 0) {
+            /* Next level: the prefetched world is adopted by scene_campaign_enter */
+            scene_campaign_set_level(st->next_level);
+            app_pop_overlay();
+            app_set_scene(SCENE_CAMPAIGN);
+            return;
+        }
         if (st->has_level_result) {
             scene_campaign_menu_focus_last_unlocked();
             app_set_scene(SCENE_CAMPAIGN_MENU);
@@ -106,6 +130,8 @@ void overlay_endgame_update(Scene *s, float dt) {
         st->input_block_time -= dt;
         if (st->input_block_time < 0.0f)
             st->input_block_time = 0.0f;
+        /* a pending timer keeps the app out of idle so it runs in real time */
+        s->dirty = true;
     }
 }
 void overlay_endgame_render(Scene *s, struct Renderer *r) {
@@ -122,17 +148,11 @@ void overlay_endgame_render(Scene *s, struct Renderer *r) {
     int title_y = 80;
 
     SDL_Texture *icons_sheet = texman_get(svc->texman, TEX_ICONS_SHEET);
-    SDL_Rect star_src_filled = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 4) : (SDL_Rect){0};
-    SDL_Rect star_src_empty = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 8) : (SDL_Rect){0};
-    SDL_Rect kill_icon_src = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 6) : (SDL_Rect){0};
+    SDL_Rect star_src_filled = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 4)->src : (SDL_Rect){0};
+    SDL_Rect star_src_empty = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 8)->src : (SDL_Rect){0};
+    SDL_Rect kill_icon_src = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 6)->src : (SDL_Rect){0};
 
-    int stars = 0;
-    if (st->points >= (int)st->rating[2])
-        stars = 3;
-    else if (st->points >= (int)st->rating[1])
-        stars = 2;
-    else if (st->points >= (int)st->rating[0])
-        stars = 1;
+    int stars = overlay_endgame_stars(st);
 
     int cleared = st->goals_all_met ? 1 : 0;
     int earned_stars = cleared ? stars : 0;
@@ -192,15 +212,23 @@ void overlay_endgame_render(Scene *s, struct Renderer *r) {
     snprintf(points_buf, sizeof(points_buf), "%d", st->points);
     renderer_draw_text_centered(r, points_buf, (float)cx, points_y, (TextStyle){0});
 
-    /* single Ok button */
+    /* single Ok button, or Next level / Menu after a campaign win */
     int box_w = 240;
     int box_h = 44;
+    int spacing = 56;
+    const char *labels[2] = {"Next level", "Menu"};
+    int buttons = st->next_level[0] ? 2 : 1;
+    if (buttons == 1)
+        labels[0] = "Ok";
     float bx = (float)(cx - box_w / 2);
-    float by = (float)(svc->display_h - 120);
-    SDL_FRect box = {bx, by, (float)box_w, (float)box_h};
-    renderer_draw_filled_rect(r, box, MENU_COLOR_BUTTON_BASE);
-    renderer_draw_rect_outline(r, box, MENU_COLOR_BUTTON_HIGHLIGHT, 2);
-    renderer_draw_text_centered(r, "Ok", (float)cx, by + 10.f, (TextStyle){0});
+    float by = (float)(svc->display_h - 120 - (buttons - 1) * spacing);
+    for (int i = 0; i < buttons; ++i) {
+        SDL_FRect box = {bx, by + (float)(i * spacing), (float)box_w, (float)box_h};
+        renderer_draw_filled_rect(r, box, MENU_COLOR_BUTTON_BASE);
+        if (i == st->selected || buttons == 1)
+            renderer_draw_rect_outline(r, box, MENU_COLOR_BUTTON_HIGHLIGHT, 2);
+        renderer_draw_text_centered(r, labels[i], (float)cx, box.y + 10.f, (TextStyle){0});
+    }
 }
 
 void overlay_endgame_set_stats(int kills, int points) {
@@ -256,6 +284,17 @@ void overlay_endgame_set_failure_reason(OverlayEndgameFailReason reason) {
     s_saved_fail_reason = reason;
 }
 
+static int overlay_endgame_stars(const OverlayEndgameState *st) {
+
+    if (st->points >= (int)st->rating[2])
+        return 3;
+    if (st->points >= (int)st->rating[1])
+        return 2;
+    if (st->points >= (int)st->rating[0])
+        return 1;
+    return 0;
+}
+
 static void overlay_endgame_record_campaign_progress(const OverlayEndgameState *st) {
 
     if (!st)
@@ -265,13 +304,7 @@ static void overlay_endgame_record_campaign_progress(const OverlayEndgameState *
     if (!s_saved_level_filename[0])
         return;
 
-    int stars = 0;
-    if (st->points >= (int)st->rating[2])
-        stars = 3;
-    else if (st->points >= (int)st->rating[1])
-        stars = 2;
-    else if (st->points >= (int)st->rating[0])
-        stars = 1;
+    int stars = overlay_endgame_stars(st);
 
     if (stars <= 0)
         return;
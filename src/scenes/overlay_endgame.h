@@ -1,5 +1,6 @@
 #pragma once
 #include "../app/scene.h"
+#include "../game/campaign_levels.h"
 
 typedef enum OverlayEndgameFailReason {
     OVERLAY_ENDGAME_FAIL_NONE = 0,
@@ -22,6 +23,8 @@ typedef struct OverlayEndgameState {
     int goals_all_met;    /* boolean */
     unsigned int rating[3];
     OverlayEndgameFailReason fail_reason;
+    /* campaign win: level after this one (being prefetched), empty if none */
+    char next_level[CAMPAIGN_LEVEL_MAX_FILENAME];
 } OverlayEndgameState;
 
 void overlay_endgame_enter(Scene *s);
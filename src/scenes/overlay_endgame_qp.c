@@ -59,6 +59,8 @@ void overlay_endgame_qp_update(Scene *s, float dt) {
         st->input_block_time -= dt;
         if (st->input_block_time < 0.0f)
             st->input_block_time = 0.0f;
+        /* a pending timer keeps the app out of idle so it runs in real time */
+        s->dirty = true;
     }
 }
 void overlay_endgame_qp_render(Scene *s, struct Renderer *r) {
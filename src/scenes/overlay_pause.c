@@ -92,11 +92,9 @@ void overlay_pause_render(Scene *s, struct Renderer *r) {
         renderer_draw_filled_rect(r, box, MENU_COLOR_BUTTON_BASE);
         if (selected) {
             if (st->svc && st->svc->sdl_renderer) {
-                SDL_BlendMode prev = SDL_BLENDMODE_BLEND;
-                SDL_GetRenderDrawBlendMode(st->svc->sdl_renderer, &prev);
-                SDL_SetRenderDrawBlendMode(st->svc->sdl_renderer, SDL_BLENDMODE_NONE);
+                SDL_BlendMode prev = renderer_set_blend_mode(r, SDL_BLENDMODE_NONE);
                 renderer_draw_rect_outline(r, box, MENU_COLOR_BUTTON_HIGHLIGHT, 2);
-                SDL_SetRenderDrawBlendMode(st->svc->sdl_renderer, prev);
+                renderer_set_blend_mode(r, prev);
             }
             else {
                 renderer_draw_rect_outline(r, box, MENU_COLOR_BUTTON_HIGHLIGHT, 1);
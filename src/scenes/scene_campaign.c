@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <SDL2/SDL.h>
 #include "../core/log.h"
 #include "../services/services.h"
 #include "../services/renderer.h"
@@ -14,6 +15,7 @@
 
 static void scene_campaign_on_time_over(World *world, void *user);
 static void scene_campaign_finish(SceneCampaignState *st);
+static void scene_campaign_logic(SceneCampaignState *st, float dt);
 
 static char g_campaign_level_to_load[CAMPAIGN_LEVEL_MAX_FILENAME] = "example_level.lvl";
 
@@ -32,59 +34,82 @@ const char *scene_campaign_get_level(void)
     return "example_level.lvl";
 }
 
-void scene_campaign_enter(Scene *s)
+/* A level turned into a populated world; built on the prefetch thread or in enter */
+typedef struct CampaignBuild
 {
-    SceneCampaignState *st = calloc(1, sizeof(SceneCampaignState));
-    if (!st)
-    {
-        LOG_ERROR("scene_campaign", "Failed to allocate scene state");
-        return;
-    }
-    s->state = st;
-    st->svc = app_services();
-    st->world = NULL;
-    st->spawns = NULL;
-    st->spawn_count = 0;
-    st->level_end_delay = LEVEL_END_DELAY_SECONDS;
+    char filename[CAMPAIGN_LEVEL_MAX_FILENAME];
+    World *world;
+    SpawnSchedule spawns;
+    uint16_t goal_kills;
+    unsigned int rating[3];
+    char err[256];
+} CampaignBuild;
 
-    const char *level_to_load = scene_campaign_get_level();
+static struct
+{
+    SDL_Thread *thread;
+    struct Services *svc;
+    char filename[CAMPAIGN_LEVEL_MAX_FILENAME]; // level being built; fixed while the thread runs
+    CampaignBuild build;
+    bool ok;
+} g_prefetch;
 
-    GameLevel lvl;
-    char err[256] = {0};
-    if (level_load(level_to_load, &lvl, err, sizeof(err)) != 0)
-    {
-        LOG_ERROR("scene_campaign", "Failed to load level '%s': %s", level_to_load ? level_to_load : "?", err);
-        return;
-    }
+static void scene_campaign_build_discard(CampaignBuild *b)
+{
+    if (b->world)
+        world_destroy(b->world);
+    spawn_schedule_free(&b->spawns);
+    memset(b, 0, sizeof(*b));
+}
 
-    snprintf(st->level_filename, sizeof(st->level_filename), "%s", level_to_load ? level_to_load : "");
+/* Load the level and create its world, player, planets, spawn table and HUD.
+ * Touches no renderer state, so it may run off the main thread. */
+static bool scene_campaign_build(struct Services *svc, const char *filename, CampaignBuild *b)
+{
+    memset(b, 0, sizeof(*b));
+    snprintf(b->filename, sizeof(b->filename), "%s", filename ? filename : "");
+
+    GameLevel lvl;
+    if (level_load(filename, &lvl, b->err, sizeof(b->err)) != 0)
+        return false;
 
     // create world and populate planets/player based on level
-    World *w = world_create(st->svc, 0);
-    st->world = w;
-    if (st->world)
+    World *w = world_create(svc, 0);
+    if (!w)
+    {
+        snprintf(b->err, sizeof(b->err), "failed to create world");
+        level_free(&lvl);
+        return false;
+    }
+    b->world = w;
+    // size planet/enemy/shooter storage from the level header, no regrowth while spawning
+    if (!world_reserve(w, (int)lvl.planets_count, (int)lvl.enemies_count))
     {
-        st->world->on_time_over = scene_campaign_on_time_over;
-        st->world->on_time_over_user = st;
+        snprintf(b->err, sizeof(b->err), "failed to reserve world storage");
+        level_free(&lvl);
+        scene_campaign_build_discard(b);
+        return false;
     }
     if (lvl.time_limit > 0)
         world_set_time_limit(w, (float)lvl.time_limit);
 
-    /* copy goals/ratings into scene state for end-of-level evaluation */
-    st->goal_kills = lvl.goal_kills;
-    st->rating[0] = lvl.rating[0];
-    st->rating[1] = lvl.rating[1];
-    st->rating[2] = lvl.rating[2];
+    /* copy goals/ratings for end-of-level evaluation */
+    b->goal_kills = lvl.goal_kills;
+    b->rating[0] = lvl.rating[0];
+    b->rating[1] = lvl.rating[1];
+    b->rating[2] = lvl.rating[2];
 
     // spawn planets
     for (uint32_t i = 0; i < lvl.planets_count; ++i)
     {
-        LevelPlanet *p = &lvl.planets[i];
+        const LevelPlanet *p = &lvl.planets[i];
         float px = p->pos_x;
         float py = p->pos_y;
         uint8_t type = p->type;
         world_add_planet(w, px, py, p->size, type);
     }
+    // gravity/collision grids, baked into the level file when it was compiled with --bake
+    world_build_planet_field(w, &lvl);
 
     // place player
     if (lvl.player_pos_x != 0.0f || lvl.player_pos_y != 0.0f)
@@ -98,63 +123,127 @@ void scene_campaign_enter(Scene *s)
         world_place_player(w, 0.0f);
     }
 
-    // create enemy spawn templates from lvl.enemies and register to world
-    if (lvl.enemies_count)
+    // spawn table: on_start enemies without delay appear now, the rest on timers and deaths
+    if (!spawn_schedule_init(&b->spawns, &lvl, w))
     {
-        st->spawns = calloc(lvl.enemies_count, sizeof(SpawnEntry));
-        if (!st->spawns)
-        {
-            LOG_ERROR("scene_campaign", "Failed to allocate spawn entries");
-            level_free(&lvl);
-            return;
-        }
-        st->spawn_count = lvl.enemies_count;
-        for (uint32_t i = 0; i < lvl.enemies_count; ++i)
-        {
-            LevelEnemy *le = &lvl.enemies[i];
-            SpawnEntry *se = &st->spawns[i];
-            se->template = *le;
-            // convert normalized coords to pixels
-            se->template.pos_x = le->pos_x;
-            se->template.pos_y = le->pos_y;
-            se->spawned = 0;
-            se->runtime_index = -1;
-            se->runtime_ptr = NULL;
-            se->target_id = (le->spawn_kind == 1) ? le->spawn_arg : 0;
-            se->target_runtime_index = -1;
-            se->scheduled_time = -1.0f;
-            // handle on_start spawns: if a delay is set, schedule it, otherwise spawn immediately
-            if (le->spawn_kind == 0)
-            {
-                if (le->spawn_delay > 0)
-                {
-                    se->scheduled_time = w->time + (float)le->spawn_delay;
-                }
-                else
-                {
-                    if (world_spawn_enemy(w, (int)le->type, se->template.pos_x, se->template.pos_y, le->difficulty, le->health))
-                    {
-                        se->spawned = 1;
-                    }
-                    else
-                    {
-                        // failed to spawn immediately; schedule retry next frame
-                        se->scheduled_time = w->time;
-                    }
-                }
-            }
-        }
+        snprintf(b->err, sizeof(b->err), "failed to allocate spawn entries");
+        level_free(&lvl);
+        scene_campaign_build_discard(b);
+        return false;
     }
 
-    st->world->hud = hud_create(st->world->svc, st->world->player);
+    w->hud = hud_create(w->svc, w->player);
 
-    // keep world reference in scene state; level data copied into spawn structures later
+    // level data copied into spawn structures above
     level_free(&lvl);
+    return true;
+}
 
-    if (st->world)
+static int scene_campaign_prefetch_thread(void *data)
+{
+    (void)data;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    g_prefetch.ok = scene_campaign_build(g_prefetch.svc, g_prefetch.filename, &g_prefetch.build);
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    if (g_prefetch.ok)
+        LOG_INFO("scene_campaign", "Prefetched '%s' in %.2f ms", g_prefetch.filename, ms);
+    else
+        LOG_WARN("scene_campaign", "Prefetch of '%s' failed: %s", g_prefetch.filename, g_prefetch.build.err);
+    return 0;
+}
+
+void scene_campaign_prefetch(const char *filename)
+{
+    if (!filename || !filename[0])
+        return;
+    if (g_prefetch.thread && strcmp(g_prefetch.filename, filename) == 0)
+        return;
+    scene_campaign_prefetch_cancel();
+    g_prefetch.svc = app_services();
+    g_prefetch.ok = false;
+    snprintf(g_prefetch.filename, sizeof(g_prefetch.filename), "%s", filename);
+    g_prefetch.thread = SDL_CreateThread(scene_campaign_prefetch_thread, "level_prefetch", NULL);
+    if (!g_prefetch.thread)
+    {
+        LOG_WARN("scene_campaign", "Prefetch thread failed: %s", SDL_GetError());
+        g_prefetch.filename[0] = '\0';
+    }
+}
+
+void scene_campaign_prefetch_cancel(void)
+{
+    if (!g_prefetch.thread)
+        return;
+    SDL_WaitThread(g_prefetch.thread, NULL);
+    g_prefetch.thread = NULL;
+    scene_campaign_build_discard(&g_prefetch.build);
+    g_prefetch.filename[0] = '\0';
+    g_prefetch.ok = false;
+}
+
+/* Hand over a prefetched build of 'filename'; waits if the worker is still running */
+static bool scene_campaign_prefetch_take(const char *filename, CampaignBuild *out)
+{
+    if (!g_prefetch.thread || !filename || strcmp(g_prefetch.filename, filename) != 0)
     {
-        app_push_overlay(SCENE_OVERLAY_START_GAME);
+        scene_campaign_prefetch_cancel();
+        return false;
     }
+    SDL_WaitThread(g_prefetch.thread, NULL);
+    g_prefetch.thread = NULL;
+    g_prefetch.filename[0] = '\0';
+    if (!g_prefetch.ok)
+    {
+        scene_campaign_build_discard(&g_prefetch.build);
+        return false;
+    }
+    *out = g_prefetch.build;
+    memset(&g_prefetch.build, 0, sizeof(g_prefetch.build));
+    g_prefetch.ok = false;
+    return true;
+}
+
+void scene_campaign_enter(Scene *s)
+{
+    SceneCampaignState *st = calloc(1, sizeof(SceneCampaignState));
+    if (!st)
+    {
+        LOG_ERROR("scene_campaign", "Failed to allocate scene state");
+        return;
+    }
+    s->state = st;
+    st->svc = app_services();
+    st->world = NULL;
+    st->level_end_delay = LEVEL_END_DELAY_SECONDS;
+
+    const char *level_to_load = scene_campaign_get_level();
+
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    CampaignBuild build;
+    bool prefetched = scene_campaign_prefetch_take(level_to_load, &build);
+    if (!prefetched && !scene_campaign_build(st->svc, level_to_load, &build))
+    {
+        LOG_ERROR("scene_campaign", "Failed to load level '%s': %s", level_to_load ? level_to_load : "?", build.err);
+        return;
+    }
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    LOG_INFO("scene_campaign", "Level '%s' ready in %.2f ms (%s)", build.filename, ms, prefetched ? "prefetched" : "loaded");
+
+    snprintf(st->level_filename, sizeof(st->level_filename), "%s", level_to_load ? level_to_load : "");
+
+    st->world = build.world;
+    st->spawns = build.spawns;
+    st->goal_kills = build.goal_kills;
+    st->rating[0] = build.rating[0];
+    st->rating[1] = build.rating[1];
+    st->rating[2] = build.rating[2];
+    st->world->on_time_over = scene_campaign_on_time_over;
+    st->world->on_time_over_user = st;
+
+#if WORLD_SIM_THREAD
+    st->runner = world_runner_create(st->world);
+#endif
+    app_push_overlay(SCENE_OVERLAY_START_GAME);
 }
 
 void scene_campaign_leave(Scene *s)
@@ -162,14 +251,15 @@ void scene_campaign_leave(Scene *s)
     SceneCampaignState *st = (SceneCampaignState *)s->state;
     if (!st)
         return;
+    world_runner_destroy(st->runner);
+    st->runner = NULL;
     if (st->world)
     {
         st->world->on_time_over = NULL;
         st->world->on_time_over_user = NULL;
         world_destroy(st->world);
     }
-    if (st->spawns)
-        free(st->spawns);
+    spawn_schedule_free(&st->spawns);
     free(st);
 }
 
@@ -235,13 +325,28 @@ void scene_campaign_handle_input(Scene *s, const struct InputState *in)
 void scene_campaign_update(Scene *s, float dt)
 {
     SceneCampaignState *st = (SceneCampaignState *)s->state;
-    World *w = st->world;
     if (!st || !st->world)
         return;
+    if (st->runner)
+    {
+        // scene logic sees the last completed step; the next one runs while we render
+        world_runner_lock(st->runner);
+        if (st->world->player)
+            player_set_input(st->world->player, &st->last_input);
+        scene_campaign_logic(st, dt);
+        world_runner_unlock(st->runner);
+        world_runner_step(st->runner);
+        return;
+    }
     if (st->world->player)
         player_set_input(st->world->player, &st->last_input);
     world_update(st->world, dt);
+    scene_campaign_logic(st, dt);
+}
 
+static void scene_campaign_logic(SceneCampaignState *st, float dt)
+{
+    World *w = st->world;
     if (!st->level_end_handled)
     {
         Player *player = st->world->player;
@@ -272,197 +377,13 @@ void scene_campaign_update(Scene *s, float dt)
         return;
     }
 
-    // process timer-based spawns
-    for (uint32_t i = 0; i < st->spawn_count; ++i)
-    {
-        SpawnEntry *se = &st->spawns[i];
-        if (se->spawned)
-            continue;
-        // timer-based spawns and scheduled on-death spawns share the same time test
-        if (se->scheduled_time >= 0.0f && w->time >= se->scheduled_time)
-        {
-            LevelEnemy *le = &se->template;
-            if (world_spawn_enemy(w, (int)le->type, le->pos_x, le->pos_y, le->difficulty, le->health))
-            {
-                se->spawned = 1;
-                se->scheduled_time = -1.0f;
-                // try to immediately bind runtime pointer/index to reduce ambiguity when many spawns occur
-                for (int ei = 0; ei < w->enemy_count; ++ei)
-                {
-                    Enemy *en = w->enemies[ei];
-                    if (!en)
-                        continue;
-                    // skip if already assigned to another spawn
-                    bool taken = false;
-                    for (uint32_t j = 0; j < st->spawn_count; ++j)
-                    {
-                        if (st->spawns[j].runtime_ptr == en)
-                        {
-                            taken = true;
-                            break;
-                        }
-                    }
-                    if (taken)
-                    {
-                        continue;
-                    }
-                    float dx = en->e.pos.x - se->template.pos_x;
-                    float dy = en->e.pos.y - se->template.pos_y;
-                    if (dx * dx + dy * dy < 64.0f)
-                    {
-                        se->runtime_ptr = en;
-                        se->runtime_index = ei;
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    // resolve runtime pointers for spawned entries by matching positions and unused enemies
-    for (uint32_t i = 0; i < st->spawn_count; ++i)
-    {
-        SpawnEntry *se = &st->spawns[i];
-        if (!se->spawned || se->runtime_ptr)
-            continue;
-        for (int ei = 0; ei < w->enemy_count; ++ei)
-        {
-            Enemy *en = w->enemies[ei];
-            if (!en)
-                continue;
-            // skip if already assigned
-            bool taken = false;
-            for (uint32_t j = 0; j < st->spawn_count; ++j)
-            {
-                if (st->spawns[j].runtime_ptr == en)
-                {
-                    taken = true;
-                    break;
-                }
-            }
-            if (taken)
-            {
-                continue;
-            }
-            float dx = en->e.pos.x - se->template.pos_x;
-            float dy = en->e.pos.y - se->template.pos_y;
-            float d2 = dx * dx + dy * dy;
-            if (d2 < 16.0f)
-            {
-                // within 4 pixels
-                se->runtime_ptr = en;
-                se->runtime_index = ei;
-                break;
-            }
-        }
-    }
-
-    // handle on-death spawns: trigger when target spawn's enemy is gone or dead
-    for (uint32_t i = 0; i < st->spawn_count; ++i)
-    {
-        SpawnEntry *se = &st->spawns[i];
-        if (se->spawned)
-            continue;
-        if (se->template.spawn_kind != 1)
-            continue;
-        // find target spawn entry by id
-        uint32_t target_id = se->target_id;
-        if (target_id == 0)
-            continue;
-        SpawnEntry *target_spawn = NULL;
-        for (uint32_t j = 0; j < st->spawn_count; ++j)
-        {
-            if (st->spawns[j].template.id == target_id)
-            {
-                target_spawn = &st->spawns[j];
-                break;
-            }
-        }
-        if (!target_spawn)
-        {
-            continue;
-        }
-        bool target_dead = false;
-        if (target_spawn->runtime_ptr)
-        {
-            // check if pointer still present in world enemies
-            Enemy *tent = (Enemy *)target_spawn->runtime_ptr;
-            bool found = false;
-            for (int ei = 0; ei < w->enemy_count; ++ei)
-            {
-                if (w->enemies[ei] == tent)
-                {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found)
-            {
-                target_dead = true;
-            }
-            else if (!tent->alive)
-                target_dead = true;
-        }
-        else if (target_spawn->spawned)
-        {
-            // spawned but no runtime_ptr resolved; try to find any enemy at that template pos
-            bool found_pos = false;
-            for (int ei = 0; ei < w->enemy_count; ++ei)
-            {
-                Enemy *en = w->enemies[ei];
-                if (!en)
-                    continue;
-                float dx = en->e.pos.x - target_spawn->template.pos_x;
-                float dy = en->e.pos.y - target_spawn->template.pos_y;
-                if (dx * dx + dy * dy < 16.0f)
-                {
-                    found_pos = true;
-                    break;
-                }
-            }
-            if (!found_pos)
-                target_dead = true; // can't find target in world
-        }
-        if (target_dead)
-        {
-            // schedule spawn using the original spawn_delay (if provided)
-            if (se->template.spawn_delay > 0)
-            {
-                if (se->scheduled_time < 0.0f)
-                {
-                    se->scheduled_time = w->time + (float)se->template.spawn_delay;
-                }
-            }
-            else
-            {
-                LevelEnemy *le = &se->template;
-                if (world_spawn_enemy(w, (int)le->type, le->pos_x, le->pos_y, le->difficulty, le->health))
-                {
-                    se->spawned = 1;
-                }
-                else
-                {
-                    se->scheduled_time = w->time; // retry next frame
-                    LOG_WARN("scene_campaign", "Immediate on-death spawn failed id=%u (scheduled retry at %.2f)", le->id, se->scheduled_time);
-                }
-            }
-        }
-    }
+    spawn_schedule_update(&st->spawns, w);
 
     /* Check level completion: if all spawn entries have been spawned and there are no
      * active enemies left in the world, treat level as finished and show endgame overlay. */
-    if (!st->level_end_handled && st->spawn_count > 0)
+    if (!st->level_end_handled && st->spawns.count > 0)
     {
-        bool all_spawned = true;
-        for (uint32_t i = 0; i < st->spawn_count; ++i)
-        {
-            if (!st->spawns[i].spawned)
-            {
-                all_spawned = false;
-                break;
-            }
-        }
-        if (all_spawned && w->enemy_count == 0)
+        if (spawn_schedule_done(&st->spawns) && w->enemy_count == 0)
         {
             st->level_end_delay -= dt;
             if (st->level_end_delay > 0.0f)
@@ -479,8 +400,15 @@ void scene_campaign_render(Scene *s, struct Renderer *r)
 {
     SceneCampaignState *st = (SceneCampaignState *)s->state;
     struct Services *svc = st->svc;
+    if (st->world)
+    {
+        world_render_background(st->world, r);
+        if (st->runner)
+            world_runner_render(st->runner, r);
+        else
+            world_render(st->world, r);
+        return;
+    }
     SDL_Texture *bg = texman_get(svc->texman, TEX_BG_STARFIELD);
     renderer_draw_texture(r, bg, NULL, NULL, 0);
-    if (st->world)
-        world_render(st->world, r);
 }
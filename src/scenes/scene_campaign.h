@@ -5,27 +5,19 @@
 #include "../game/world.h"
 #include "../services/input.h"
 #include "../game/campaign_levels.h"
+#include "../game/world_runner.h"
+#include "../game/spawn_schedule.h"
 
 // Timing constants
 #define LEVEL_END_DELAY_SECONDS 1.0f
 
-typedef struct SpawnEntry {
-	LevelEnemy template;
-	int spawned; // boolean
-	int runtime_index; // index in world->enemies after spawn, -1 if none
-	void *runtime_ptr; // pointer to spawned Enemy instance (opaque)
-	uint32_t target_id; // for on_death
-	int target_runtime_index; // -1 if unresolved
-	float scheduled_time; // for delayed spawns (-1 = none)
-} SpawnEntry;
-
 typedef struct SceneCampaignState {
 	struct Services *svc;
 	u32 current_level_seed;
 	int level_index;
 	World *world;
-	SpawnEntry *spawns;
-	uint32_t spawn_count;
+	WorldRunner *runner; // non-NULL when the world is stepped on a worker thread
+	SpawnSchedule spawns;
 	int debug_printed;
     struct InputState last_input;
 	/* level goals/ratings copied from GameLevel so overlay can evaluate results */
@@ -47,3 +39,9 @@ void scene_campaign_render(Scene *s, struct Renderer *r);
 
 void scene_campaign_set_level(const char *filename);
 const char *scene_campaign_get_level(void);
+
+/* Build the world for 'filename' on a worker thread; the next scene_campaign_enter
+ * for the same level adopts it instead of loading. Replaces an older prefetch. */
+void scene_campaign_prefetch(const char *filename);
+/* Wait for and drop any prefetched level */
+void scene_campaign_prefetch_cancel(void);
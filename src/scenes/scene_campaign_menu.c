@@ -15,8 +15,10 @@
 #include "scene_campaign.h"
 #include "overlay_campaign_details.h"
 #include "../game/ui_prompts.h"
+#include "../game/level_thumbs.h"
 
 #define CAMPAIGN_MENU_VISIBLE_ROWS 6
+#define CAMPAIGN_MENU_THUMB_GAP 20
 
 static SceneCampaignMenuState *s_active_state = NULL;
 static int s_focus_last_unlocked_request = 0;
@@ -32,13 +34,12 @@ static void scene_campaign_menu_draw_caret(Renderer *r, float cx, float y, doubl
     if (!renderer_get_text_texture(r, "^", (TextStyle){0}, &texture, &size) || !texture)
         return;
 
-    SDL_Rect dst = {
-        (int)(cx - size.x * 0.5f),
-        (int)y,
-        size.x,
-        size.y};
-    SDL_Point center = {size.x / 2, size.y / 2};
-    SDL_RenderCopyEx(r->sdl, texture, NULL, &dst, angle_deg, &center, SDL_FLIP_NONE);
+    SDL_FRect dst = {
+        (float)(int)(cx - size.x * 0.5f),
+        (float)(int)y,
+        (float)size.x,
+        (float)size.y};
+    renderer_draw_texture(r, texture, NULL, &dst, (float)angle_deg);
 }
 
 static void scene_campaign_menu_ensure_visible(SceneCampaignMenuState *st)
@@ -104,16 +105,8 @@ static void scene_campaign_menu_refresh(SceneCampaignMenuState *st)
     if (!st)
         return;
 
-    if (campaign_levels_scan(&st->descriptors, NULL) != 0)
-    {
-        LOG_ERROR("scene_campaign_menu", "Failed to scan campaign levels");
-        campaign_level_catalog_free(&st->catalog);
-        st->selected_index = 0;
-        st->first_visible_index = 0;
-        return;
-    }
-
-    if (campaign_level_catalog_from_descriptors(&st->descriptors, &st->catalog) != 0)
+    /* The level index is loaded once per run; later visits only re-apply progress */
+    if (campaign_level_catalog_from_index(&st->catalog) != 0)
     {
         LOG_ERROR("scene_campaign_menu", "Failed to build campaign catalog");
         campaign_level_catalog_free(&st->catalog);
@@ -165,8 +158,9 @@ void scene_campaign_menu_leave(Scene *s)
         return;
     if (s_active_state == st)
         s_active_state = NULL;
+    /* Gameplay needs the texture memory more; the disk cache brings them back quickly */
+    level_thumbs_drop_textures();
     campaign_level_catalog_free(&st->catalog);
-    campaign_levels_free(&st->descriptors);
     free(st);
 }
 
@@ -285,8 +279,14 @@ void scene_campaign_menu_handle_input(Scene *s, const struct InputState *in)
 void scene_campaign_menu_update(Scene *s, float dt)
 {
 
-    (void)s;
     (void)dt;
+    SceneCampaignMenuState *st = (SceneCampaignMenuState *)s->state;
+    if (!st || !st->svc)
+        return;
+
+    /* Previews are built one per idle frame so they never delay navigation */
+    if (app_is_idle() && level_thumbs_step(st->svc->sdl_renderer))
+        s->dirty = true;
 }
 
 void scene_campaign_menu_render(Scene *s, struct Renderer *r)
@@ -315,8 +315,8 @@ void scene_campaign_menu_render(Scene *s, struct Renderer *r)
     int box_h = 40;
 
     SDL_Texture *icons_sheet = texman_get(svc->texman, TEX_ICONS_SHEET);
-    SDL_Rect star_src_filled = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 4) : (SDL_Rect){0};
-    SDL_Rect star_src_empty = icons_sheet ? texman_sheet_src(svc->texman, TEX_ICONS_SHEET, 8) : (SDL_Rect){0};
+    SDL_Rect star_src_filled = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 4)->src : (SDL_Rect){0};
+    SDL_Rect star_src_empty = icons_sheet ? texman_sprite(svc->texman, SPR_ICON_FIRST + 8)->src : (SDL_Rect){0};
     const int star_slots = 3;
     const float star_spacing = 6.f;
     const float star_margin_right = 16.f;
@@ -421,6 +421,21 @@ void scene_campaign_menu_render(Scene *s, struct Renderer *r)
         }
     }
 
+    /* Ask for the visible rows first and the selection last so it is built first */
+    for (int i = start_index; i < end_index; ++i)
+        level_thumbs_get(st->catalog.items[i].filename);
+    SDL_Texture *thumb = level_thumbs_get(st->catalog.items[st->selected_index].filename);
+    SDL_FRect thumb_box = {
+        (float)(cx + box_w / 2 + CAMPAIGN_MENU_THUMB_GAP),
+        (float)menu_y,
+        (float)LEVEL_THUMB_W,
+        (float)LEVEL_THUMB_H};
+    if (thumb)
+        renderer_draw_texture(r, thumb, NULL, &thumb_box, 0.f);
+    else
+        renderer_draw_filled_rect(r, thumb_box, MENU_COLOR_BUTTON_DISABLED);
+    renderer_draw_rect_outline(r, thumb_box, MENU_COLOR_BUTTON_HIGHLIGHT, 2);
+
     if (end_index < st->catalog.count)
     {
 
@@ -5,7 +5,6 @@
 
 typedef struct SceneCampaignMenuState {
     struct Services *svc;
-    CampaignLevelList descriptors;
     CampaignLevelCatalog catalog;
     int selected_index;
     int first_visible_index;
@@ -2,6 +2,8 @@
 #include <stdlib.h>
 #include "../core/log.h"
 #include "../services/renderer.h"
+#include "../services/services.h"
+#include "../services/texture_manager.h"
 #include "../app/app.h"
 
 void scene_loading_enter(Scene *s) {
@@ -12,14 +14,39 @@ void scene_loading_enter(Scene *s) {
         return;
 
 }
+    st->svc = app_services();
     s->state = st;
 }
 void scene_loading_leave(Scene *s) {
     free(s->state);
 }
 void scene_loading_update(Scene *s,float dt) {
-    (void)s;(void)dt;
+    (void)dt;
+    SceneLoadingState *st = (SceneLoadingState *)s->state;
+    if (!st || !st->svc)
+        return;
+    st->progress = services_load_progress(st->svc);
+    if (services_menu_ready(st->svc))
+        app_set_scene(SCENE_MENU); /* destroys this scene; nothing may follow */
 }
 void scene_loading_render(Scene *s, struct Renderer *r) {
-    renderer_draw_text(r,"LOADING", 40,40,(TextStyle){0
-}); }
+    SceneLoadingState *st = (SceneLoadingState *)s->state;
+    if (!st || !st->svc)
+        return;
+    struct Services *svc = st->svc;
+    /* The nebula is decoded first, so it usually backs the progress bar */
+    if (texman_is_ready(svc->texman, TEX_BG_STARFIELD)) {
+        SDL_Texture *bg = texman_get(svc->texman, TEX_BG_STARFIELD);
+        SDL_FRect dst = {0, 0, (float)svc->display_w, (float)svc->display_h};
+        renderer_draw_texture(r, bg, NULL, &dst, 0);
+    }
+    float bar_w = (float)svc->display_w * 0.5f;
+    float bar_h = 12.f;
+    SDL_FRect bar = {((float)svc->display_w - bar_w) * 0.5f, (float)svc->display_h * 0.6f, bar_w, bar_h};
+    renderer_draw_text_centered(r, "LOADING", (float)svc->display_w * 0.5f, bar.y - 40.f, (TextStyle){0});
+    renderer_draw_filled_rect(r, bar, (SDL_Color){34, 34, 34, 255});
+    SDL_FRect fill = bar;
+    fill.w = bar_w * st->progress;
+    renderer_draw_filled_rect(r, fill, (SDL_Color){230, 230, 230, 255});
+    renderer_draw_rect_outline(r, bar, (SDL_Color){230, 230, 230, 255}, 1);
+}
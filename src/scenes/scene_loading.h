@@ -1,7 +1,9 @@
 #pragma once
 #include "../app/scene.h"
 
-typedef struct SceneLoadingState { struct Services *svc; const int* list; int count; int loaded; } SceneLoadingState;
+/* Boot screen: shows startup asset progress and switches to the menu once
+ * the menu's textures are uploaded (the rest keeps loading in app_update). */
+typedef struct SceneLoadingState { struct Services *svc; float progress; } SceneLoadingState;
 void scene_loading_enter(Scene *s);
 void scene_loading_leave(Scene *s);
 void scene_loading_update(Scene *s, float dt);
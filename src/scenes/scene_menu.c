@@ -188,11 +188,9 @@ void scene_menu_render(Scene *s, struct Renderer *r)
              * Save/restore the renderer blend mode around the outline draw. */
             if (st->svc && st->svc->sdl_renderer)
             {
-                SDL_BlendMode prev = SDL_BLENDMODE_BLEND;
-                SDL_GetRenderDrawBlendMode(st->svc->sdl_renderer, &prev);
-                SDL_SetRenderDrawBlendMode(st->svc->sdl_renderer, SDL_BLENDMODE_NONE);
+                SDL_BlendMode prev = renderer_set_blend_mode(r, SDL_BLENDMODE_NONE);
                 renderer_draw_rect_outline(r, box, MENU_COLOR_BUTTON_HIGHLIGHT, 2);
-                SDL_SetRenderDrawBlendMode(st->svc->sdl_renderer, prev);
+                renderer_set_blend_mode(r, prev);
             }
             else
             {
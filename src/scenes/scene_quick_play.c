@@ -9,6 +9,7 @@
 #include "../services/input.h"
 #include "../app/app.h"
 #include "../game/world.h"
+#include "../game/world_runner.h"
 #include "../game/planet.h"
 #include "../game/player.h"
 #include "../core/rand.h"
@@ -18,6 +19,7 @@
 static uint8_t enemy_difficulty[4] = {0, 110, 150, 210};
 static uint8_t enemy_count[3] = {2, 3, 3};
 
+/* May run on the simulation thread, so only flag the event here */
 static void on_world_time_over(struct World *w, void *user) {
 
     (void)w;
@@ -25,14 +27,8 @@ static void on_world_time_over(struct World *w, void *user) {
     if (!scene)
         return;
     SceneQuickPlayState *st = (SceneQuickPlayState *)scene->state;
-    if (!st || st->time_over_handled || st->player_death_handled)
-        return;
-    st->time_over_handled = 1;
-    if (st && st->world) {
-        overlay_endgame_qp_set_stats(st->world->kills, st->world->score);
-
-}
-    app_push_overlay(SCENE_OVERLAY_ENDGAME);
+    if (st)
+        st->time_over_pending = 1;
 }
 
 /* Module-level settings storage (menu writes these before starting scene) */
@@ -128,6 +124,9 @@ void scene_quick_play_enter(Scene *s) {
         /* Initial enemy placement: scenes control spawning now. */
         spawn_to_maintain(st);
         st->world->hud = hud_create(st->world->svc, st->world->player);
+#if WORLD_SIM_THREAD
+        st->runner = world_runner_create(st->world);
+#endif
 
         app_push_overlay(SCENE_OVERLAY_START_GAME);
 
@@ -136,6 +135,7 @@ void scene_quick_play_enter(Scene *s) {
 void scene_quick_play_leave(Scene *s) {
     SceneQuickPlayState *st = (SceneQuickPlayState *)s->state;
     if (st) {
+        world_runner_destroy(st->runner);
         if (st->world)
             world_destroy(st->world);
         free(st);
@@ -148,18 +148,15 @@ void scene_quick_play_handle_input(Scene *s, const struct InputState *in) {
     if (st)
         st->last_input = *in;
 }
-void scene_quick_play_update(Scene *s, float dt) {
-    SceneQuickPlayState *st = (SceneQuickPlayState *)s->state;
-    if (!st || !st->world)
-        return;
-
-    if (st->world->player)
-        player_set_input(st->world->player, &st->last_input);
-
-    if (!st->player_death_handled && !st->time_over_handled)
-        spawn_to_maintain(st);
-
-    world_update(st->world, dt);
+static void scene_quick_play_logic(SceneQuickPlayState *st, float dt) {
+    if (st->time_over_pending) {
+        st->time_over_pending = 0;
+        if (!st->time_over_handled && !st->player_death_handled) {
+            st->time_over_handled = 1;
+            overlay_endgame_qp_set_stats(st->world->kills, st->world->score);
+            app_push_overlay(SCENE_OVERLAY_ENDGAME);
+        }
+    }
 
     Player *player = st->world->player;
     if (player && !player->alive && !st->player_death_handled) {
@@ -180,11 +177,44 @@ void scene_quick_play_update(Scene *s, float dt) {
         return;
     }
 }
+void scene_quick_play_update(Scene *s, float dt) {
+    SceneQuickPlayState *st = (SceneQuickPlayState *)s->state;
+    if (!st || !st->world)
+        return;
+
+    if (st->runner) {
+        /* scene logic sees the last completed step; the next one runs while we render */
+        world_runner_lock(st->runner);
+        if (st->world->player)
+            player_set_input(st->world->player, &st->last_input);
+        if (!st->player_death_handled && !st->time_over_handled)
+            spawn_to_maintain(st);
+        scene_quick_play_logic(st, dt);
+        world_runner_unlock(st->runner);
+        world_runner_step(st->runner);
+        return;
+    }
+
+    if (st->world->player)
+        player_set_input(st->world->player, &st->last_input);
+
+    if (!st->player_death_handled && !st->time_over_handled)
+        spawn_to_maintain(st);
+
+    world_update(st->world, dt);
+    scene_quick_play_logic(st, dt);
+}
 void scene_quick_play_render(Scene *s, struct Renderer *r) {
     SceneQuickPlayState *st = (SceneQuickPlayState *)s->state;
     struct Services *svc = st->svc;
+    if (st->world) {
+        world_render_background(st->world, r);
+        if (st->runner)
+            world_runner_render(st->runner, r);
+        else
+            world_render(st->world, r);
+        return;
+    }
     SDL_Texture *bg = texman_get(svc->texman, TEX_BG_STARFIELD);
     renderer_draw_texture(r, bg, NULL, NULL, 0);
-    if (st->world)
-        world_render(st->world, r);
 }
@@ -2,6 +2,7 @@
 #include "../app/scene.h"
 #include "../services/input.h" // for InputState
 struct World;
+struct WorldRunner;
 struct Services;
 struct Renderer;
 
@@ -19,10 +20,12 @@ typedef struct QuickPlaySettings {
 typedef struct SceneQuickPlayState {
     struct Services *svc;
     struct World *world;
+    struct WorldRunner *runner; // non-NULL when the world is stepped on a worker thread
     bool show_hud_text;
     char hud_text[256];
     struct InputState last_input; // store last input for updates
     int time_over_handled; // guard
+    int time_over_pending; // set by the world callback, handled in scene update
     int player_death_handled;
     float player_death_delay;
 } SceneQuickPlayState;
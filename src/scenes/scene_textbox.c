@@ -13,6 +13,7 @@
 #include "../app/app.h"
 #include "../game/ui_prompts.h"
 #include "../core/log.h"
+#include "../core/vfs.h"
 
 #define TEXTBOX_LINE_SPACING 28.f
 #define TEXTBOX_TOP_MARGIN 130.f
@@ -100,42 +101,21 @@ static bool textbox_scene_load_file(TextboxSceneState *st)
 
     textbox_scene_clear_lines(st);
 
-    char path[512];
-#ifdef PLATFORM_VITA
-    snprintf(path, sizeof(path), "app0:/assets/%s", st->config->relative_path);
-#else
-    snprintf(path, sizeof(path), "./assets/%s", st->config->relative_path);
-#endif
-
-    FILE *file = fopen(path, "rb");
-    if (!file)
+    VfsFile file;
+    if (!vfs_open(st->config->relative_path, &file))
         return false;
 
-    if (fseek(file, 0, SEEK_END) != 0)
-    {
-        fclose(file);
-        return false;
-    }
-
-    long raw_size = ftell(file);
-    if (raw_size < 0)
-    {
-        fclose(file);
-        return false;
-    }
-    rewind(file);
-
-    size_t size = (size_t)raw_size;
-    char *buffer = (char *)malloc(size + 1);
+    size_t read_bytes = file.size;
+    char *buffer = (char *)malloc(read_bytes + 1);
     if (!buffer)
     {
         LOG_ERROR("textbox_scene", "Failed to allocate file buffer");
-        fclose(file);
+        vfs_close(&file);
         return false;
     }
 
-    size_t read_bytes = fread(buffer, 1, size, file);
-    fclose(file);
+    memcpy(buffer, file.data, read_bytes);
+    vfs_close(&file);
     buffer[read_bytes] = '\0';
 
     size_t write_idx = 0;
@@ -198,13 +178,12 @@ static void textbox_scene_draw_caret(Renderer *r, float cx, float y, double angl
     if (!renderer_get_text_texture(r, "^", (TextStyle){0}, &texture, &size) || !texture)
         return;
 
-    SDL_Rect dst = {
-        (int)(cx - size.x * 0.5f),
-        (int)y,
-        size.x,
-        size.y};
-    SDL_Point center = {size.x / 2, size.y / 2};
-    SDL_RenderCopyEx(r->sdl, texture, NULL, &dst, angle_deg, &center, SDL_FLIP_NONE);
+    SDL_FRect dst = {
+        (float)(int)(cx - size.x * 0.5f),
+        (float)(int)y,
+        (float)size.x,
+        (float)size.y};
+    renderer_draw_texture(r, texture, NULL, &dst, (float)angle_deg);
 }
 
 static void textbox_scene_ensure_visible(TextboxSceneState *st, int visible_lines)
@@ -6,6 +6,43 @@
 
 #include "../core/log.h"
 
+/* Decoding only: playback is started from the main thread in audio_update. */
+static int audio_load_thread(void *user) {
+    struct Audio *audio = user;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+
+    char music_path[512];
+    snprintf(music_path, sizeof(music_path), "%s/audio/bg_loop.ogg", audio->assets_root);
+    char player_shot_path[512];
+    snprintf(player_shot_path, sizeof(player_shot_path), "%s/audio/shot.ogg", audio->assets_root);
+    char enemy_shot_path[512];
+    snprintf(enemy_shot_path, sizeof(enemy_shot_path), "%s/audio/shot2.ogg", audio->assets_root);
+
+    audio->bg_music = Mix_LoadMUS(music_path);
+    if (!audio->bg_music) {
+        LOG_ERROR("audio", "Failed to load background music '%s': %s", music_path, Mix_GetError());
+    }
+
+    audio->player_shot = Mix_LoadWAV(player_shot_path);
+    if (!audio->player_shot) {
+        LOG_ERROR("audio", "Failed to load player shot sound '%s': %s", player_shot_path, Mix_GetError());
+    } else {
+        Mix_VolumeChunk(audio->player_shot, (int)(MIX_MAX_VOLUME * 0.5f));
+    }
+
+    audio->enemy_shot = Mix_LoadWAV(enemy_shot_path);
+    if (!audio->enemy_shot) {
+        LOG_ERROR("audio", "Failed to load enemy shot sound '%s': %s", enemy_shot_path, Mix_GetError());
+    } else {
+        Mix_VolumeChunk(audio->enemy_shot, (int)(MIX_MAX_VOLUME * 0.4f));
+    }
+
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    LOG_INFO("audio", "Sounds decoded in %.1f ms", ms);
+    SDL_AtomicSet(&audio->ready, 1);
+    return 0;
+}
+
 struct Audio *audio_create(const char *assets_root) {
     if (!assets_root) {
         LOG_ERROR("audio", "Missing assets root path");
@@ -39,36 +76,11 @@ struct Audio *audio_create(const char *assets_root) {
 
     Mix_VolumeMusic((int)(MIX_MAX_VOLUME * 0.7f));
 
-    char music_path[512];
-    snprintf(music_path, sizeof(music_path), "%s/audio/bg_loop.ogg", assets_root);
-    char player_shot_path[512];
-    snprintf(player_shot_path, sizeof(player_shot_path), "%s/audio/shot.ogg", assets_root);
-    char enemy_shot_path[512];
-    snprintf(enemy_shot_path, sizeof(enemy_shot_path), "%s/audio/shot2.ogg", assets_root);
-
-    audio->bg_music = Mix_LoadMUS(music_path);
-    if (!audio->bg_music) {
-        LOG_ERROR("audio", "Failed to load background music '%s': %s", music_path, Mix_GetError());
-    } else {
-        if (Mix_PlayMusic(audio->bg_music, -1) != 0) {
-            LOG_ERROR("audio", "Failed to start background music: %s", Mix_GetError());
-        } else {
-            LOG_INFO("audio", "Background music started from '%s'", music_path);
-        }
-    }
-
-    audio->player_shot = Mix_LoadWAV(player_shot_path);
-    if (!audio->player_shot) {
-        LOG_ERROR("audio", "Failed to load player shot sound '%s': %s", player_shot_path, Mix_GetError());
-    } else {
-        Mix_VolumeChunk(audio->player_shot, (int)(MIX_MAX_VOLUME * 0.5f));
-    }
-
-    audio->enemy_shot = Mix_LoadWAV(enemy_shot_path);
-    if (!audio->enemy_shot) {
-        LOG_ERROR("audio", "Failed to load enemy shot sound '%s': %s", enemy_shot_path, Mix_GetError());
-    } else {
-        Mix_VolumeChunk(audio->enemy_shot, (int)(MIX_MAX_VOLUME * 0.4f));
+    snprintf(audio->assets_root, sizeof(audio->assets_root), "%s", assets_root);
+    audio->loader = SDL_CreateThread(audio_load_thread, "audio_load", audio);
+    if (!audio->loader) {
+        LOG_WARN("audio", "Loading sounds on the main thread: %s", SDL_GetError());
+        audio_load_thread(audio);
     }
 
     return audio;
@@ -79,6 +91,11 @@ void audio_destroy(struct Audio *audio) {
         return;
     }
 
+    if (audio->loader) {
+        SDL_WaitThread(audio->loader, NULL);
+        audio->loader = NULL;
+    }
+
     Mix_HaltMusic();
 
     if (audio->player_shot) {
@@ -102,8 +119,35 @@ void audio_destroy(struct Audio *audio) {
     free(audio);
 }
 
+void audio_wait_loaded(struct Audio *audio) {
+    if (audio && audio->loader) {
+        SDL_WaitThread(audio->loader, NULL);
+        audio->loader = NULL;
+    }
+}
+
+int audio_update(struct Audio *audio) {
+    if (!audio || !SDL_AtomicGet(&audio->ready))
+        return 0;
+    if (audio->started)
+        return 1;
+    if (audio->loader) {
+        SDL_WaitThread(audio->loader, NULL);
+        audio->loader = NULL;
+    }
+    audio->started = 1;
+    if (audio->bg_music) {
+        if (Mix_PlayMusic(audio->bg_music, -1) != 0) {
+            LOG_ERROR("audio", "Failed to start background music: %s", Mix_GetError());
+        } else {
+            LOG_INFO("audio", "Background music started");
+        }
+    }
+    return 1;
+}
+
 void audio_play_shot(struct Audio *audio, int is_player) {
-    if (!audio)
+    if (!audio || !SDL_AtomicGet(&audio->ready))
         return;
     Mix_Chunk *chunk = is_player ? audio->player_shot : audio->enemy_shot;
     if (!chunk)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
 
 struct Audio {
@@ -8,8 +9,18 @@ struct Audio {
     Mix_Chunk *enemy_shot;
     int mix_init_flags;
     int audio_opened;
+    char assets_root[256];
+    SDL_Thread *loader;   /* decodes music + chunks; joined by audio_update */
+    SDL_atomic_t ready;   /* set by the loader once the fields above are filled */
+    int started;
 };
 
+/* Opens the device and starts decoding the sound assets in the background. */
 struct Audio *audio_create(const char *assets_root);
 void audio_destroy(struct Audio *audio);
+/* Main thread, once per frame: starts the music when the loader has finished.
+ * Returns 1 once all sounds are loaded. */
+int audio_update(struct Audio *audio);
+/* Block until the sounds are decoded (joins the loader) */
+void audio_wait_loaded(struct Audio *audio);
 void audio_play_shot(struct Audio *audio, int is_player);
@@ -0,0 +1,274 @@
+#include "explosion_gen.h"
+#include <SDL2/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include "../core/fs.h"
+#include "../core/rand.h"
+
+#define EXPLOSION_CACHE_MAGIC "GHEX"
+#define EXPLOSION_SPOTS 20
+#define EXPLOSION_MAX_THREADS 4
+#define EXPLOSION_STRIP_W (EXPLOSION_GEN_TILE * EXPLOSION_GEN_FRAMES)
+#define EXPLOSION_STRIP_PIXELS ((size_t)EXPLOSION_STRIP_W * EXPLOSION_GEN_TILE)
+
+typedef struct ExplosionConfig {
+    float r, g, b, density, inner, fade;
+} ExplosionConfig;
+
+static const ExplosionConfig EXPLOSION_CONFIGS[EXPLOSION_GEN_TYPES] = {
+    {1.0f, 0.6f, 0.1f, 1.2f, 0.9f, 0.4f}, // orange
+    {0.2f, 0.4f, 1.0f, 1.0f, 0.8f, 0.4f}, // blue
+    {0.3f, 1.0f, 0.2f, 0.8f, 0.7f, 0.4f}, // green
+    {1.0f, 0.2f, 0.1f, 1.4f, 1.0f, 0.4f}  // red
+};
+
+/* Everything that is shared by all frames of a type */
+typedef struct ExplosionTypeData {
+    int type;
+    ExplosionConfig c;
+    float spot_x[EXPLOSION_SPOTS], spot_y[EXPLOSION_SPOTS], spot_int[EXPLOSION_SPOTS];
+    /* per-column sin/cos tables; the 2D noise terms are rebuilt per row with
+     * sin(a+b) = sin a cos b + cos a sin b */
+    float p_sin[EXPLOSION_GEN_TILE], p_cos[EXPLOSION_GEN_TILE];   // particle: 0.3x / 0.25x
+    float s_sin[EXPLOSION_GEN_TILE], s_cos[EXPLOSION_GEN_TILE];   // smoke: 0.03x / 0.04x
+    float p_sin_c[EXPLOSION_GEN_TILE], p_cos_s[EXPLOSION_GEN_TILE];
+    float s_sin_c[EXPLOSION_GEN_TILE], s_cos_s[EXPLOSION_GEN_TILE];
+    uint32_t *pixels;
+} ExplosionTypeData;
+
+typedef struct ExplosionJob {
+    const ExplosionTypeData *td;
+    int frame0, frame1;
+} ExplosionJob;
+
+static inline uint32_t px_make(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    return ((uint32_t)a << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+static inline uint8_t px_channel(float v) {
+    return (uint8_t)(v > 255.f ? 255.f : v);
+}
+
+static void explosion_frame(const ExplosionTypeData *td, int frame) {
+    const int size = EXPLOSION_GEN_TILE;
+    const int total = EXPLOSION_GEN_FRAMES;
+    const int center = size / 2;
+    const ExplosionConfig *c = &td->c;
+    float fp = (float)frame / (float)(total - 1);
+    float max_radius = center * 0.9f;
+    float ring_radius = max_radius * (0.1f + fp * 0.9f);
+    float ring_thickness = max_radius * (0.5f - fp * 0.3f);
+    float spot_r = max_radius * 0.15f * (1.f + fp * 0.8f);
+    float ring_gain = c->inner * (1.f - fp * 0.6f);
+    float spot_gain = c->density * (1.f - fp * 0.5f);
+    float particle_gain = c->density * (1.f - fp * 0.7f) * 0.4f;
+    bool has_core = frame < total / 3;
+    float core_gain = has_core ? c->inner * (1.f - (float)frame / (float)(total / 3)) : 0.f;
+    bool has_smoke = frame > total / 4;
+    float smoke_gain = has_smoke ? 0.3f * ((float)(frame - total / 4) / (float)(total - total / 4)) : 0.f;
+
+    float dist[EXPLOSION_GEN_TILE];
+    float intensity[EXPLOSION_GEN_TILE];
+    uint32_t *base = td->pixels + frame * size;
+
+    for (int y = 0; y < size; y++) {
+        float dy = (float)y - center;
+        for (int x = 0; x < size; x++) {
+            float dx = (float)x - center;
+            dist[x] = sqrtf(dx * dx + dy * dy);
+            intensity[x] = 0.f;
+        }
+
+        /* expanding ring */
+        for (int x = 0; x < size; x++) {
+            float rf = 1.f - fabsf(dist[x] - ring_radius) / ring_thickness;
+            if (rf > 0.f)
+                intensity[x] += powf(rf, 0.8f) * ring_gain;
+        }
+        /* bright core in the first frames */
+        if (has_core) {
+            float core_r = ring_radius * 0.7f;
+            for (int x = 0; x < size; x++)
+                if (dist[x] < core_r)
+                    intensity[x] += (1.f - dist[x] / core_r) * core_gain;
+        }
+        /* glowing spots: only visit the columns each spot actually covers */
+        for (int i = 0; i < EXPLOSION_SPOTS; i++) {
+            float sy = (float)y - td->spot_y[i];
+            float half2 = spot_r * spot_r - sy * sy;
+            if (half2 <= 0.f)
+                continue;
+            float half = sqrtf(half2);
+            int x0 = (int)ceilf(td->spot_x[i] - half);
+            int x1 = (int)floorf(td->spot_x[i] + half);
+            if (x0 < 0)
+                x0 = 0;
+            if (x1 > size - 1)
+                x1 = size - 1;
+            for (int x = x0; x <= x1; x++) {
+                float sx = (float)x - td->spot_x[i];
+                float sd = sqrtf(sx * sx + sy * sy);
+                if (sd < spot_r)
+                    intensity[x] += td->spot_int[i] * powf(1.f - sd / spot_r, 1.2f) * spot_gain;
+            }
+        }
+        /* particle sparkle + smoke, both from separable trig tables */
+        float py_s = sinf(y * 0.21f), py_c = cosf(y * 0.21f);
+        float qy_s = sinf(y * 0.175f), qy_c = cosf(y * 0.175f);
+        float sy_s = sinf(y * 0.05f), sy_c = cosf(y * 0.05f);
+        float ty_s = sinf(y * 0.06f), ty_c = cosf(y * 0.06f);
+        for (int x = 0; x < size; x++) {
+            float d = dist[x];
+            if (d < ring_radius * 1.3f && d > ring_radius * 0.2f) {
+                float s3 = td->p_sin[x] * py_c + td->p_sin_c[x] * py_s;  // sin(0.3x + 0.21y)
+                float c25 = td->p_cos[x] * qy_c - td->p_cos_s[x] * qy_s; // cos(0.25x + 0.175y)
+                float pn = 0.5f + 0.5f * s3 * c25;
+                if (pn > 0.6f) {
+                    float df = 1.f - fabsf(d - ring_radius) / (ring_radius * 0.8f);
+                    if (df > 0.f)
+                        intensity[x] += (pn - 0.6f) / 0.4f * df * particle_gain;
+                }
+            }
+            if (has_smoke && d > ring_radius * 0.7f && d < max_radius * 1.4f) {
+                float smoke_factor = 1.f - (d - ring_radius * 0.7f) / (max_radius * 0.7f);
+                if (smoke_factor > 0.f) {
+                    float sn_s = td->s_sin[x] * sy_c + td->s_sin_c[x] * sy_s;  // sin(0.03x + 0.05y)
+                    float sn_c = td->s_cos[x] * ty_c + td->s_cos_s[x] * ty_s;  // cos(0.04x - 0.06y)
+                    float sn = 0.5f + 0.5f * sn_s * sn_c;
+                    if (sn > 0.4f)
+                        intensity[x] += smoke_factor * (sn - 0.4f) / 0.6f * smoke_gain;
+                }
+            }
+        }
+
+        uint32_t *row = base + (size_t)y * EXPLOSION_STRIP_W;
+        for (int x = 0; x < size; x++) {
+            float in = intensity[x];
+            if (in <= 0.01f) {
+                row[x] = 0;
+                continue;
+            }
+            if (in > 1.f)
+                in = 1.f;
+            float sat_boost = 1.f + in * 0.2f;
+            float heat = in * (1.f - fp * 0.4f);
+            row[x] = px_make(px_channel(255 * in * c->r * sat_boost * (0.8f + heat * 0.2f)),
+                             px_channel(255 * in * c->g * sat_boost * (0.6f + heat * 0.4f)),
+                             px_channel(255 * in * c->b * sat_boost * (0.4f + heat * 0.6f)),
+                             px_channel(255 * in * (1.f - fp * 0.3f)));
+        }
+    }
+}
+
+static int explosion_job(void *user) {
+    ExplosionJob *job = (ExplosionJob *)user;
+    for (int f = job->frame0; f < job->frame1; f++)
+        explosion_frame(job->td, f);
+    return 0;
+}
+
+bool explosion_gen_type(int type, uint32_t *pixels, int threads) {
+    if (!pixels || type < 0 || type >= EXPLOSION_GEN_TYPES)
+        return false;
+
+    ExplosionTypeData td;
+    memset(&td, 0, sizeof(td));
+    td.type = type;
+    td.c = EXPLOSION_CONFIGS[type];
+    td.pixels = pixels;
+
+    const int center = EXPLOSION_GEN_TILE / 2;
+    const float max_radius = center * 0.9f;
+    Rng rng;
+    rng_seed(&rng, (u32)(type * 1337 + 1));
+    for (int i = 0; i < EXPLOSION_SPOTS; i++) {
+        float ang = rng_rangef(&rng, 0.f, 6.2831853f);
+        float rad = rng_rangef(&rng, 0.f, max_radius * 0.8f);
+        td.spot_x[i] = (float)(center + (int)(cosf(ang) * rad));
+        td.spot_y[i] = (float)(center + (int)(sinf(ang) * rad));
+        td.spot_int[i] = rng_rangef(&rng, 0.3f, 1.0f);
+    }
+    for (int x = 0; x < EXPLOSION_GEN_TILE; x++) {
+        td.p_sin[x] = sinf(x * 0.3f);
+        td.p_sin_c[x] = cosf(x * 0.3f);
+        td.p_cos[x] = cosf(x * 0.25f);
+        td.p_cos_s[x] = sinf(x * 0.25f);
+        td.s_sin[x] = sinf(x * 0.03f);
+        td.s_sin_c[x] = cosf(x * 0.03f);
+        td.s_cos[x] = cosf(x * 0.04f);
+        td.s_cos_s[x] = sinf(x * 0.04f);
+    }
+
+    if (threads <= 0)
+        threads = SDL_GetCPUCount();
+    if (threads < 1)
+        threads = 1;
+    if (threads > EXPLOSION_MAX_THREADS)
+        threads = EXPLOSION_MAX_THREADS;
+
+    ExplosionJob jobs[EXPLOSION_MAX_THREADS];
+    SDL_Thread *workers[EXPLOSION_MAX_THREADS] = {0};
+    for (int i = 0; i < threads; i++) {
+        jobs[i].td = &td;
+        jobs[i].frame0 = EXPLOSION_GEN_FRAMES * i / threads;
+        jobs[i].frame1 = EXPLOSION_GEN_FRAMES * (i + 1) / threads;
+    }
+    for (int i = 1; i < threads; i++) {
+        workers[i] = SDL_CreateThread(explosion_job, "explosion_gen", &jobs[i]);
+        if (!workers[i])
+            explosion_job(&jobs[i]);
+    }
+    explosion_job(&jobs[0]);
+    for (int i = 1; i < threads; i++)
+        if (workers[i])
+            SDL_WaitThread(workers[i], NULL);
+    return true;
+}
+
+/* ---------------- Cache ---------------------------------------------------- */
+
+typedef struct ExplosionCacheHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t type;
+    uint16_t tile;
+    uint16_t frames;
+} ExplosionCacheHeader;
+
+static void explosion_cache_path(int type, char *buf, size_t len) {
+    snprintf(buf, len, "%s/explosion_v%d_t%d.bin", fs_cache_dir(), EXPLOSION_GEN_VERSION, type);
+}
+
+bool explosion_cache_load(int type, uint32_t *pixels) {
+    if (!pixels)
+        return false;
+    char path[256];
+    explosion_cache_path(type, path, sizeof(path));
+    FsMapping map;
+    if (!fs_map_file(path, &map))
+        return false;
+    const ExplosionCacheHeader *hdr = (const ExplosionCacheHeader *)map.data;
+    bool ok = map.size == sizeof(*hdr) + EXPLOSION_STRIP_PIXELS * sizeof(uint32_t) &&
+              memcmp(hdr->magic, EXPLOSION_CACHE_MAGIC, 4) == 0 && hdr->version == EXPLOSION_GEN_VERSION &&
+              hdr->type == type && hdr->tile == EXPLOSION_GEN_TILE && hdr->frames == EXPLOSION_GEN_FRAMES;
+    if (ok)
+        memcpy(pixels, (const uint8_t *)map.data + sizeof(*hdr), EXPLOSION_STRIP_PIXELS * sizeof(uint32_t));
+    fs_unmap_file(&map);
+    return ok;
+}
+
+bool explosion_cache_store(int type, const uint32_t *pixels) {
+    if (!pixels)
+        return false;
+    ExplosionCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, EXPLOSION_CACHE_MAGIC, 4);
+    hdr.version = EXPLOSION_GEN_VERSION;
+    hdr.type = (uint16_t)type;
+    hdr.tile = EXPLOSION_GEN_TILE;
+    hdr.frames = EXPLOSION_GEN_FRAMES;
+    char path[256];
+    explosion_cache_path(type, path, sizeof(path));
+    return fs_write_file_atomic(path, &hdr, sizeof(hdr), pixels, EXPLOSION_STRIP_PIXELS * sizeof(uint32_t));
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#define EXPLOSION_GEN_TYPES 4
+#define EXPLOSION_GEN_FRAMES 12
+#define EXPLOSION_GEN_TILE 64
+/* Bump whenever the generator output changes so stale cache files are ignored */
+#define EXPLOSION_GEN_VERSION 1
+
+/**
+ * @brief Generate all frames of one explosion type as a horizontal strip
+ *
+ * Deterministic: uses a private RNG seeded from the type, never rand().
+ * Frames are spread over worker threads; rows are evaluated as flat passes
+ * with separable trig tables so the inner loops stay branch-light.
+ * @param type Explosion type (0..EXPLOSION_GEN_TYPES-1)
+ * @param pixels ARGB8888 destination, EXPLOSION_GEN_FRAMES*TILE x TILE, tightly packed
+ * @param threads Worker count (0 = one per CPU core)
+ * @return true on success
+ */
+bool explosion_gen_type(int type, uint32_t *pixels, int threads);
+
+/**
+ * @brief Load one type's strip from the cache directory
+ * @param type Explosion type
+ * @param pixels Destination strip (see explosion_gen_type)
+ * @return true on cache hit
+ */
+bool explosion_cache_load(int type, uint32_t *pixels);
+
+/**
+ * @brief Store one type's strip in the cache directory
+ * @param type Explosion type
+ * @param pixels Strip to store
+ * @return true on success
+ */
+bool explosion_cache_store(int type, const uint32_t *pixels);
@@ -189,3 +189,13 @@ void input_poll(Input *in, InputState *out) {
     repeat_update_interval(&in->rpt_menu_left, nav_left_now, now, MENU_REPEAT_DELAY_MS, MENU_REPEAT_INTERVAL_MS, &out->menu_left);
     repeat_update_interval(&in->rpt_menu_right, nav_right_now, now, MENU_REPEAT_DELAY_MS, MENU_REPEAT_INTERVAL_MS, &out->menu_right);
 }
+
+bool input_state_any(const InputState *s) {
+    if (!s)
+        return false;
+    return s->move_up || s->move_down || s->move_left || s->move_right ||
+           s->speed_up || s->speed_down || s->turn_left || s->turn_right ||
+           s->menu_up || s->menu_down || s->menu_left || s->menu_right ||
+           s->fire || s->pause || s->confirm || s->back || s->button_triangle ||
+           s->mod_small || s->mod_large || s->boost || s->stick_active;
+}
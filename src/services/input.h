@@ -38,3 +38,5 @@ typedef struct Input {
 Input *input_create(void);
 void input_destroy(Input *in);
 void input_poll(Input *in, InputState *out);
+// True if any button is held or the stick is outside its deadzone
+bool input_state_any(const InputState *s);
@@ -0,0 +1,323 @@
+#include "nebula.h"
+#include <SDL2/SDL.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../core/log.h"
+#include "../core/rand.h"
+
+#define NEBULA_CACHE_MAGIC "GHNB"
+#define NEBULA_MAX_CENTERS 8
+#define NEBULA_MAX_THREADS 8
+#define NEBULA_STARS 600
+
+typedef struct NebulaCacheHeader {
+    char magic[4];
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t seed;
+    uint32_t width;
+    uint32_t height;
+} NebulaCacheHeader;
+
+typedef struct NebulaCenter {
+    float x, y, intensity, inv_radius;
+    float wr, wg, wb; /* colour mix of this center */
+} NebulaCenter;
+
+typedef struct NebulaParams {
+    int w, h;
+    int num_centers;
+    NebulaCenter centers[NEBULA_MAX_CENTERS];
+    float *sin_lut, *cos_lut_x, *cos_lut_y;
+    uint32_t *pixels;
+} NebulaParams;
+
+typedef struct NebulaBand {
+    const NebulaParams *p;
+    int y0, y1;
+    bool ok;
+} NebulaBand;
+
+/* r, g, b weights for the five colour types: blue, purple, dark red, cyan, violet */
+static const float NEBULA_COLOURS[5][3] = {
+    {0.05f, 0.15f, 0.85f},
+    {0.70f, 0.10f, 0.80f},
+    {0.90f, 0.05f, 0.20f},
+    {0.10f, 0.60f, 0.80f},
+    {0.50f, 0.05f, 0.90f},
+};
+
+static SDL_atomic_t g_cancel;
+static SDL_Thread *g_prepare_thread = NULL;
+
+static inline float fast_exp(float x) {
+    union {
+        uint32_t i;
+        float f;
+    } u;
+    u.i = (uint32_t)(12102203 * x + 1065353216);
+    return u.f;
+}
+
+static inline uint32_t make_color(uint8_t r8, uint8_t g8, uint8_t b8, uint8_t a8) {
+    return ((uint32_t)a8 << 24) | ((uint32_t)r8 << 16) | ((uint32_t)g8 << 8) | b8;
+}
+
+/* One row, structure-of-arrays: every loop below is a straight pass over x */
+static void nebula_row(const NebulaParams *p, int y, float *scratch) {
+    const int w = p->w;
+    float *noise = scratch;
+    float *total = scratch + w;
+    float *red = scratch + 2 * w;
+    float *green = scratch + 3 * w;
+    float *blue = scratch + 4 * w;
+
+    float row_noise = sinf(y * 0.012f);
+    float cy = p->cos_lut_y[y];
+    for (int x = 0; x < w; x++) {
+        noise[x] = 1.0f + 0.25f * p->sin_lut[x] * row_noise * p->cos_lut_x[x] * cy;
+        total[x] = red[x] = green[x] = blue[x] = 0.f;
+    }
+    for (int c = 0; c < p->num_centers; c++) {
+        const NebulaCenter *ce = &p->centers[c];
+        float dy = y - ce->y;
+        float dy2 = dy * dy;
+        for (int x = 0; x < w; x++) {
+            float dx = x - ce->x;
+            float dist = sqrtf(dx * dx + dy2);
+            float falloff = fast_exp(-dist * ce->inv_radius) * ce->intensity * noise[x];
+            total[x] += falloff;
+            red[x] += falloff * ce->wr;
+            green[x] += falloff * ce->wg;
+            blue[x] += falloff * ce->wb;
+        }
+    }
+    const float base_intensity = 0.08f;
+    uint32_t *out = p->pixels + (size_t)y * w;
+    for (int x = 0; x < w; x++) {
+        float r = fminf((red[x] + base_intensity) * 85.0f, 120.0f);
+        float g = fminf((green[x] + base_intensity * 0.5f) * 60.0f, 80.0f);
+        float b = fminf((blue[x] + base_intensity) * 100.0f, 140.0f);
+        float a = fminf((total[x] + base_intensity) * 200.0f + 40.0f, 200.0f);
+        out[x] = make_color((uint8_t)r, (uint8_t)g, (uint8_t)b, (uint8_t)a);
+    }
+}
+
+static int nebula_band(void *user) {
+    NebulaBand *band = (NebulaBand *)user;
+    float *scratch = malloc(sizeof(float) * 5 * (size_t)band->p->w);
+    if (!scratch)
+        return 0;
+    for (int y = band->y0; y < band->y1; y++) {
+        if (SDL_AtomicGet(&g_cancel))
+            break;
+        nebula_row(band->p, y, scratch);
+    }
+    free(scratch);
+    band->ok = !SDL_AtomicGet(&g_cancel);
+    return 0;
+}
+
+bool nebula_generate(uint32_t seed, uint32_t *pixels, int w, int h, int threads) {
+    if (!pixels || w <= 0 || h <= 0)
+        return false;
+
+    NebulaParams p;
+    memset(&p, 0, sizeof(p));
+    p.w = w;
+    p.h = h;
+    p.pixels = pixels;
+
+    /* Private RNG so the background generator never disturbs rand() users */
+    Rng rng;
+    rng_seed(&rng, seed);
+    p.num_centers = rng_rangei(&rng, 5, 8);
+    for (int i = 0; i < p.num_centers; i++) {
+        NebulaCenter *c = &p.centers[i];
+        c->x = (float)rng_rangei(&rng, 0, w - 1);
+        c->y = (float)rng_rangei(&rng, 0, h - 1);
+        c->intensity = rng_rangef(&rng, 0.4f, 0.9f);
+        const float *mix = NEBULA_COLOURS[rng_rangei(&rng, 0, 4)];
+        c->wr = mix[0];
+        c->wg = mix[1];
+        c->wb = mix[2];
+        c->inv_radius = 1.f / (120.f + (float)rng_rangei(&rng, 0, 79));
+    }
+
+    p.sin_lut = malloc(sizeof(float) * (size_t)w);
+    p.cos_lut_x = malloc(sizeof(float) * (size_t)w);
+    p.cos_lut_y = malloc(sizeof(float) * (size_t)h);
+    if (!p.sin_lut || !p.cos_lut_x || !p.cos_lut_y) {
+        free(p.sin_lut);
+        free(p.cos_lut_x);
+        free(p.cos_lut_y);
+        return false;
+    }
+    for (int x = 0; x < w; x++) {
+        p.sin_lut[x] = sinf(x * 0.015f);
+        p.cos_lut_x[x] = cosf(x * 0.018f);
+    }
+    for (int y = 0; y < h; y++)
+        p.cos_lut_y[y] = cosf(y * 0.014f);
+
+    if (threads <= 0)
+        threads = SDL_GetCPUCount();
+    if (threads < 1)
+        threads = 1;
+    if (threads > NEBULA_MAX_THREADS)
+        threads = NEBULA_MAX_THREADS;
+    if (threads > h)
+        threads = h;
+
+    NebulaBand bands[NEBULA_MAX_THREADS];
+    SDL_Thread *workers[NEBULA_MAX_THREADS] = {0};
+    for (int i = 0; i < threads; i++) {
+        bands[i].p = &p;
+        bands[i].y0 = h * i / threads;
+        bands[i].y1 = h * (i + 1) / threads;
+        bands[i].ok = false;
+    }
+    /* The calling thread takes band 0; a failed thread start falls back to inline */
+    for (int i = 1; i < threads; i++) {
+        workers[i] = SDL_CreateThread(nebula_band, "nebula", &bands[i]);
+        if (!workers[i])
+            nebula_band(&bands[i]);
+    }
+    nebula_band(&bands[0]);
+    bool ok = true;
+    for (int i = 0; i < threads; i++) {
+        if (workers[i])
+            SDL_WaitThread(workers[i], NULL);
+        ok = ok && bands[i].ok;
+    }
+    free(p.sin_lut);
+    free(p.cos_lut_x);
+    free(p.cos_lut_y);
+    if (!ok)
+        return false;
+
+    for (int i = 0; i < NEBULA_STARS; i++) {
+        int sx = rng_rangei(&rng, 0, w - 1);
+        int sy = rng_rangei(&rng, 0, h - 1);
+        uint8_t bright = (uint8_t)rng_rangei(&rng, 120, 205);
+        pixels[sy * (size_t)w + sx] = make_color(bright, bright, bright, 255);
+    }
+    return true;
+}
+
+/* ---------------- Cache ---------------------------------------------------- */
+
+static void nebula_cache_path(uint32_t seed, char *buf, size_t len) {
+    snprintf(buf, len, "%s/nebula_v%d_%08x.bin", fs_cache_dir(), NEBULA_GEN_VERSION, (unsigned)seed);
+}
+
+static void nebula_pending_path(char *buf, size_t len) {
+    snprintf(buf, len, "%s/nebula_next.bin", fs_cache_dir());
+}
+
+bool nebula_cache_load(uint32_t seed, int w, int h, FsMapping *map, const uint32_t **out_pixels) {
+    if (!map || !out_pixels)
+        return false;
+    char path[256];
+    nebula_cache_path(seed, path, sizeof(path));
+    if (!fs_map_file(path, map))
+        return false;
+    const NebulaCacheHeader *hdr = (const NebulaCacheHeader *)map->data;
+    size_t expected = sizeof(NebulaCacheHeader) + (size_t)w * (size_t)h * sizeof(uint32_t);
+    if (map->size != expected || memcmp(hdr->magic, NEBULA_CACHE_MAGIC, 4) != 0 ||
+        hdr->version != NEBULA_GEN_VERSION || hdr->seed != seed ||
+        hdr->width != (uint32_t)w || hdr->height != (uint32_t)h) {
+        LOG_WARN("nebula", "Ignoring stale cache file %s", path);
+        fs_unmap_file(map);
+        return false;
+    }
+    *out_pixels = (const uint32_t *)((const uint8_t *)map->data + sizeof(NebulaCacheHeader));
+    return true;
+}
+
+bool nebula_cache_store(uint32_t seed, const uint32_t *pixels, int w, int h) {
+    if (!pixels || w <= 0 || h <= 0)
+        return false;
+    NebulaCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, NEBULA_CACHE_MAGIC, 4);
+    hdr.version = NEBULA_GEN_VERSION;
+    hdr.seed = seed;
+    hdr.width = (uint32_t)w;
+    hdr.height = (uint32_t)h;
+    char path[256];
+    nebula_cache_path(seed, path, sizeof(path));
+    return fs_write_file_atomic(path, &hdr, sizeof(hdr), pixels, (size_t)w * (size_t)h * sizeof(uint32_t));
+}
+
+void nebula_cache_remove(uint32_t seed) {
+    char path[256];
+    nebula_cache_path(seed, path, sizeof(path));
+    remove(path);
+}
+
+uint32_t nebula_cache_pending_seed(void) {
+    char path[256];
+    nebula_pending_path(path, sizeof(path));
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return 0;
+    uint32_t seed = 0;
+    if (fread(&seed, sizeof(seed), 1, f) != 1)
+        seed = 0;
+    fclose(f);
+    remove(path);
+    return seed;
+}
+
+typedef struct NebulaPrepareJob {
+    uint32_t seed;
+    int w, h;
+} NebulaPrepareJob;
+
+static int nebula_prepare_thread(void *user) {
+    NebulaPrepareJob job = *(NebulaPrepareJob *)user;
+    free(user);
+    SDL_SetThreadPriority(SDL_THREAD_PRIORITY_LOW);
+
+    uint32_t *px = malloc((size_t)job.w * (size_t)job.h * sizeof(uint32_t));
+    if (!px)
+        return 0;
+    /* Single band: this only has to be ready by the next launch */
+    if (nebula_generate(job.seed, px, job.w, job.h, 1) && nebula_cache_store(job.seed, px, job.w, job.h)) {
+        char path[256];
+        nebula_pending_path(path, sizeof(path));
+        if (!fs_write_file_atomic(path, NULL, 0, &job.seed, sizeof(job.seed)))
+            nebula_cache_remove(job.seed);
+    }
+    free(px);
+    return 0;
+}
+
+void nebula_prepare_next(uint32_t seed, int w, int h) {
+    if (g_prepare_thread || seed == 0)
+        return;
+    NebulaPrepareJob *job = malloc(sizeof(*job));
+    if (!job)
+        return;
+    job->seed = seed;
+    job->w = w;
+    job->h = h;
+    SDL_AtomicSet(&g_cancel, 0);
+    g_prepare_thread = SDL_CreateThread(nebula_prepare_thread, "nebula_next", job);
+    if (!g_prepare_thread) {
+        LOG_WARN("nebula", "Failed to start background generator: %s", SDL_GetError());
+        free(job);
+    }
+}
+
+void nebula_prepare_shutdown(void) {
+    if (!g_prepare_thread)
+        return;
+    SDL_AtomicSet(&g_cancel, 1);
+    SDL_WaitThread(g_prepare_thread, NULL);
+    g_prepare_thread = NULL;
+    SDL_AtomicSet(&g_cancel, 0);
+}
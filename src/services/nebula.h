@@ -0,0 +1,65 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../core/fs.h"
+
+/* Bump whenever the generator output for a given seed changes so stale cache files are ignored */
+#define NEBULA_GEN_VERSION 1
+
+/**
+ * @brief Generate the nebula background into an ARGB8888 buffer
+ *
+ * Rows are split into bands and generated on worker threads; the per-row
+ * inner loops work on flat float arrays so the compiler can vectorize them.
+ * Output depends only on seed, w and h.
+ * @param seed Nebula seed
+ * @param pixels Destination, w*h pixels, tightly packed
+ * @param w Width
+ * @param h Height
+ * @param threads Worker count (0 = one per CPU core)
+ * @return true on success, false on allocation failure or cancellation
+ */
+bool nebula_generate(uint32_t seed, uint32_t *pixels, int w, int h, int threads);
+
+/**
+ * @brief Map a cached nebula
+ * @param seed Nebula seed
+ * @param w Expected width
+ * @param h Expected height
+ * @param map Mapping to release with fs_unmap_file() once the pixels were uploaded
+ * @param out_pixels Receives a pointer into the mapping
+ * @return true on cache hit
+ */
+bool nebula_cache_load(uint32_t seed, int w, int h, FsMapping *map, const uint32_t **out_pixels);
+
+/**
+ * @brief Store a finished nebula in the cache directory
+ * @return true on success
+ */
+bool nebula_cache_store(uint32_t seed, const uint32_t *pixels, int w, int h);
+
+/**
+ * @brief Delete the cache file for a seed (after it was consumed)
+ * @param seed Nebula seed
+ */
+void nebula_cache_remove(uint32_t seed);
+
+/**
+ * @brief Seed of the nebula prepared by the previous run
+ * @return Seed, or 0 if none is pending
+ */
+uint32_t nebula_cache_pending_seed(void);
+
+/**
+ * @brief Generate and cache the nebula for the next launch on a low-priority background thread
+ * @param seed Seed for the next launch (non-zero)
+ * @param w Width
+ * @param h Height
+ */
+void nebula_prepare_next(uint32_t seed, int w, int h);
+
+/**
+ * @brief Cancel and join the background generator started by nebula_prepare_next()
+ */
+void nebula_prepare_shutdown(void);
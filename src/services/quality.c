@@ -0,0 +1,87 @@
+#include "quality.h"
+
+#include <SDL2/SDL.h>
+
+#include "../core/log.h"
+#include "../core/types.h"
+
+static const QualityTier TIERS[QUALITY__COUNT] = {
+    [QUALITY_HIGH] = {"high", TRAIL_LEN, 1, 1, 1.0f, 1.0f, 3},
+    [QUALITY_MEDIUM] = {"medium", 8, 1, 1, 1.0f, 0.6f, 2},
+    [QUALITY_LOW] = {"low", 6, 0, 2, 0.85f, 0.3f, 2},
+    [QUALITY_MINIMAL] = {"minimal", 4, 0, 2, 0.7f, 0.0f, 1},
+};
+
+static struct {
+    SDL_atomic_t level;
+    double avg_ms;
+    int over;   // consecutive frames above budget
+    int under;  // consecutive frames with headroom
+    int hold;   // frames left before another switch is allowed
+    bool forced;
+} g_quality;
+
+static void quality_switch(int level) {
+    int old = SDL_AtomicGet(&g_quality.level);
+    if (level == old)
+        return;
+    SDL_AtomicSet(&g_quality.level, level);
+    g_quality.over = 0;
+    g_quality.under = 0;
+    g_quality.hold = QUALITY_HOLD_FRAMES;
+    LOG_INFO("quality", "Tier %s -> %s (avg %.1f ms, budget %.1f ms)", TIERS[old].name, TIERS[level].name,
+             g_quality.avg_ms, (double)QUALITY_FRAME_BUDGET_MS);
+}
+
+void quality_frame(double work_ms, double frame_ms) {
+    /* A frame that took more than one and a half refresh periods missed vsync,
+     * even if the CPU side was quick (GPU bound) */
+    double ms = work_ms;
+    if (frame_ms > QUALITY_FRAME_BUDGET_MS * 1.5 && frame_ms > ms)
+        ms = frame_ms;
+    /* Ignore hitches like scene loads */
+    if (ms > 250.0)
+        return;
+    g_quality.avg_ms = g_quality.avg_ms <= 0.0 ? ms : g_quality.avg_ms * 0.9 + ms * 0.1;
+    if (g_quality.forced)
+        return;
+    if (g_quality.hold > 0) {
+        g_quality.hold--;
+        return;
+    }
+    int level = SDL_AtomicGet(&g_quality.level);
+    if (g_quality.avg_ms > QUALITY_FRAME_BUDGET_MS * 0.95) {
+        g_quality.under = 0;
+        if (++g_quality.over >= QUALITY_DOWN_FRAMES && level < QUALITY__COUNT - 1)
+            quality_switch(level + 1);
+    } else if (g_quality.avg_ms < QUALITY_FRAME_BUDGET_MS * 0.7) {
+        g_quality.over = 0;
+        if (++g_quality.under >= QUALITY_UP_FRAMES && level > 0)
+            quality_switch(level - 1);
+    } else {
+        g_quality.over = 0;
+        g_quality.under = 0;
+    }
+}
+
+const QualityTier *quality_current(void) {
+    return &TIERS[SDL_AtomicGet(&g_quality.level)];
+}
+
+QualityLevel quality_level(void) {
+    return (QualityLevel)SDL_AtomicGet(&g_quality.level);
+}
+
+double quality_average_ms(void) {
+    return g_quality.avg_ms;
+}
+
+void quality_force(int level) {
+    if (level < 0 || level >= QUALITY__COUNT) {
+        g_quality.forced = false;
+        LOG_INFO("quality", "Adaptive quality resumed");
+        return;
+    }
+    quality_switch(level);
+    g_quality.forced = true;
+}
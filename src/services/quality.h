@@ -0,0 +1,63 @@
+#pragma once
+#include <stdbool.h>
+
+// #define DEBUG_QUALITY // Enable to show the quality tier and frame time in the corner
+
+/**
+ * @brief Adaptive quality governor.
+ *
+ * The main loop reports how long each rendered frame took; when the smoothed
+ * time stays above the budget the governor drops one tier, and when it stays
+ * well below for a longer stretch it climbs back. The asymmetric windows plus
+ * a hold time after every switch keep the tier from flickering.
+ *
+ * Game code reads the active tier from any thread (the world may be stepped
+ * on a worker) through quality_current().
+ */
+
+typedef enum QualityLevel {
+    QUALITY_HIGH = 0,
+    QUALITY_MEDIUM,
+    QUALITY_LOW,
+    QUALITY_MINIMAL,
+    QUALITY__COUNT
+} QualityLevel;
+
+typedef struct QualityTier {
+    const char *name;
+    int trail_len;          // trail points drawn (<= TRAIL_LEN)
+    int trail_half_width;   // parallel lines per side of a trail segment
+    int effect_frame_step;  // explosion frames advanced per animation step (shorter blasts)
+    float effect_scale;     // explosion size multiplier
+    float effect_density;   // debris particles per emitter, relative to full
+    int ai_samples;         // enemy shot-search samples per tick (upper bound)
+} QualityTier;
+
+/**
+ * @brief Feed one rendered frame
+ * @param work_ms Time spent producing the frame (before present)
+ * @param frame_ms Time since the previous frame; counts when it shows a missed vsync
+ */
+void quality_frame(double work_ms, double frame_ms);
+
+/**
+ * @brief Settings of the active tier (never NULL, any thread)
+ */
+const QualityTier *quality_current(void);
+
+/**
+ * @brief Active tier
+ */
+QualityLevel quality_level(void);
+
+/**
+ * @brief Smoothed frame time the governor is acting on
+ * @return Milliseconds
+ */
+double quality_average_ms(void);
+
+/**
+ * @brief Pin a tier (disables adaptation) or pass -1 to resume
+ * @param level Tier, or -1
+ */
+void quality_force(int level);
@@ -0,0 +1,447 @@
+#include "render_queue.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../core/log.h"
+
+/* SDL_RenderGeometry (2.0.18+) lets a whole run of compatible commands go out
+ * as a single draw call. Older SDL falls back to one call per command.
+ * Note: geometry ignores texture color/alpha mod, which nothing in the game uses. */
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define RENDER_QUEUE_HAS_GEOMETRY 1
+#else
+#define RENDER_QUEUE_HAS_GEOMETRY 0
+#endif
+
+#define RENDER_QUEUE_TEX_OVERFLOW 255
+
+/* Sort key layout (most significant first):
+ *   pass:4 | layer:4 | tex:8 | blend:2 | depth:14 | seq:32
+ * Ordered layers leave tex/blend/depth at zero so only seq decides. */
+#define RQ_KEY_PASS_SHIFT 60
+#define RQ_KEY_LAYER_SHIFT 56
+#define RQ_KEY_TEX_SHIFT 48
+#define RQ_KEY_BLEND_SHIFT 46
+#define RQ_KEY_DEPTH_SHIFT 32
+
+static bool render_layer_is_ordered(uint8_t layer) {
+    return layer == RENDER_LAYER_BACKGROUND || layer == RENDER_LAYER_HUD || layer == RENDER_LAYER_UI;
+}
+
+static uint8_t render_blend_encode(SDL_BlendMode mode) {
+    switch (mode) {
+    case SDL_BLENDMODE_NONE:
+        return 0;
+    case SDL_BLENDMODE_ADD:
+        return 2;
+    case SDL_BLENDMODE_MOD:
+        return 3;
+    default:
+        return 1;
+    }
+}
+
+static SDL_BlendMode render_blend_decode(uint8_t code) {
+    switch (code) {
+    case 0:
+        return SDL_BLENDMODE_NONE;
+    case 2:
+        return SDL_BLENDMODE_ADD;
+    case 3:
+        return SDL_BLENDMODE_MOD;
+    default:
+        return SDL_BLENDMODE_BLEND;
+    }
+}
+
+RenderQueue *render_queue_create(float viewport_w, float viewport_h) {
+    RenderQueue *q = calloc(1, sizeof(RenderQueue));
+    if (!q) {
+        LOG_ERROR("render_queue", "Failed to allocate render queue");
+        return NULL;
+    }
+    q->cmds = malloc(sizeof(RenderCmd) * RENDER_QUEUE_INITIAL_CAP);
+    if (!q->cmds) {
+        LOG_ERROR("render_queue", "Failed to allocate command buffer");
+        free(q);
+        return NULL;
+    }
+    q->capacity = RENDER_QUEUE_INITIAL_CAP;
+    q->viewport = (SDL_FRect){0.f, 0.f, viewport_w, viewport_h};
+    q->layer = RENDER_LAYER_UI;
+    return q;
+}
+
+void render_queue_destroy(RenderQueue *q) {
+    if (!q)
+        return;
+    free(q->cmds);
+    free(q->order);
+    free(q->verts);
+    free(q->indices);
+    free(q);
+}
+
+static void render_queue_reset_commands(RenderQueue *q) {
+    q->count = 0;
+    q->seq = 0;
+    q->texture_count = 0;
+    memset(&q->stats, 0, sizeof(q->stats));
+}
+
+void render_queue_begin(RenderQueue *q) {
+    if (!q)
+        return;
+    render_queue_reset_commands(q);
+    q->pass = 0;
+    q->layer = RENDER_LAYER_UI;
+    q->depth = 0;
+}
+
+void render_queue_set_pass(RenderQueue *q, int pass) {
+    if (!q)
+        return;
+    if (pass < 0)
+        pass = 0;
+    if (pass >= RENDER_QUEUE_MAX_PASSES)
+        pass = RENDER_QUEUE_MAX_PASSES - 1;
+    q->pass = (uint8_t)pass;
+}
+
+RenderLayer render_queue_set_layer(RenderQueue *q, RenderLayer layer) {
+    if (!q)
+        return RENDER_LAYER_UI;
+    RenderLayer prev = (RenderLayer)q->layer;
+    if (layer >= 0 && layer < RENDER_LAYER__COUNT)
+        q->layer = (uint8_t)layer;
+    return prev;
+}
+
+void render_queue_set_depth(RenderQueue *q, uint16_t depth) {
+    if (q)
+        q->depth = depth & 0x3FFF;
+}
+
+static uint64_t render_queue_make_key(RenderQueue *q, uint16_t tex_id, uint8_t blend) {
+    uint64_t key = ((uint64_t)(q->pass & 0xF) << RQ_KEY_PASS_SHIFT) | ((uint64_t)(q->layer & 0xF) << RQ_KEY_LAYER_SHIFT);
+    if (!render_layer_is_ordered(q->layer)) {
+        key |= (uint64_t)(tex_id & 0xFF) << RQ_KEY_TEX_SHIFT;
+        key |= (uint64_t)(blend & 0x3) << RQ_KEY_BLEND_SHIFT;
+        key |= (uint64_t)(q->depth & 0x3FFF) << RQ_KEY_DEPTH_SHIFT;
+    }
+    return key | (uint64_t)q->seq++;
+}
+
+static uint16_t render_queue_texture_id(RenderQueue *q, SDL_Texture *tex) {
+    for (int i = q->texture_count - 1; i >= 0; --i) {
+        if (q->textures[i].tex == tex)
+            return (uint16_t)(i + 1);
+    }
+    if (q->texture_count >= RENDER_QUEUE_MAX_TEXTURES)
+        return RENDER_QUEUE_TEX_OVERFLOW;
+    RenderQueueTexture *t = &q->textures[q->texture_count];
+    t->tex = tex;
+    t->w = t->h = 0;
+    SDL_QueryTexture(tex, NULL, NULL, &t->w, &t->h);
+    q->texture_count++;
+    return (uint16_t)q->texture_count;
+}
+
+static bool render_queue_cull(const RenderQueue *q, SDL_FRect r, float angle_deg) {
+    float min_x = r.x, min_y = r.y, max_x = r.x + r.w, max_y = r.y + r.h;
+    if (angle_deg != 0.f) {
+        /* conservative bound: circle around the rotation center */
+        float cx = r.x + r.w * 0.5f, cy = r.y + r.h * 0.5f;
+        float rad = 0.5f * sqrtf(r.w * r.w + r.h * r.h);
+        min_x = cx - rad;
+        max_x = cx + rad;
+        min_y = cy - rad;
+        max_y = cy + rad;
+    }
+    if (min_x > max_x) {
+        float t = min_x; min_x = max_x; max_x = t;
+    }
+    if (min_y > max_y) {
+        float t = min_y; min_y = max_y; max_y = t;
+    }
+    const SDL_FRect *v = &q->viewport;
+    return max_x < v->x || max_y < v->y || min_x > v->x + v->w || min_y > v->y + v->h;
+}
+
+static RenderCmd *render_queue_alloc(RenderQueue *q) {
+    if (q->count >= q->capacity) {
+        int new_cap = q->capacity * 2;
+        RenderCmd *grown = realloc(q->cmds, sizeof(RenderCmd) * (size_t)new_cap);
+        if (!grown) {
+            LOG_ERROR("render_queue", "Failed to grow command buffer to %d", new_cap);
+            return NULL;
+        }
+        q->cmds = grown;
+        q->capacity = new_cap;
+    }
+    RenderCmd *c = &q->cmds[q->count++];
+    memset(c, 0, sizeof(*c));
+    return c;
+}
+
+void render_queue_push_texture(RenderQueue *q, SDL_Texture *tex, const SDL_Rect *src, const SDL_FRect *dst, float angle_deg) {
+    if (!q || !tex)
+        return;
+    q->stats.submitted++;
+    SDL_FRect d = dst ? *dst : q->viewport;
+    if (render_queue_cull(q, d, angle_deg)) {
+        q->stats.culled++;
+        return;
+    }
+    RenderCmd *c = render_queue_alloc(q);
+    if (!c)
+        return;
+    c->kind = RENDER_CMD_TEXTURE;
+    c->tex = tex;
+    c->tex_id = render_queue_texture_id(q, tex);
+    c->src = src ? *src : (SDL_Rect){0, 0, 0, 0};
+    c->dst = d;
+    c->angle = angle_deg;
+    c->key = render_queue_make_key(q, c->tex_id, 0);
+}
+
+void render_queue_push_fill_rect(RenderQueue *q, SDL_FRect rect, SDL_Color color, SDL_BlendMode blend) {
+    if (!q)
+        return;
+    q->stats.submitted++;
+    if (render_queue_cull(q, rect, 0.f)) {
+        q->stats.culled++;
+        return;
+    }
+    RenderCmd *c = render_queue_alloc(q);
+    if (!c)
+        return;
+    c->kind = RENDER_CMD_FILL_RECT;
+    c->blend = render_blend_encode(blend);
+    c->dst = rect;
+    c->color = color;
+    c->key = render_queue_make_key(q, 0, c->blend);
+}
+
+void render_queue_push_line(RenderQueue *q, float x0, float y0, float x1, float y1, SDL_Color color, SDL_BlendMode blend) {
+    if (!q)
+        return;
+    q->stats.submitted++;
+    SDL_FRect bounds = {fminf(x0, x1), fminf(y0, y1), fabsf(x1 - x0) + 1.f, fabsf(y1 - y0) + 1.f};
+    if (render_queue_cull(q, bounds, 0.f)) {
+        q->stats.culled++;
+        return;
+    }
+    RenderCmd *c = render_queue_alloc(q);
+    if (!c)
+        return;
+    c->kind = RENDER_CMD_LINE;
+    c->blend = render_blend_encode(blend);
+    c->dst = (SDL_FRect){x0, y0, x1, y1};
+    c->color = color;
+    c->key = render_queue_make_key(q, 0, c->blend);
+}
+
+static int render_sort_cmp(const void *a, const void *b) {
+    uint64_t ka = ((const RenderSortItem *)a)->key;
+    uint64_t kb = ((const RenderSortItem *)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+static bool render_cmd_compatible(const RenderCmd *a, const RenderCmd *b) {
+    bool a_tex = a->kind == RENDER_CMD_TEXTURE;
+    bool b_tex = b->kind == RENDER_CMD_TEXTURE;
+    if (a_tex != b_tex)
+        return false;
+    if (a_tex)
+        return a->tex == b->tex && a->tex_id != RENDER_QUEUE_TEX_OVERFLOW;
+    return a->blend == b->blend;
+}
+
+static void render_cmd_submit_single(RenderQueue *q, SDL_Renderer *sdl, const RenderCmd *c) {
+    switch (c->kind) {
+    case RENDER_CMD_TEXTURE:
+        SDL_RenderCopyExF(sdl, c->tex, c->src.w > 0 ? &c->src : NULL, &c->dst, c->angle, NULL, SDL_FLIP_NONE);
+        break;
+    case RENDER_CMD_FILL_RECT:
+        SDL_SetRenderDrawBlendMode(sdl, render_blend_decode(c->blend));
+        SDL_SetRenderDrawColor(sdl, c->color.r, c->color.g, c->color.b, c->color.a);
+        SDL_RenderFillRectF(sdl, &c->dst);
+        break;
+    case RENDER_CMD_LINE:
+        SDL_SetRenderDrawBlendMode(sdl, render_blend_decode(c->blend));
+        SDL_SetRenderDrawColor(sdl, c->color.r, c->color.g, c->color.b, c->color.a);
+        SDL_RenderDrawLineF(sdl, c->dst.x, c->dst.y, c->dst.w, c->dst.h);
+        break;
+    }
+    q->stats.draw_calls++;
+}
+
+#if RENDER_QUEUE_HAS_GEOMETRY
+static bool render_queue_reserve_geometry(RenderQueue *q, int quads) {
+    int need_v = quads * 4, need_i = quads * 6;
+    if (need_v > q->vert_capacity) {
+        SDL_Vertex *v = realloc(q->verts, sizeof(SDL_Vertex) * (size_t)need_v);
+        if (!v)
+            return false;
+        q->verts = v;
+        q->vert_capacity = need_v;
+    }
+    if (need_i > q->index_capacity) {
+        int *idx = realloc(q->indices, sizeof(int) * (size_t)need_i);
+        if (!idx)
+            return false;
+        q->indices = idx;
+        q->index_capacity = need_i;
+    }
+    return true;
+}
+
+static void render_quad_corners(const RenderCmd *c, SDL_FPoint out[4]) {
+    if (c->kind == RENDER_CMD_LINE) {
+        /* one pixel wide strip along the line, matching SDL's pixel-center convention */
+        float ax = c->dst.x + 0.5f, ay = c->dst.y + 0.5f;
+        float bx = c->dst.w + 0.5f, by = c->dst.h + 0.5f;
+        float dx = bx - ax, dy = by - ay;
+        float len2 = dx * dx + dy * dy;
+        if (len2 < 0.0001f) {
+            out[0] = (SDL_FPoint){c->dst.x, c->dst.y};
+            out[1] = (SDL_FPoint){c->dst.x + 1.f, c->dst.y};
+            out[2] = (SDL_FPoint){c->dst.x + 1.f, c->dst.y + 1.f};
+            out[3] = (SDL_FPoint){c->dst.x, c->dst.y + 1.f};
+            return;
+        }
+        float inv = 0.5f / sqrtf(len2);
+        float nx = -dy * inv, ny = dx * inv;
+        out[0] = (SDL_FPoint){ax + nx, ay + ny};
+        out[1] = (SDL_FPoint){bx + nx, by + ny};
+        out[2] = (SDL_FPoint){bx - nx, by - ny};
+        out[3] = (SDL_FPoint){ax - nx, ay - ny};
+        return;
+    }
+    const SDL_FRect *d = &c->dst;
+    if (c->angle == 0.f) {
+        out[0] = (SDL_FPoint){d->x, d->y};
+        out[1] = (SDL_FPoint){d->x + d->w, d->y};
+        out[2] = (SDL_FPoint){d->x + d->w, d->y + d->h};
+        out[3] = (SDL_FPoint){d->x, d->y + d->h};
+        return;
+    }
+    float cx = d->x + d->w * 0.5f, cy = d->y + d->h * 0.5f;
+    float hw = d->w * 0.5f, hh = d->h * 0.5f;
+    float rad = c->angle * (float)(M_PI / 180.0);
+    float cs = cosf(rad), sn = sinf(rad);
+    const float lx[4] = {-hw, hw, hw, -hw};
+    const float ly[4] = {-hh, -hh, hh, hh};
+    for (int k = 0; k < 4; ++k)
+        out[k] = (SDL_FPoint){cx + lx[k] * cs - ly[k] * sn, cy + lx[k] * sn + ly[k] * cs};
+}
+
+static void render_queue_submit_batch(RenderQueue *q, SDL_Renderer *sdl, int begin, int end) {
+    int n = end - begin;
+    const RenderCmd *first = &q->cmds[q->order[begin].index];
+    if (!render_queue_reserve_geometry(q, n)) {
+        for (int i = begin; i < end; ++i)
+            render_cmd_submit_single(q, sdl, &q->cmds[q->order[i].index]);
+        return;
+    }
+    float inv_w = 1.f, inv_h = 1.f;
+    if (first->kind == RENDER_CMD_TEXTURE) {
+        const RenderQueueTexture *t = &q->textures[first->tex_id - 1];
+        inv_w = t->w > 0 ? 1.f / (float)t->w : 0.f;
+        inv_h = t->h > 0 ? 1.f / (float)t->h : 0.f;
+    }
+    SDL_Vertex *v = q->verts;
+    int *idx = q->indices;
+    for (int i = 0; i < n; ++i) {
+        const RenderCmd *c = &q->cmds[q->order[begin + i].index];
+        SDL_FPoint p[4];
+        render_quad_corners(c, p);
+        float u0 = 0.f, v0 = 0.f, u1 = 1.f, v1 = 1.f;
+        SDL_Color col = c->color;
+        if (c->kind == RENDER_CMD_TEXTURE) {
+            col = (SDL_Color){255, 255, 255, 255};
+            if (c->src.w > 0) {
+                u0 = (float)c->src.x * inv_w;
+                v0 = (float)c->src.y * inv_h;
+                u1 = (float)(c->src.x + c->src.w) * inv_w;
+                v1 = (float)(c->src.y + c->src.h) * inv_h;
+            }
+        }
+        const float us[4] = {u0, u1, u1, u0};
+        const float vs[4] = {v0, v0, v1, v1};
+        for (int k = 0; k < 4; ++k) {
+            v[i * 4 + k].position = p[k];
+            v[i * 4 + k].color = col;
+            v[i * 4 + k].tex_coord = (SDL_FPoint){us[k], vs[k]};
+        }
+        int base = i * 4;
+        idx[i * 6 + 0] = base;
+        idx[i * 6 + 1] = base + 1;
+        idx[i * 6 + 2] = base + 2;
+        idx[i * 6 + 3] = base;
+        idx[i * 6 + 4] = base + 2;
+        idx[i * 6 + 5] = base + 3;
+    }
+    if (first->kind != RENDER_CMD_TEXTURE)
+        SDL_SetRenderDrawBlendMode(sdl, render_blend_decode(first->blend));
+    SDL_RenderGeometry(sdl, first->kind == RENDER_CMD_TEXTURE ? first->tex : NULL, v, n * 4, idx, n * 6);
+    q->stats.draw_calls++;
+    q->stats.merged += n - 1;
+}
+#endif
+
+void render_queue_flush(RenderQueue *q, SDL_Renderer *sdl) {
+    if (!q)
+        return;
+    if (!sdl || q->count == 0) {
+        q->last_stats = q->stats;
+        render_queue_reset_commands(q);
+        return;
+    }
+    if (q->count > q->order_capacity) {
+        RenderSortItem *order = realloc(q->order, sizeof(RenderSortItem) * (size_t)q->capacity);
+        if (!order) {
+            LOG_ERROR("render_queue", "Failed to allocate sort buffer");
+            render_queue_reset_commands(q);
+            return;
+        }
+        q->order = order;
+        q->order_capacity = q->capacity;
+    }
+    for (int i = 0; i < q->count; ++i) {
+        q->order[i].key = q->cmds[i].key;
+        q->order[i].index = i;
+    }
+    qsort(q->order, (size_t)q->count, sizeof(RenderSortItem), render_sort_cmp);
+
+    SDL_BlendMode prev_blend = SDL_BLENDMODE_BLEND;
+    SDL_GetRenderDrawBlendMode(sdl, &prev_blend);
+
+    int i = 0;
+    while (i < q->count) {
+        const RenderCmd *first = &q->cmds[q->order[i].index];
+        int j = i + 1;
+        while (j < q->count && render_cmd_compatible(first, &q->cmds[q->order[j].index]))
+            ++j;
+#if RENDER_QUEUE_HAS_GEOMETRY
+        if (j - i > 1) {
+            render_queue_submit_batch(q, sdl, i, j);
+            i = j;
+            continue;
+        }
+#endif
+        for (; i < j; ++i)
+            render_cmd_submit_single(q, sdl, &q->cmds[q->order[i].index]);
+    }
+
+    SDL_SetRenderDrawBlendMode(sdl, prev_blend);
+    q->last_stats = q->stats;
+    render_queue_reset_commands(q);
+}
+
+RenderQueueStats render_queue_last_stats(const RenderQueue *q) {
+    if (!q)
+        return (RenderQueueStats){0};
+    return q->last_stats;
+}
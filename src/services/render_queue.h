@@ -0,0 +1,171 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RENDER_QUEUE_INITIAL_CAP 1024
+#define RENDER_QUEUE_MAX_TEXTURES 254
+#define RENDER_QUEUE_MAX_PASSES 16
+
+/**
+ * @brief Draw layers inside one scene pass, back to front.
+ *
+ * Layers marked "ordered" keep strict submission order (UI, HUD, background),
+ * all other layers are sorted by texture / blend / depth so that commands
+ * sharing state end up adjacent and can be merged into one draw call.
+ */
+typedef enum RenderLayer {
+    RENDER_LAYER_BACKGROUND = 0, // ordered
+    RENDER_LAYER_PLANETS,
+    RENDER_LAYER_TRAILS,
+    RENDER_LAYER_PROJECTILES,
+    RENDER_LAYER_SHIPS,
+    RENDER_LAYER_EFFECTS,
+    RENDER_LAYER_HUD,            // ordered
+    RENDER_LAYER_UI,             // ordered (default)
+    RENDER_LAYER__COUNT
+} RenderLayer;
+
+typedef enum RenderCmdKind {
+    RENDER_CMD_TEXTURE = 0,
+    RENDER_CMD_FILL_RECT,
+    RENDER_CMD_LINE
+} RenderCmdKind;
+
+typedef struct RenderCmd {
+    uint64_t key;
+    uint8_t kind;
+    uint8_t blend;       // draw blend mode for untextured commands
+    uint16_t tex_id;     // 0 = untextured, else index+1 into texture table
+    SDL_Texture *tex;
+    SDL_Rect src;
+    SDL_FRect dst;       // lines: (x,y) = start, (w,h) = end point
+    float angle;
+    SDL_Color color;
+} RenderCmd;
+
+typedef struct RenderQueueStats {
+    int submitted;   // commands pushed this frame
+    int culled;      // rejected by the viewport test
+    int merged;      // commands folded into a previous draw call
+    int draw_calls;  // SDL draw calls issued on flush
+} RenderQueueStats;
+
+typedef struct RenderQueueTexture {
+    SDL_Texture *tex;
+    int w, h;
+} RenderQueueTexture;
+
+typedef struct RenderSortItem {
+    uint64_t key;
+    int index;
+} RenderSortItem;
+
+typedef struct RenderQueue {
+    RenderCmd *cmds;
+    int count;
+    int capacity;
+    RenderSortItem *order;
+    int order_capacity;
+    SDL_Vertex *verts;
+    int vert_capacity;
+    int *indices;
+    int index_capacity;
+    RenderQueueTexture textures[RENDER_QUEUE_MAX_TEXTURES];
+    int texture_count;
+    SDL_FRect viewport;
+    uint32_t seq;
+    uint8_t pass;
+    uint8_t layer;
+    uint16_t depth;
+    RenderQueueStats stats;
+    RenderQueueStats last_stats;
+} RenderQueue;
+
+/**
+ * @brief Create a render queue culling against a viewport of the given size
+ * @param viewport_w Viewport width in pixels
+ * @param viewport_h Viewport height in pixels
+ * @return New queue or NULL on allocation failure
+ */
+RenderQueue *render_queue_create(float viewport_w, float viewport_h);
+
+/**
+ * @brief Destroy a render queue
+ * @param q Queue to destroy
+ */
+void render_queue_destroy(RenderQueue *q);
+
+/**
+ * @brief Drop all pending commands and start a new frame
+ * @param q Queue
+ */
+void render_queue_begin(RenderQueue *q);
+
+/**
+ * @brief Select the scene pass (0 = base scene, 1.. = overlays) for following commands
+ * @param q Queue
+ * @param pass Pass index, clamped to RENDER_QUEUE_MAX_PASSES - 1
+ */
+void render_queue_set_pass(RenderQueue *q, int pass);
+
+/**
+ * @brief Select the layer for following commands
+ * @param q Queue
+ * @param layer Layer
+ * @return Previously active layer
+ */
+RenderLayer render_queue_set_layer(RenderQueue *q, RenderLayer layer);
+
+/**
+ * @brief Set the depth used inside sorted layers (lower draws first)
+ * @param q Queue
+ * @param depth Depth value (14 bits are used)
+ */
+void render_queue_set_depth(RenderQueue *q, uint16_t depth);
+
+/**
+ * @brief Queue a texture copy
+ * @param q Queue
+ * @param tex Texture
+ * @param src Source rectangle (NULL for full texture)
+ * @param dst Destination rectangle (NULL for the full viewport)
+ * @param angle_deg Rotation around the destination center in degrees
+ */
+void render_queue_push_texture(RenderQueue *q, SDL_Texture *tex, const SDL_Rect *src, const SDL_FRect *dst, float angle_deg);
+
+/**
+ * @brief Queue a filled rectangle
+ * @param q Queue
+ * @param rect Rectangle
+ * @param color Fill color
+ * @param blend Draw blend mode
+ */
+void render_queue_push_fill_rect(RenderQueue *q, SDL_FRect rect, SDL_Color color, SDL_BlendMode blend);
+
+/**
+ * @brief Queue a one pixel wide line
+ * @param q Queue
+ * @param x0 Start X
+ * @param y0 Start Y
+ * @param x1 End X
+ * @param y1 End Y
+ * @param color Line color
+ * @param blend Draw blend mode
+ */
+void render_queue_push_line(RenderQueue *q, float x0, float y0, float x1, float y1, SDL_Color color, SDL_BlendMode blend);
+
+/**
+ * @brief Sort, merge and submit all queued commands, then drop them.
+ *        Pass, layer and depth selection are kept.
+ * @param q Queue
+ * @param sdl SDL renderer to submit to
+ */
+void render_queue_flush(RenderQueue *q, SDL_Renderer *sdl);
+
+/**
+ * @brief Statistics of the last flushed frame
+ * @param q Queue
+ * @return Stats snapshot
+ */
+RenderQueueStats render_queue_last_stats(const RenderQueue *q);
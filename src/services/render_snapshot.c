@@ -0,0 +1,65 @@
+#include "render_snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../core/log.h"
+
+#define RENDER_SNAPSHOT_INITIAL_ITEMS 512
+#define RENDER_SNAPSHOT_INITIAL_TEXT 256
+
+void render_snapshot_reset(RenderSnapshot *s) {
+    if (!s)
+        return;
+    s->count = 0;
+    s->text_len = 0;
+    s->layer = RENDER_LAYER_UI;
+}
+
+void render_snapshot_free(RenderSnapshot *s) {
+    if (!s)
+        return;
+    free(s->items);
+    free(s->text);
+    memset(s, 0, sizeof(*s));
+}
+
+RenderSnapshotItem *render_snapshot_push(RenderSnapshot *s, RenderSnapshotItemKind kind) {
+    if (!s)
+        return NULL;
+    if (s->count >= s->capacity) {
+        int new_cap = s->capacity > 0 ? s->capacity * 2 : RENDER_SNAPSHOT_INITIAL_ITEMS;
+        RenderSnapshotItem *grown = realloc(s->items, sizeof(RenderSnapshotItem) * (size_t)new_cap);
+        if (!grown) {
+            LOG_ERROR("render_snapshot", "Failed to grow snapshot to %d items", new_cap);
+            return NULL;
+        }
+        s->items = grown;
+        s->capacity = new_cap;
+    }
+    RenderSnapshotItem *it = &s->items[s->count++];
+    memset(it, 0, sizeof(*it));
+    it->kind = (uint8_t)kind;
+    it->layer = s->layer;
+    return it;
+}
+
+int render_snapshot_store_text(RenderSnapshot *s, const char *text) {
+    if (!s || !text)
+        return -1;
+    int len = (int)strlen(text) + 1;
+    if (s->text_len + len > s->text_capacity) {
+        int new_cap = s->text_capacity > 0 ? s->text_capacity : RENDER_SNAPSHOT_INITIAL_TEXT;
+        while (new_cap < s->text_len + len)
+            new_cap *= 2;
+        char *grown = realloc(s->text, (size_t)new_cap);
+        if (!grown) {
+            LOG_ERROR("render_snapshot", "Failed to grow text arena to %d bytes", new_cap);
+            return -1;
+        }
+        s->text = grown;
+        s->text_capacity = new_cap;
+    }
+    int offset = s->text_len;
+    memcpy(s->text + offset, text, (size_t)len);
+    s->text_len += len;
+    return offset;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "render_queue.h"
+
+/**
+ * @brief Immutable display list recorded off the main thread.
+ *
+ * A renderer in capture mode (Renderer.capture != NULL) appends every draw call
+ * here instead of touching SDL. Text is stored as strings and only turned into
+ * textures when the snapshot is replayed on the main thread.
+ */
+typedef enum RenderSnapshotItemKind {
+    RSNAP_TEXTURE = 0,
+    RSNAP_FILL_RECT,
+    RSNAP_RECT_OUTLINE,
+    RSNAP_LINE,
+    RSNAP_TEXT
+} RenderSnapshotItemKind;
+
+typedef struct RenderSnapshotItem {
+    uint8_t kind;
+    uint8_t layer;
+    bool has_src;
+    bool has_dst;
+    SDL_BlendMode blend;
+    SDL_Texture *tex;
+    SDL_Rect src;
+    SDL_FRect dst;       // lines: (x,y) = start, (w,h) = end; text: (x,y) = origin
+    float angle;
+    SDL_Color color;
+    int text_offset;     // into RenderSnapshot.text
+    int text_size_px;
+    int text_wrap_w;
+    const char *font_path;
+} RenderSnapshotItem;
+
+typedef struct RenderSnapshot {
+    RenderSnapshotItem *items;
+    int count;
+    int capacity;
+    char *text;
+    int text_len;
+    int text_capacity;
+    uint8_t layer;       // layer used for items recorded next
+    uint64_t tick;       // simulation step that produced this snapshot
+} RenderSnapshot;
+
+/**
+ * @brief Drop all recorded items, keeping allocated storage
+ * @param s Snapshot
+ */
+void render_snapshot_reset(RenderSnapshot *s);
+
+/**
+ * @brief Release snapshot storage
+ * @param s Snapshot
+ */
+void render_snapshot_free(RenderSnapshot *s);
+
+/**
+ * @brief Append an item tagged with the current layer
+ * @param s Snapshot
+ * @param kind Item kind
+ * @return Zeroed item to fill in, or NULL on allocation failure
+ */
+RenderSnapshotItem *render_snapshot_push(RenderSnapshot *s, RenderSnapshotItemKind kind);
+
+/**
+ * @brief Copy a string into the snapshot text arena
+ * @param s Snapshot
+ * @param text NUL-terminated string
+ * @return Offset of the copy or -1 on allocation failure
+ */
+int render_snapshot_store_text(RenderSnapshot *s, const char *text);
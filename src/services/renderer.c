@@ -3,6 +3,7 @@
 #include <string.h>
 #include <stdio.h>
 #include "../core/log.h"
+#include "../core/vfs.h"
 
 static char *renderer_strdup(const char *src) {
     if (!src)
@@ -34,12 +35,38 @@ static void renderer_font_cache_remove(Renderer *r, size_t index) {
     r->font_cache_count -= 1;
 }
 
+/* Destroy a texture once the current frame has been submitted */
+static bool renderer_defer_destroy(Renderer *r, SDL_Texture *tex) {
+    if (r->dead_count >= r->dead_capacity) {
+        size_t cap = r->dead_capacity ? r->dead_capacity * 2 : 16;
+        SDL_Texture **arr = realloc(r->dead_textures, sizeof(*arr) * cap);
+        if (!arr)
+            return false;
+        r->dead_textures = arr;
+        r->dead_capacity = cap;
+    }
+    r->dead_textures[r->dead_count++] = tex;
+    return true;
+}
+
+static void renderer_free_dead_textures(Renderer *r) {
+    for (size_t i = 0; i < r->dead_count; ++i)
+        SDL_DestroyTexture(r->dead_textures[i]);
+    r->dead_count = 0;
+}
+
 static void renderer_text_cache_remove(Renderer *r, size_t index) {
     if (!r || index >= r->text_cache_count)
         return;
     RendererTextCacheEntry *entry = &r->text_cache[index];
     if (entry->texture) {
-        SDL_DestroyTexture(entry->texture);
+        /* The queue may still reference this texture until the frame is flushed */
+        if (r->deferred && entry->last_used_frame == r->frame_counter) {
+            if (!renderer_defer_destroy(r, entry->texture))
+                LOG_ERROR("renderer", "Out of memory, leaking an evicted text texture");
+        } else {
+            SDL_DestroyTexture(entry->texture);
+        }
         entry->texture = NULL;
     }
     free(entry->text);
@@ -82,6 +109,19 @@ static char *renderer_build_font_path(Renderer *r, const char *font_name) {
     return full_path;
 }
 
+/* Fonts from the asset pack are opened straight from the mapping, which stays
+ * valid until vfs_unmount (after the renderer is destroyed). */
+static TTF_Font *renderer_open_font(const char *font_name, const char *resolved_path, int size_px) {
+    if (!renderer_is_absolute_font_path(font_name)) {
+        char packed[VFS_PATH_MAX];
+        VfsFile file;
+        if (snprintf(packed, sizeof(packed), "fonts/%s", font_name) < (int)sizeof(packed) &&
+            vfs_open_packed(packed, &file))
+            return TTF_OpenFontRW(SDL_RWFromConstMem(file.data, (int)file.size), 1, size_px);
+    }
+    return TTF_OpenFont(resolved_path, size_px);
+}
+
 static RendererFontCacheEntry *renderer_get_font_entry(Renderer *r, const TextStyle *style) {
     if (!r)
         return NULL;
@@ -110,7 +150,7 @@ static RendererFontCacheEntry *renderer_get_font_entry(Renderer *r, const TextSt
         }
     }
 
-    TTF_Font *font = TTF_OpenFont(resolved_path, size_px);
+    TTF_Font *font = renderer_open_font(font_name, resolved_path, size_px);
     if (!font) {
         LOG_ERROR("renderer", "Failed to load font %s (%d): %s", resolved_path, size_px, TTF_GetError());
         free(resolved_path);
@@ -258,7 +298,17 @@ Renderer *renderer_create(SDL_Renderer *sdl) {
     }
     r->font = default_font->font;
 
-    SDL_SetRenderDrawBlendMode(r->sdl, SDL_BLENDMODE_BLEND);
+    r->draw_blend = SDL_BLENDMODE_BLEND;
+    SDL_SetRenderDrawBlendMode(r->sdl, r->draw_blend);
+
+    int out_w = 0, out_h = 0;
+    if (SDL_GetRendererOutputSize(r->sdl, &out_w, &out_h) != 0 || out_w <= 0 || out_h <= 0) {
+        out_w = 960;
+        out_h = 544;
+    }
+    r->queue = render_queue_create((float)out_w, (float)out_h);
+    if (!r->queue)
+        LOG_WARN("renderer", "Render queue unavailable, drawing immediately");
 
     return r;
 }
@@ -281,8 +331,11 @@ void renderer_destroy(Renderer *r) {
         free(entry->font_path);
     }
 
+    renderer_free_dead_textures(r);
+    free(r->dead_textures);
     free(r->font_assets_root);
     free(r->default_font_name);
+    render_queue_destroy(r->queue);
 
     free(r);
 }
@@ -291,14 +344,139 @@ void renderer_render(Renderer *r) {
         return;
     r->frame_counter += 1;
     SDL_RenderPresent(r->sdl);
+    /* the frame's queue was flushed before present */
+    renderer_free_dead_textures(r);
+}
+void renderer_begin_frame(Renderer *r) {
+    if (!r || !r->queue)
+        return;
+    render_queue_begin(r->queue);
+    r->deferred = true;
+}
+void renderer_flush(Renderer *r) {
+    if (!r || !r->queue)
+        return;
+    r->deferred = false;
+    render_queue_flush(r->queue, r->sdl);
+    SDL_SetRenderDrawBlendMode(r->sdl, r->draw_blend);
+}
+bool renderer_set_deferred(Renderer *r, bool deferred) {
+    if (!r)
+        return false;
+    bool prev = r->deferred;
+    r->deferred = deferred && r->queue;
+    if (!r->deferred)
+        SDL_SetRenderDrawBlendMode(r->sdl, r->draw_blend);
+    return prev;
+}
+void renderer_set_pass(Renderer *r, int pass) {
+    if (!r || !r->queue)
+        return;
+    render_queue_set_pass(r->queue, pass);
+    render_queue_set_layer(r->queue, RENDER_LAYER_UI);
+}
+RenderLayer renderer_set_layer(Renderer *r, RenderLayer layer) {
+    if (r && r->capture) {
+        RenderLayer prev = (RenderLayer)r->capture->layer;
+        r->capture->layer = (uint8_t)layer;
+        return prev;
+    }
+    if (!r || !r->queue)
+        return RENDER_LAYER_UI;
+    return render_queue_set_layer(r->queue, layer);
+}
+SDL_BlendMode renderer_set_blend_mode(Renderer *r, SDL_BlendMode mode) {
+    if (!r)
+        return SDL_BLENDMODE_BLEND;
+    SDL_BlendMode prev = r->draw_blend;
+    r->draw_blend = mode;
+    if (!r->deferred && !r->capture)
+        SDL_SetRenderDrawBlendMode(r->sdl, mode);
+    return prev;
+}
+void renderer_init_capture(Renderer *r, RenderSnapshot *snap) {
+    if (!r)
+        return;
+    memset(r, 0, sizeof(*r));
+    r->capture = snap;
+    r->draw_blend = SDL_BLENDMODE_BLEND;
+    render_snapshot_reset(snap);
+}
+void renderer_replay_snapshot(Renderer *r, const RenderSnapshot *snap, bool skip_planets) {
+    if (!r || !snap)
+        return;
+    RenderLayer prev_layer = renderer_set_layer(r, RENDER_LAYER_UI);
+    SDL_BlendMode prev_blend = r->draw_blend;
+    for (int i = 0; i < snap->count; ++i) {
+        const RenderSnapshotItem *it = &snap->items[i];
+        if (skip_planets && it->layer == RENDER_LAYER_PLANETS)
+            continue;
+        renderer_set_layer(r, (RenderLayer)it->layer);
+        renderer_set_blend_mode(r, it->blend);
+        switch (it->kind) {
+        case RSNAP_TEXTURE:
+            renderer_draw_texture(r, it->tex, it->has_src ? &it->src : NULL, it->has_dst ? &it->dst : NULL, it->angle);
+            break;
+        case RSNAP_FILL_RECT:
+            renderer_draw_filled_rect(r, it->dst, it->color);
+            break;
+        case RSNAP_RECT_OUTLINE:
+            renderer_draw_rect_outline(r, it->dst, it->color, 1);
+            break;
+        case RSNAP_LINE:
+            renderer_draw_line(r, it->dst.x, it->dst.y, it->dst.w, it->dst.h, it->color);
+            break;
+        case RSNAP_TEXT:
+            renderer_draw_text(r, snap->text + it->text_offset, it->dst.x, it->dst.y,
+                               (TextStyle){it->font_path, it->text_size_px, it->text_wrap_w});
+            break;
+        }
+    }
+    renderer_set_blend_mode(r, prev_blend);
+    renderer_set_layer(r, prev_layer);
+}
+void renderer_draw_line(Renderer *r, float x0, float y0, float x1, float y1, SDL_Color color) {
+    if (!r)
+        return;
+    if (r->capture) {
+        RenderSnapshotItem *it = render_snapshot_push(r->capture, RSNAP_LINE);
+        if (it) {
+            it->blend = r->draw_blend;
+            it->dst = (SDL_FRect){x0, y0, x1, y1};
+            it->color = color;
+        }
+        return;
+    }
+    if (r->deferred) {
+        render_queue_push_line(r->queue, x0, y0, x1, y1, color, r->draw_blend);
+        return;
+    }
+    SDL_SetRenderDrawColor(r->sdl, color.r, color.g, color.b, color.a);
+    SDL_RenderDrawLineF(r->sdl, x0, y0, x1, y1);
 }
 void renderer_draw_texture(Renderer *r, SDL_Texture *tex, const SDL_Rect *src, const SDL_FRect *dst, float angle_deg) {
-    (void)angle_deg;
+    if (r->capture && tex) {
+        RenderSnapshotItem *it = render_snapshot_push(r->capture, RSNAP_TEXTURE);
+        if (it) {
+            it->blend = r->draw_blend;
+            it->tex = tex;
+            it->has_src = src != NULL;
+            if (src)
+                it->src = *src;
+            it->has_dst = dst != NULL;
+            if (dst)
+                it->dst = *dst;
+            it->angle = angle_deg;
+        }
+        return;
+    }
     if (!tex) {
         SDL_FRect rect = dst ? *dst : (SDL_FRect){0, 0, 32, 32
 };
-        SDL_SetRenderDrawColor(r->sdl, 80, 80, 160, 255);
-        SDL_RenderFillRectF(r->sdl, &rect);
+        renderer_draw_filled_rect(r, rect, (SDL_Color){80, 80, 160, 255});
+    }
+    else if (r->deferred) {
+        render_queue_push_texture(r->queue, tex, src, dst, angle_deg);
     }
     else {
         SDL_RenderCopyExF(r->sdl, tex, src, dst, angle_deg, NULL, 0);
@@ -308,6 +486,19 @@ void renderer_draw_text(Renderer *r, const char *text, float x, float y, TextSty
     if (!r || !text || text[0] == '\0')
         return;
 
+    if (r->capture) {
+        int offset = render_snapshot_store_text(r->capture, text);
+        RenderSnapshotItem *it = offset >= 0 ? render_snapshot_push(r->capture, RSNAP_TEXT) : NULL;
+        if (it) {
+            it->text_offset = offset;
+            it->dst = (SDL_FRect){x, y, 0.f, 0.f};
+            it->text_size_px = style.size_px;
+            it->text_wrap_w = style.wrap_w;
+            it->font_path = style.font_path;
+        }
+        return;
+    }
+
     SDL_Texture *texture = NULL;
     SDL_Point size = {0, 0};
     if (!renderer_get_text_texture(r, text, style, &texture, &size) || !texture)
@@ -319,15 +510,27 @@ void renderer_draw_text(Renderer *r, const char *text, float x, float y, TextSty
         .w = (float)size.x,
         .h = (float)size.y
     };
-    SDL_RenderCopyF(r->sdl, texture, NULL, &dst);
+    renderer_draw_texture(r, texture, NULL, &dst, 0.f);
 }
 void renderer_draw_textbox(Renderer *r, const char *text, SDL_FRect box, TextboxStyle style) {
     (void)text;
     (void)style;
-    SDL_SetRenderDrawColor(r->sdl, 200, 200, 200, 255);
-    SDL_RenderDrawRectF(r->sdl, &box);
+    renderer_draw_rect_outline(r, box, (SDL_Color){200, 200, 200, 255}, 1);
 }
 void renderer_draw_filled_rect(Renderer *r, SDL_FRect rect, SDL_Color color) {
+    if (r->capture) {
+        RenderSnapshotItem *it = render_snapshot_push(r->capture, RSNAP_FILL_RECT);
+        if (it) {
+            it->blend = r->draw_blend;
+            it->dst = rect;
+            it->color = color;
+        }
+        return;
+    }
+    if (r->deferred) {
+        render_queue_push_fill_rect(r->queue, rect, color, r->draw_blend);
+        return;
+    }
     SDL_SetRenderDrawColor(r->sdl, color.r, color.g, color.b, color.a);
     SDL_RenderFillRectF(r->sdl, &rect);
 }
@@ -345,6 +548,24 @@ void renderer_draw_rect_outline(Renderer *r, SDL_FRect rect, SDL_Color color, in
     (void)border_px; // keep API but draw single-pixel outline using SDL
     if (!r)
         return;
+    if (r->capture) {
+        RenderSnapshotItem *it = render_snapshot_push(r->capture, RSNAP_RECT_OUTLINE);
+        if (it) {
+            it->blend = r->draw_blend;
+            it->dst = rect;
+            it->color = color;
+        }
+        return;
+    }
+    if (r->deferred) {
+        /* queued as four 1px strips so outlines batch with other primitives */
+        float right = rect.x + rect.w - 1.f, bottom = rect.y + rect.h - 1.f;
+        render_queue_push_fill_rect(r->queue, (SDL_FRect){rect.x, rect.y, rect.w, 1.f}, color, r->draw_blend);
+        render_queue_push_fill_rect(r->queue, (SDL_FRect){rect.x, bottom, rect.w, 1.f}, color, r->draw_blend);
+        render_queue_push_fill_rect(r->queue, (SDL_FRect){rect.x, rect.y + 1.f, 1.f, rect.h - 2.f}, color, r->draw_blend);
+        render_queue_push_fill_rect(r->queue, (SDL_FRect){right, rect.y + 1.f, 1.f, rect.h - 2.f}, color, r->draw_blend);
+        return;
+    }
     SDL_SetRenderDrawColor(r->sdl, color.r, color.g, color.b, color.a);
     SDL_RenderDrawRectF(r->sdl, &rect);
 
@@ -7,6 +7,9 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "render_queue.h"
+#include "render_snapshot.h"
+
 #define RENDERER_FONT_CACHE_CAP 8
 #define RENDERER_TEXT_CACHE_CAP 128
 
@@ -38,7 +41,13 @@ typedef struct Renderer {
     size_t font_cache_count;
     RendererTextCacheEntry text_cache[RENDERER_TEXT_CACHE_CAP];
     size_t text_cache_count;
+    SDL_Texture **dead_textures; // evicted while the queue may still draw them; freed in renderer_render
+    size_t dead_count, dead_capacity;
     uint64_t frame_counter;
+    RenderQueue *queue;          // deferred command queue (NULL = always immediate)
+    bool deferred;               // true while recording a frame into the queue
+    SDL_BlendMode draw_blend;    // blend mode for untextured primitives
+    RenderSnapshot *capture;     // capture mode: record into snapshot, never touch SDL
 } Renderer;
 
 typedef struct TextStyle {
@@ -71,6 +80,78 @@ void renderer_destroy(Renderer *r);
  */
 void renderer_render(Renderer *r);
 
+/**
+ * @brief Start recording a frame into the render queue.
+ *        Draw calls are deferred until renderer_flush().
+ * @param r Renderer
+ */
+void renderer_begin_frame(Renderer *r);
+
+/**
+ * @brief Cull, sort, merge and submit everything recorded since renderer_begin_frame()
+ * @param r Renderer
+ */
+void renderer_flush(Renderer *r);
+
+/**
+ * @brief Temporarily switch between deferred and immediate drawing
+ *        (e.g. while drawing into an offscreen render target)
+ * @param r Renderer
+ * @param deferred true to record into the queue, false to draw immediately
+ * @return Previous mode
+ */
+bool renderer_set_deferred(Renderer *r, bool deferred);
+
+/**
+ * @brief Select the scene pass for following draw calls and reset the layer to UI
+ * @param r Renderer
+ * @param pass 0 for the base scene, 1.. for overlays
+ */
+void renderer_set_pass(Renderer *r, int pass);
+
+/**
+ * @brief Select the draw layer for following draw calls
+ * @param r Renderer
+ * @param layer Layer
+ * @return Previous layer
+ */
+RenderLayer renderer_set_layer(Renderer *r, RenderLayer layer);
+
+/**
+ * @brief Set blend mode used for rectangles and lines
+ * @param r Renderer
+ * @param mode Blend mode
+ * @return Previous blend mode
+ */
+SDL_BlendMode renderer_set_blend_mode(Renderer *r, SDL_BlendMode mode);
+
+/**
+ * @brief Turn a renderer into a capture-only recorder for a snapshot.
+ *        Safe to use off the main thread; no SDL calls are made while drawing.
+ * @param r Renderer storage to initialize (not created via renderer_create)
+ * @param snap Snapshot receiving the draw calls (reset by this call)
+ */
+void renderer_init_capture(Renderer *r, RenderSnapshot *snap);
+
+/**
+ * @brief Replay a captured snapshot through the regular draw path (main thread only)
+ * @param r Renderer
+ * @param snap Snapshot to replay
+ * @param skip_planets true to drop items on RENDER_LAYER_PLANETS (already baked into the background)
+ */
+void renderer_replay_snapshot(Renderer *r, const RenderSnapshot *snap, bool skip_planets);
+
+/**
+ * @brief Draw a one pixel wide line
+ * @param r Renderer
+ * @param x0 Start X
+ * @param y0 Start Y
+ * @param x1 End X
+ * @param y1 End Y
+ * @param color Line color
+ */
+void renderer_draw_line(Renderer *r, float x0, float y0, float x1, float y1, SDL_Color color);
+
 /**
  * @brief Draw a texture
  * @param r Renderer
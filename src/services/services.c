@@ -5,12 +5,22 @@
 #include "input.h"
 #include "texture_manager.h"
 #include "audio.h"
+#include "nebula.h"
+#include "../core/vfs.h"
 #include "../core/types.h"
 #include "../core/log.h"
 #include <time.h>
 
 static Services g_services;
 TextureManager *g_texman = NULL; /* global for quick projectile sheet src access */
+static uint32_t random_nebula_seed(uint32_t avoid) {
+  Uint64 counter = SDL_GetPerformanceCounter();
+  uint32_t seed = (uint32_t)(counter ^ (Uint64)time(NULL)) ^ (avoid * 2654435761u);
+  if (seed == 0 || seed == avoid)
+    seed = 0xA5A5F00Du ^ (uint32_t)counter;
+  return seed;
+}
+
 Services *services_get(void) {
     return &g_services;
 }
@@ -21,31 +31,76 @@ void services_init(Services *s) {
   s->window = SDL_CreateWindow("Gravity Hunters", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, s->display_w, s->display_h, 0);
   if (!s->window) LOG_ERROR("services", "Window creation failed: %s", SDL_GetError());
   s->sdl_renderer = SDL_CreateRenderer(s->window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-  s->renderer = renderer_create(s->sdl_renderer);
-  s->input = input_create();
 #ifdef PLATFORM_VITA
   const char *assets_root = "app0:/assets";
 #else
   const char *assets_root = "./assets";
 #endif
+  /* Mount first: fonts, textures and levels are all read through the VFS */
+  vfs_mount(assets_root);
+  s->renderer = renderer_create(s->sdl_renderer);
+  s->input = input_create();
   s->texman = texman_create(s->sdl_renderer, assets_root);
-  texman_load_textures(s->texman, 1337u);
-  Uint64 counter = SDL_GetPerformanceCounter();
-  uint32_t nebula_seed = (uint32_t)(counter ^ (Uint64)time(NULL));
+  /* Prefer the nebula the previous run prepared in the cache; otherwise roll a new one */
+  uint32_t nebula_seed = nebula_cache_pending_seed();
   if (nebula_seed == 0)
-    nebula_seed = 0xA5A5F00Du ^ (uint32_t)counter;
-  if (!texman_regen_nebula(s->texman, nebula_seed))
-    LOG_WARN("services", "Failed to regenerate nebula texture");
-  else
-    LOG_INFO("services", "Generated nebula seed=%08x", nebula_seed);
+    nebula_seed = random_nebula_seed(0);
+  s->nebula_seed = nebula_seed;
   g_texman = s->texman;
+  texman_load_begin(s->texman, nebula_seed);
+  s->loading = true;
 
   s->audio = audio_create(assets_root);
 
 }
 
+bool services_load_step(Services *s, double budget_ms) {
+  if (!s->loading)
+    return true;
+  bool textures = texman_load_step(s->texman, budget_ms);
+  bool sounds = !s->audio || audio_update(s->audio);
+  if (!textures || !sounds)
+    return false;
+  s->loading = false;
+  if (!texman_get(s->texman, TEX_BG_STARFIELD))
+    LOG_WARN("services", "Failed to generate nebula texture");
+  else
+    LOG_INFO("services", "Nebula seed=%08x", s->nebula_seed);
+  texman_log_stats(s->texman);
+  /* The cached copy is used up; start on the one for the next launch */
+  nebula_cache_remove(s->nebula_seed);
+  nebula_prepare_next(random_nebula_seed(s->nebula_seed), DISPLAY_W, DISPLAY_H);
+  return true;
+}
+
+float services_load_progress(Services *s) {
+  if (!s->loading)
+    return 1.f;
+  float p = texman_load_progress(s->texman) * 0.9f;
+  if (!s->audio || SDL_AtomicGet(&s->audio->ready))
+    p += 0.1f;
+  return p;
+}
+
+bool services_menu_ready(Services *s) {
+  if (!s->loading)
+    return true;
+  return texman_is_ready(s->texman, TEX_BG_STARFIELD) && texman_is_ready(s->texman, TEX_LOGO) &&
+         texman_is_ready(s->texman, TEX_UI_BUTTON_CROSS) && texman_is_ready(s->texman, TEX_UI_BUTTON_CIRCLE);
+}
+
+void services_finish_loading(Services *s) {
+  /* Sleep on the loaders instead of polling: textures first, then sounds */
+  while (!services_load_step(s, 1000.0)) {
+    if (!texman_load_wait(s->texman))
+      audio_wait_loaded(s->audio);
+  }
+}
+
 void services_shutdown(Services *s) {
 
+    nebula_prepare_shutdown();
+
     if (s->audio) {
         audio_destroy(s->audio);
         s->audio = NULL;
@@ -58,4 +113,5 @@ void services_shutdown(Services *s) {
   if (s->renderer) renderer_destroy(s->renderer);
   if (s->sdl_renderer) SDL_DestroyRenderer(s->sdl_renderer);
   if (s->window) SDL_DestroyWindow(s->window);
+  vfs_unmount();
 }
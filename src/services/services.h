@@ -1,5 +1,7 @@
 #pragma once
 #include <SDL2/SDL.h>
+#include <stdbool.h>
+#include <stdint.h>
 struct Renderer; struct TextureManager; struct Input; struct Audio;
 
 typedef struct Services {
@@ -10,8 +12,18 @@ typedef struct Services {
   struct Input *input;
   struct Audio *audio;
   int display_w, display_h;
+  uint32_t nebula_seed;
+  bool loading; /* startup assets still streaming in (see services_load_step) */
 } Services;
 
 Services *services_get(void);
+/* Creates the window/renderer and starts loading assets in the background. */
 void services_init(Services*);
 void services_shutdown(Services*);
+/* Main thread: upload decoded assets for at most budget_ms. Returns true when done. */
+bool services_load_step(Services*, double budget_ms);
+float services_load_progress(Services*);
+/* True once everything the main menu draws is available. */
+bool services_menu_ready(Services*);
+/* Block until every startup asset is loaded. */
+void services_finish_loading(Services*);
@@ -1,5 +1,9 @@
 #include "texture_manager.h"
+#include "nebula.h"
+#include "explosion_gen.h"
+#include "../core/vfs.h"
 #include "../core/types.h"
+#include "../core/log.h"
 #include <string.h>
 #include <stdbool.h>
 #include <SDL2/SDL_image.h>
@@ -8,42 +12,117 @@
 #include <stdint.h>
 
 struct BaseSlot {
-    SDL_Texture *tex;
+    SDL_Texture *tex;     /* own texture, or the atlas page for atlas members */
     uint16_t flags, tile_w, tile_h;
+    int w, h; /* cached at load so lookups never query SDL (safe off the render thread) */
+    int page;             /* atlas page, -1 for standalone textures */
+    SDL_Rect atlas;       /* placement inside the page */
+    Uint32 format;        /* pixel format the texture ended up in */
+    int refs;             /* texman_acquire count */
+    size_t bytes;         /* GPU footprint; atlas members report their share of the page */
+    Uint64 released_at;   /* eviction order among unreferenced textures */
+};
+enum LoadState { LOAD_PENDING = 0, LOAD_DECODED, LOAD_DONE };
+struct LoadSlot {
+    SDL_atomic_t state;   /* LoadState; the loader sets DECODED, the main thread DONE */
+    SDL_Surface *surface; /* decoded pixels waiting for upload */
+    FsMapping map;        /* backing file when the surface points into a mapping */
+    VfsFile file;         /* packed/loose asset the surface may point into */
+    bool final_pixels;    /* surface is already in upload format (generated or pre-decoded) */
 };
 struct TextureManager {
     SDL_Renderer *sdl;
     char assets_root[128];
+    Uint32 formats[16];   /* texture formats the renderer accepts */
+    int format_count;
     struct BaseSlot base[TEX__COUNT];
     int projectile_variant_count;
+    /* Shared atlas pages holding every TEXF_ATLAS sheet */
+    SDL_Texture *pages[TEXMAN_ATLAS_MAX_PAGES];
+    SDL_Surface *page_pixels[TEXMAN_ATLAS_MAX_PAGES]; /* composed by the loader, freed after upload */
+    int page_h[TEXMAN_ATLAS_MAX_PAGES];                /* pages are trimmed to their used height */
+    int page_count;
+    int atlas_state;      /* LoadState of the pages, guarded by load_lock */
+    Sprite sprites[SPR__COUNT];
+    ProjectileStyle projectile_styles[TEX_PROJECTILE_SPRITES];
     /* Explosions meta */
-    SDL_Texture *explosions_sheet;
     int explosion_types;
     int explosion_frames;
     int explosion_tile; /* square tile size */
+    SDL_mutex *explosion_lock;                          /* guards explosion_pending */
+    uint32_t *explosion_pending[EXPLOSION_GEN_TYPES];   /* generated strips awaiting upload */
+    int explosions_built; /* types the loader has finished with, guarded by load_lock */
+    /* Staged loading: a worker decodes images / generates pixels, the main
+     * thread turns the results into textures within a per-frame time budget */
+    SDL_Thread *loader;
+    SDL_mutex *load_lock;
+    SDL_cond *load_cond;  /* signalled by the loader whenever it hands over a result */
+    int load_published;   /* results handed over, guarded by load_lock */
+    int load_seen;        /* load_published as of the last complete texman_load_step pass */
+    struct LoadSlot load[TEX__COUNT];
+    SDL_atomic_t load_cancel;
+    uint32_t load_seed;
+    int load_done;        /* slots finished on the main thread */
+    SDL_atomic_t load_packed_count;
+    bool loading;
+    Uint64 load_start;
+    /* Residency: pages are pinned (entities hold Sprite pointers into them);
+     * standalone textures can be dropped once unreferenced and rebuilt */
+    size_t page_bytes[TEXMAN_ATLAS_MAX_PAGES];
+    size_t resident_bytes, peak_bytes, budget_bytes;
+    int evictions;
 };
-static SDL_Texture *gen_nebula(SDL_Renderer *r, uint32_t seed);
-static SDL_Texture *gen_projectiles_sheet(SDL_Renderer *r, int *out_variants);
-static SDL_Texture *gen_projectiles_sheet_proc(SDL_Renderer *r, uint32_t seed);
-static SDL_Texture *gen_explosions_sheet(SDL_Renderer *r, int *out_types, int *out_frames, int *out_tile);
+static SDL_Surface *decode_nebula(uint32_t seed, FsMapping *map);
+static SDL_Surface *decode_projectiles(uint32_t seed, FsMapping *map);
+static SDL_Texture *texture_from_pixels(SDL_Renderer *r, SDL_Surface *surf);
+static void texman_explosion_build(TextureManager *m, int explosion_type);
+static void texman_upload_explosions(TextureManager *m);
+static SDL_Surface *surface_to_rgb565(SDL_Surface *src);
 struct TextureSpec {
     const char *name;
     const char *path;
-    SDL_Texture *(*proc)(SDL_Renderer *, uint32_t);
+    SDL_Surface *(*decode)(uint32_t, FsMapping *);      /* CPU generator, runs on the loader thread */
     uint16_t flags, tile_w, tile_h;
+    uint16_t reserve_w, reserve_h;                      /* atlas space for content filled in later */
 };
 static const struct TextureSpec SPECS[TEX__COUNT] = {
-    [TEX_PLANETS_SHEET] = {"planets", "images/planets_atlas.png", NULL, TEXF_SHEET, 128, 128},
-    [TEX_PLAYER] = {"player", "images/player.png", NULL, 0, 0, 0},
-    [TEX_BG_STARFIELD] = {"bg_starfield", NULL, gen_nebula, 0, 0, 0},
-    [TEX_LOGO] = {"logo", "images/logo.png", NULL, 0, 0, 0},
-    [TEX_ICONS_SHEET] = {"icons", "images/hud_atlas.png", NULL, TEXF_SHEET, 32, 32},
-    [TEX_PROJECTILES_SHEET] = {"projectiles", NULL, gen_projectiles_sheet_proc, TEXF_SHEET, 8, 8},
-    [TEX_ENEMIES_SHEET] = {"enemies", "images/enemies_atlas.png", NULL, TEXF_SHEET, 32, 32},
-    [TEX_EXPLOSIONS_SHEET] = {"explosions", NULL, NULL, TEXF_SHEET, 0, 0}, /* generated separately (multi-frame) */
-    [TEX_UI_BUTTON_CROSS] = {"ui_button_cross", "buttons/Vita_Cross.png", NULL, 0, 0, 0},
-    [TEX_UI_BUTTON_CIRCLE] = {"ui_button_circle", "buttons/Vita_Circle.png", NULL, 0, 0, 0},
+    [TEX_PLANETS_SHEET] = {"planets", "images/planets_atlas.png", NULL, TEXF_SHEET | TEXF_ATLAS, 128, 128, 0, 0},
+    [TEX_PLAYER] = {"player", "images/player.png", NULL, TEXF_ATLAS, 0, 0, 0, 0},
+    [TEX_BG_STARFIELD] = {"bg_starfield", NULL, decode_nebula, TEXF_RGB565, 0, 0, 0, 0},
+    [TEX_LOGO] = {"logo", "images/logo.png", NULL, 0, 0, 0, 0, 0},
+    [TEX_ICONS_SHEET] = {"icons", "images/hud_atlas.png", NULL, TEXF_SHEET | TEXF_ATLAS, 32, 32, 0, 0},
+    [TEX_PROJECTILES_SHEET] = {"projectiles", NULL, decode_projectiles, TEXF_SHEET | TEXF_ATLAS, 8, 8, 0, 0},
+    [TEX_ENEMIES_SHEET] = {"enemies", "images/enemies_atlas.png", NULL, TEXF_SHEET | TEXF_ATLAS, 32, 32, 0, 0},
+    /* procedural multi-type multi-frame explosions, strips are uploaded lazily */
+    [TEX_EXPLOSIONS_SHEET] = {"explosions", NULL, NULL, TEXF_SHEET | TEXF_ATLAS, EXPLOSION_GEN_TILE, EXPLOSION_GEN_TILE,
+                              EXPLOSION_GEN_TILE * EXPLOSION_GEN_FRAMES, EXPLOSION_GEN_TILE * EXPLOSION_GEN_TYPES},
+    [TEX_UI_BUTTON_CROSS] = {"ui_button_cross", "buttons/Vita_Cross.png", NULL, TEXF_ATLAS, 0, 0, 0, 0},
+    [TEX_UI_BUTTON_CIRCLE] = {"ui_button_circle", "buttons/Vita_Circle.png", NULL, TEXF_ATLAS, 0, 0, 0, 0},
+};
+/* Menu dependencies first so the loading screen can hand off early */
+static const TextureID LOAD_ORDER[TEX__COUNT] = {
+    TEX_BG_STARFIELD, TEX_LOGO, TEX_UI_BUTTON_CROSS, TEX_UI_BUTTON_CIRCLE, TEX_ICONS_SHEET,
+    TEX_PLANETS_SHEET, TEX_PLAYER, TEX_ENEMIES_SHEET, TEX_PROJECTILES_SHEET, TEX_EXPLOSIONS_SHEET,
+};
+/* Sprite ID ranges, in sheet tile order (row-major) */
+static const struct {
+    TextureID sheet;
+    SpriteID first;
+    int count;
+} SPRITE_RANGES[] = {
+    {TEX_PLANETS_SHEET, SPR_PLANET_FIRST, TEX_PLANET_SPRITES},
+    {TEX_PLAYER, SPR_PLAYER, 1},
+    {TEX_ICONS_SHEET, SPR_ICON_FIRST, TEX_ICON_SPRITES},
+    {TEX_ENEMIES_SHEET, SPR_ENEMY_FIRST, TEX_ENEMY_SPRITES},
+    {TEX_PROJECTILES_SHEET, SPR_PROJECTILE_FIRST, TEX_PROJECTILE_SPRITES},
+    {TEX_EXPLOSIONS_SHEET, SPR_EXPLOSION_FIRST, TEX_EXPLOSION_SPRITES},
+    {TEX_UI_BUTTON_CROSS, SPR_BUTTON_CROSS, 1},
+    {TEX_UI_BUTTON_CIRCLE, SPR_BUTTON_CIRCLE, 1},
 };
+static const Sprite EMPTY_SPRITE;
+/* Projectile variant colours: the disc fill and the trail */
+static const Uint8 PROJ_COLORS[TEX_PROJECTILE_SPRITES][3] = {{255, 80, 80}, {80, 255, 100}, {90, 170, 255}, {255, 200, 40}, {200, 120, 255}, {120, 255, 255}};
+
 TextureManager *texman_create(SDL_Renderer *sdl, const char *assets_root) {
     TextureManager *m = calloc(1, sizeof(*m));
     if (!m)
@@ -51,54 +130,564 @@ TextureManager *texman_create(SDL_Renderer *sdl, const char *assets_root) {
     m->sdl = sdl;
     if (assets_root)
         strncpy(m->assets_root, assets_root, sizeof(m->assets_root) - 1);
+    for (int i = 0; i < TEX__COUNT; i++)
+        m->base[i].page = -1;
+    m->budget_bytes = TEXMAN_VRAM_BUDGET;
+    SDL_RendererInfo info;
+    if (sdl && SDL_GetRendererInfo(sdl, &info) == 0) {
+        m->format_count = (int)info.num_texture_formats;
+        if (m->format_count > (int)(sizeof(m->formats) / sizeof(m->formats[0])))
+            m->format_count = (int)(sizeof(m->formats) / sizeof(m->formats[0]));
+        memcpy(m->formats, info.texture_formats, sizeof(Uint32) * (size_t)m->format_count);
+    }
+    /* Sprites are filled in place once the atlas is up, so these pointers are
+     * valid (if empty) from the start */
+    for (int i = 0; i < TEX_PROJECTILE_SPRITES; i++) {
+        ProjectileStyle *st = &m->projectile_styles[i];
+        st->sprite = &m->sprites[SPR_PROJECTILE_FIRST + i];
+        st->r = PROJ_COLORS[i][0];
+        st->g = PROJ_COLORS[i][1];
+        st->b = PROJ_COLORS[i][2];
+    }
 
     return m;
 }
-bool texman_load_textures(TextureManager *m, uint32_t seed) {
-    SDL_Renderer *sdl = m->sdl;
+/* ---------------- Atlas --------------------------------------------------- */
+/* Shelf packer: members sorted by height go into the first shelf with room,
+ * new shelves open below, a second page opens when the first is full. */
+struct AtlasShelf {
+    int page, y, h, x;
+};
+static int atlas_member_h(const struct TextureSpec *s, const SDL_Surface *surf) {
+    return surf ? surf->h : s->reserve_h;
+}
+static int atlas_member_w(const struct TextureSpec *s, const SDL_Surface *surf) {
+    return surf ? surf->w : s->reserve_w;
+}
+static int atlas_pack(TextureManager *m) {
+    TextureID order[TEX__COUNT];
+    int n = 0;
+    for (int i = 0; i < TEX__COUNT; i++)
+        if ((SPECS[i].flags & TEXF_ATLAS) && atlas_member_w(&SPECS[i], m->load[i].surface) > 0)
+            order[n++] = (TextureID)i;
+    /* tallest first */
+    for (int a = 1; a < n; a++) {
+        TextureID t = order[a];
+        int th = atlas_member_h(&SPECS[t], m->load[t].surface);
+        int b = a - 1;
+        while (b >= 0 && atlas_member_h(&SPECS[order[b]], m->load[order[b]].surface) < th) {
+            order[b + 1] = order[b];
+            b--;
+        }
+        order[b + 1] = t;
+    }
+    struct AtlasShelf shelves[TEX__COUNT * TEXMAN_ATLAS_MAX_PAGES];
+    int shelf_count = 0;
+    int page_used_h[TEXMAN_ATLAS_MAX_PAGES] = {0};
+    int pages = 0;
+    const int size = TEXMAN_ATLAS_PAGE_SIZE, pad = TEXMAN_ATLAS_PADDING;
+    for (int k = 0; k < n; k++) {
+        TextureID id = order[k];
+        int w = atlas_member_w(&SPECS[id], m->load[id].surface) + pad * 2;
+        int h = atlas_member_h(&SPECS[id], m->load[id].surface) + pad * 2;
+        if (w > size || h > size) {
+            LOG_WARN("texman", "%s (%dx%d) does not fit an atlas page", SPECS[id].name, w, h);
+            continue;
+        }
+        struct AtlasShelf *shelf = NULL;
+        for (int s = 0; s < shelf_count && !shelf; s++)
+            if (shelves[s].h >= h && shelves[s].x + w <= size)
+                shelf = &shelves[s];
+        if (!shelf) {
+            int page = pages > 0 ? pages - 1 : 0;
+            if (pages == 0 || page_used_h[page] + h > size) {
+                if (pages >= TEXMAN_ATLAS_MAX_PAGES) {
+                    LOG_WARN("texman", "Atlas full, %s left out", SPECS[id].name);
+                    continue;
+                }
+                page = pages++;
+            }
+            shelf = &shelves[shelf_count++];
+            shelf->page = page;
+            shelf->y = page_used_h[page];
+            shelf->h = h;
+            shelf->x = 0;
+            page_used_h[page] += h;
+        }
+        m->base[id].page = shelf->page;
+        m->base[id].atlas = (SDL_Rect){shelf->x + pad, shelf->y + pad, w - pad * 2, h - pad * 2};
+        shelf->x += w;
+    }
+    for (int p = 0; p < pages; p++)
+        m->page_h[p] = page_used_h[p];
+    return pages;
+}
+/* Loader thread: place every member and blit its pixels into RGBA32 pages. */
+static void atlas_compose(TextureManager *m) {
+    int pages = atlas_pack(m);
+    for (int p = 0; p < pages; p++) {
+        /* freshly created surfaces are zeroed, i.e. transparent */
+        m->page_pixels[p] = SDL_CreateRGBSurfaceWithFormat(0, TEXMAN_ATLAS_PAGE_SIZE, m->page_h[p], 32,
+                                                           SDL_PIXELFORMAT_RGBA32);
+        if (!m->page_pixels[p])
+            LOG_ERROR("texman", "Failed to allocate atlas page %d: %s", p, SDL_GetError());
+    }
     for (int i = 0; i < TEX__COUNT; i++) {
+        if (!(SPECS[i].flags & TEXF_ATLAS))
+            continue;
+        struct LoadSlot *slot = &m->load[i];
+        SDL_Surface *page = m->base[i].page >= 0 ? m->page_pixels[m->base[i].page] : NULL;
+        if (!page) {
+            /* Left out of the atlas: the main thread makes it a standalone
+             * texture instead; reserved-only members get a transparent one */
+            m->base[i].page = -1;
+            if (!slot->surface && SPECS[i].reserve_w > 0) {
+                slot->surface = SDL_CreateRGBSurfaceWithFormat(0, SPECS[i].reserve_w, SPECS[i].reserve_h, 32,
+                                                               SDL_PIXELFORMAT_RGBA32);
+                slot->final_pixels = slot->surface != NULL;
+            }
+            continue;
+        }
+        if (slot->surface) {
+            const SDL_Rect *a = &m->base[i].atlas;
+            Uint8 *dst = (Uint8 *)page->pixels + (size_t)a->y * page->pitch + (size_t)a->x * 4;
+            SDL_ConvertPixels(a->w, a->h, slot->surface->format->format, slot->surface->pixels, slot->surface->pitch,
+                              SDL_PIXELFORMAT_RGBA32, dst, page->pitch);
+        }
+        if (slot->surface) {
+            SDL_FreeSurface(slot->surface);
+            slot->surface = NULL;
+        }
+        fs_unmap_file(&slot->map);
+        vfs_close(&slot->file);
+    }
+    m->page_count = pages;
+    for (int p = 0; p < pages; p++)
+        LOG_INFO("texman", "Atlas page %d: %dx%d", p, TEXMAN_ATLAS_PAGE_SIZE, m->page_h[p]);
+}
+/* Main thread: sprite table with source rects and normalised UVs */
+static void atlas_build_sprites(TextureManager *m) {
+    for (size_t r = 0; r < sizeof(SPRITE_RANGES) / sizeof(SPRITE_RANGES[0]); r++) {
+        const struct BaseSlot *b = &m->base[SPRITE_RANGES[r].sheet];
+        int tw = b->tile_w ? b->tile_w : b->w;
+        int th = b->tile_h ? b->tile_h : b->h;
+        int cols = tw > 0 ? b->w / tw : 0;
+        for (int k = 0; k < SPRITE_RANGES[r].count; k++) {
+            Sprite *s = &m->sprites[SPRITE_RANGES[r].first + k];
+            *s = EMPTY_SPRITE;
+            if (!b->tex || cols <= 0)
+                continue;
+            int ox = b->page >= 0 ? b->atlas.x : 0;
+            int oy = b->page >= 0 ? b->atlas.y : 0;
+            int tex_w = b->page >= 0 ? TEXMAN_ATLAS_PAGE_SIZE : b->w;
+            int tex_h = b->page >= 0 ? m->page_h[b->page] : b->h;
+            s->tex = b->tex;
+            s->src = (SDL_Rect){ox + (k % cols) * tw, oy + (k / cols) * th, tw, th};
+            s->u0 = (float)s->src.x / (float)tex_w;
+            s->v0 = (float)s->src.y / (float)tex_h;
+            s->u1 = (float)(s->src.x + s->src.w) / (float)tex_w;
+            s->v1 = (float)(s->src.y + s->src.h) / (float)tex_h;
+        }
+    }
+}
+/* ---------------- Formats ------------------------------------------------- */
+static bool texman_supports(const TextureManager *m, Uint32 format) {
+    for (int i = 0; i < m->format_count; i++)
+        if (m->formats[i] == format)
+            return true;
+    return false;
+}
+/* Reduced-precision format a spec opted into, if the renderer takes it;
+ * 0 keeps the decoded format */
+static Uint32 texman_pick_format(const TextureManager *m, const struct TextureSpec *s) {
+    if ((s->flags & TEXF_RGB565) && texman_supports(m, SDL_PIXELFORMAT_RGB565))
+        return SDL_PIXELFORMAT_RGB565;
+    return 0;
+}
+/* ---------------- Decoding ------------------------------------------------ */
+/* Decode one texture into a surface (any thread). The surface may point into
+ * map/file, which then have to stay open until it is freed. A non-zero
+ * `format` converts the result (the copy no longer needs map/file). */
+static SDL_Surface *texman_decode(const struct TextureSpec *s, uint32_t seed, Uint32 format, FsMapping *map,
+                                  VfsFile *file, bool *final_pixels) {
+    SDL_Surface *surf = NULL;
+    memset(map, 0, sizeof(*map));
+    memset(file, 0, sizeof(*file));
+    *final_pixels = false;
+    if (s->decode) {
+        surf = s->decode(seed, map);
+        *final_pixels = true;
+    } else if (s->path) {
+        if (!vfs_open(s->path, file)) {
+            LOG_WARN("texman", "Failed to open %s/%s", vfs_root(), s->path);
+        } else if (file->kind == VFS_TEXTURE && file->format == VFS_FORMAT_RGBA32) {
+            /* Pre-decoded in the pack: wrap the mapping, no copy */
+            surf = SDL_CreateRGBSurfaceWithFormatFrom((void *)file->data, file->width, file->height, 32, file->pitch,
+                                                      SDL_PIXELFORMAT_RGBA32);
+            *final_pixels = true;
+        } else {
+            surf = IMG_Load_RW(SDL_RWFromConstMem(file->data, (int)file->size), 1);
+            if (!surf)
+                LOG_WARN("texman", "Failed to decode %s: %s", s->path, SDL_GetError());
+            vfs_close(file);
+        }
+    }
+    if (surf && format == SDL_PIXELFORMAT_RGB565) {
+        SDL_Surface *low = surface_to_rgb565(surf);
+        if (low) {
+            LOG_INFO("texman", "%s: %d KB -> %d KB as RGB565", s->name, surf->pitch * surf->h / 1024,
+                     low->pitch * low->h / 1024);
+            SDL_FreeSurface(surf);
+            fs_unmap_file(map);
+            vfs_close(file);
+            surf = low;
+            *final_pixels = true;
+        }
+    }
+    return surf;
+}
+static int texman_loader_thread(void *user) {
+    TextureManager *m = (TextureManager *)user;
+    for (int k = 0; k < TEX__COUNT; k++) {
+        if (SDL_AtomicGet(&m->load_cancel))
+            return 0;
+        TextureID i = LOAD_ORDER[k];
         const struct TextureSpec *s = &SPECS[i];
-        SDL_Texture *tex = NULL;
-        if (s->proc)
-            tex = s->proc(sdl, seed);
-        else if (s->path) {
-            char buf[256];
-            snprintf(buf, sizeof(buf), "%s/%s", m->assets_root[0] ? m->assets_root : "./assets", s->path);
-            SDL_Surface *surf = IMG_Load(buf);
-            if (surf) {
-                tex = SDL_CreateTextureFromSurface(sdl, surf);
-                SDL_FreeSurface(surf);
+        FsMapping map;
+        VfsFile file;
+        bool final_pixels = false;
+        SDL_Surface *surf = texman_decode(s, m->load_seed, texman_pick_format(m, s), &map, &file, &final_pixels);
+        if (file.packed)
+            SDL_AtomicAdd(&m->load_packed_count, 1);
+        /* Atlas members stay here until every sheet is decoded */
+        SDL_LockMutex(m->load_lock);
+        m->load[i].surface = surf;
+        m->load[i].map = map;
+        m->load[i].file = file;
+        m->load[i].final_pixels = final_pixels && surf;
+        if (!(s->flags & TEXF_ATLAS))
+            SDL_AtomicSet(&m->load[i].state, LOAD_DECODED);
+        m->load_published++;
+        SDL_CondSignal(m->load_cond);
+        SDL_UnlockMutex(m->load_lock);
+    }
+    atlas_compose(m);
+    SDL_LockMutex(m->load_lock);
+    m->atlas_state = LOAD_DECODED;
+    m->load_published++;
+    SDL_CondSignal(m->load_cond);
+    SDL_UnlockMutex(m->load_lock);
+    /* Explosion strips come last: the menu can show while they are built, but
+     * loading only finishes once every type is in the atlas */
+    for (int t = 0; t < EXPLOSION_GEN_TYPES; t++) {
+        if (SDL_AtomicGet(&m->load_cancel))
+            return 0;
+        texman_explosion_build(m, t);
+        SDL_LockMutex(m->load_lock);
+        m->explosions_built++;
+        m->load_published++;
+        SDL_CondSignal(m->load_cond);
+        SDL_UnlockMutex(m->load_lock);
+    }
+    return 0;
 }
+/* ---------------- Residency ----------------------------------------------- */
+static size_t texture_bytes(SDL_Texture *tex, Uint32 *format_out) {
+    Uint32 format = 0;
+    int w = 0, h = 0;
+    if (!tex || SDL_QueryTexture(tex, &format, NULL, &w, &h) != 0)
+        return 0;
+    if (format_out)
+        *format_out = format;
+    return (size_t)w * (size_t)h * SDL_BYTESPERPIXEL(format);
+}
+/* Formats without alpha are drawn opaque, which is also cheaper to fill */
+static void texture_set_blend(SDL_Texture *tex, Uint32 format) {
+    SDL_SetTextureBlendMode(tex, SDL_ISPIXELFORMAT_ALPHA(format) ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+}
+static void texman_account(TextureManager *m, size_t added, size_t removed) {
+    m->resident_bytes = m->resident_bytes + added - removed;
+    if (m->resident_bytes > m->peak_bytes)
+        m->peak_bytes = m->resident_bytes;
+}
+static bool texman_evictable(TextureManager *m, TextureID i) {
+    const struct BaseSlot *b = &m->base[i];
+    /* atlas members left on their own are pinned like the pages */
+    return b->tex && b->page < 0 && !(b->flags & TEXF_ATLAS) && b->refs == 0 &&
+           SDL_AtomicGet(&m->load[i].state) == LOAD_DONE;
+}
+/* Drop unreferenced standalone textures, least recently released first, until
+ * `incoming` more bytes fit into the budget */
+static void texman_evict_to_fit(TextureManager *m, size_t incoming) {
+    while (m->resident_bytes + incoming > m->budget_bytes) {
+        int victim = -1;
+        for (int i = 0; i < TEX__COUNT; i++) {
+            if (texman_evictable(m, (TextureID)i) && (victim < 0 || m->base[i].released_at < m->base[victim].released_at))
+                victim = i;
         }
-        if (tex)
-            SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-        m->base[i].tex = tex;
-        m->base[i].flags = s->flags;
-        m->base[i].tile_w = s->tile_w;
-        m->base[i].tile_h = s->tile_h;
-    }
-    if (m->projectile_variant_count <= 0 && m->base[TEX_PROJECTILES_SHEET].tex) {
-        int w, h;
-        Uint32 f;
-        int acc;
-        if (SDL_QueryTexture(m->base[TEX_PROJECTILES_SHEET].tex, &f, &acc, &w, &h) == 0 && m->base[TEX_PROJECTILES_SHEET].tile_w > 0)
-            m->projectile_variant_count = w / m->base[TEX_PROJECTILES_SHEET].tile_w;
-    }
-    /* Generate explosions sheet (types x frames atlas) */
-    m->explosions_sheet = gen_explosions_sheet(sdl, &m->explosion_types, &m->explosion_frames, &m->explosion_tile);
-    if (m->explosions_sheet)
-        SDL_SetTextureBlendMode(m->explosions_sheet, SDL_BLENDMODE_BLEND);
-
+        if (victim < 0)
+            return;
+        struct BaseSlot *b = &m->base[victim];
+        SDL_DestroyTexture(b->tex);
+        b->tex = NULL;
+        texman_account(m, 0, b->bytes);
+        m->evictions++;
+        LOG_INFO("texman", "Evicted %s (%zu KB), resident %zu KB of %zu KB", SPECS[victim].name, b->bytes / 1024,
+                 m->resident_bytes / 1024, m->budget_bytes / 1024);
+    }
+}
+/* Rebuild an evicted standalone texture on the main thread */
+static SDL_Texture *texman_make_resident(TextureManager *m, TextureID i) {
+    struct BaseSlot *b = &m->base[i];
+    if (b->tex || b->page >= 0 || SDL_AtomicGet(&m->load[i].state) != LOAD_DONE)
+        return b->tex;
+    texman_evict_to_fit(m, b->bytes);
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    FsMapping map;
+    VfsFile file;
+    bool final_pixels = false;
+    SDL_Surface *surf = texman_decode(&SPECS[i], m->load_seed, texman_pick_format(m, &SPECS[i]), &map, &file, &final_pixels);
+    if (surf) {
+        b->tex = final_pixels ? texture_from_pixels(m->sdl, surf) : SDL_CreateTextureFromSurface(m->sdl, surf);
+        SDL_FreeSurface(surf);
+    }
+    fs_unmap_file(&map);
+    vfs_close(&file);
+    if (!b->tex) {
+        LOG_WARN("texman", "Failed to rebuild %s", SPECS[i].name);
+        return NULL;
+    }
+    SDL_QueryTexture(b->tex, NULL, NULL, &b->w, &b->h);
+    b->bytes = texture_bytes(b->tex, &b->format);
+    texture_set_blend(b->tex, b->format);
+    texman_account(m, b->bytes, 0);
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    LOG_INFO("texman", "Reloaded %s (%zu KB) in %.1f ms", SPECS[i].name, b->bytes / 1024, ms);
+    return b->tex;
+}
+/* ---------------- Loading ------------------------------------------------- */
+static void texman_finish_slot(TextureManager *m, TextureID i, SDL_Texture *tex) {
+    const struct TextureSpec *s = &SPECS[i];
+    struct BaseSlot *b = &m->base[i];
+    b->tex = tex;
+    b->flags = s->flags;
+    b->tile_w = s->tile_w;
+    b->tile_h = s->tile_h;
+    if (b->page >= 0) {
+        b->w = b->atlas.w;
+        b->h = b->atlas.h;
+        b->format = SDL_PIXELFORMAT_RGBA32;
+        b->bytes = (size_t)b->atlas.w * (size_t)b->atlas.h * 4;
+    } else {
+        b->w = b->h = 0;
+        b->bytes = 0;
+        if (tex) {
+            SDL_QueryTexture(tex, NULL, NULL, &b->w, &b->h);
+            b->bytes = texture_bytes(tex, &b->format);
+            texture_set_blend(tex, b->format);
+        }
+        texman_account(m, b->bytes, 0);
+    }
+    SDL_AtomicSet(&m->load[i].state, LOAD_DONE);
+    m->load_done++;
+}
+/* Main thread: texture from a slot's decoded surface, releasing the surface
+ * and whatever backed it */
+static SDL_Texture *texman_upload_slot(TextureManager *m, TextureID i) {
+    struct LoadSlot *slot = &m->load[i];
+    SDL_Texture *tex = NULL;
+    if (slot->surface) {
+        if (slot->final_pixels)
+            tex = texture_from_pixels(m->sdl, slot->surface);
+        else
+            tex = SDL_CreateTextureFromSurface(m->sdl, slot->surface);
+        SDL_FreeSurface(slot->surface);
+        slot->surface = NULL;
+    }
+    fs_unmap_file(&slot->map);
+    vfs_close(&slot->file);
+    return tex;
+}
+/* Main thread: upload the composed pages and point every member at its page */
+static void texman_finish_atlas(TextureManager *m) {
+    for (int p = 0; p < m->page_count; p++) {
+        if (!m->page_pixels[p])
+            continue;
+        m->pages[p] = texture_from_pixels(m->sdl, m->page_pixels[p]);
+        if (m->pages[p])
+            SDL_SetTextureBlendMode(m->pages[p], SDL_BLENDMODE_BLEND);
+        m->page_bytes[p] = texture_bytes(m->pages[p], NULL);
+        texman_account(m, m->page_bytes[p], 0);
+        SDL_FreeSurface(m->page_pixels[p]);
+        m->page_pixels[p] = NULL;
+    }
+    for (int i = 0; i < TEX__COUNT; i++) {
+        if (!(SPECS[i].flags & TEXF_ATLAS))
+            continue;
+        int page = m->base[i].page;
+        if (page >= 0 && !m->pages[page])
+            m->base[i].page = page = -1;
+        SDL_Texture *tex = page >= 0 ? m->pages[page] : texman_upload_slot(m, (TextureID)i);
+        if (page < 0 && tex) {
+            m->base[i].atlas = (SDL_Rect){0, 0, 0, 0};
+            LOG_WARN("texman", "%s loaded as a standalone texture", SPECS[i].name);
+        }
+        texman_finish_slot(m, (TextureID)i, tex);
+    }
+    m->atlas_state = LOAD_DONE;
+}
+bool texman_load_begin(TextureManager *m, uint32_t seed) {
+    if (!m || m->loading)
+        return false;
+    m->load_seed = seed;
+    m->load_done = 0;
+    m->atlas_state = LOAD_PENDING;
+    m->load_start = SDL_GetPerformanceCounter();
+    memset(m->load, 0, sizeof(m->load));
+    SDL_AtomicSet(&m->load_cancel, 0);
+    SDL_AtomicSet(&m->load_packed_count, 0);
+    if (!m->load_lock)
+        m->load_lock = SDL_CreateMutex();
+    if (!m->load_cond)
+        m->load_cond = SDL_CreateCond();
+    m->load_published = 0;
+    m->load_seen = 0;
+    m->explosions_built = 0;
+    if (!m->explosion_lock)
+        m->explosion_lock = SDL_CreateMutex();
+    m->loading = true;
+    m->loader = m->load_lock ? SDL_CreateThread(texman_loader_thread, "texman_load", m) : NULL;
+    if (!m->loader) {
+        LOG_WARN("texman", "Loading textures on the main thread: %s", SDL_GetError());
+        texman_loader_thread(m);
+    }
+    return true;
+}
+bool texman_load_step(TextureManager *m, double budget_ms) {
+    if (!m)
+        return true;
+    if (!m->loading)
+        return true;
+    Uint64 freq = SDL_GetPerformanceFrequency();
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budget = (Uint64)(budget_ms * (double)freq / 1000.0);
+    SDL_LockMutex(m->load_lock);
+    int published = m->load_published;
+    SDL_UnlockMutex(m->load_lock);
+    for (int k = 0; k < TEX__COUNT; k++) {
+        if (SDL_GetPerformanceCounter() - start > budget)
+            return false;
+        TextureID i = LOAD_ORDER[k];
+        const struct TextureSpec *s = &SPECS[i];
+        if (SDL_AtomicGet(&m->load[i].state) == LOAD_DONE)
+            continue;
+        if (s->flags & TEXF_ATLAS) {
+            SDL_LockMutex(m->load_lock);
+            bool composed = m->atlas_state == LOAD_DECODED;
+            SDL_UnlockMutex(m->load_lock);
+            if (composed)
+                texman_finish_atlas(m);
+            continue;
+        }
+        if (SDL_AtomicGet(&m->load[i].state) != LOAD_DECODED)
+            continue;
+        texman_finish_slot(m, i, texman_upload_slot(m, i));
+    }
+    /* Everything handed over before this pass has been taken */
+    m->load_seen = published;
+    if (m->load_done < TEX__COUNT)
+        return false;
+    /* Strips are uploaded as they arrive; a type that failed to build stays transparent */
+    SDL_LockMutex(m->load_lock);
+    int built = m->explosions_built;
+    SDL_UnlockMutex(m->load_lock);
+    texman_upload_explosions(m);
+    if (built < EXPLOSION_GEN_TYPES)
+        return false;
+    atlas_build_sprites(m);
+    const struct BaseSlot *proj = &m->base[TEX_PROJECTILES_SHEET];
+    if (proj->tex && proj->tile_w > 0)
+        m->projectile_variant_count = proj->w / proj->tile_w;
+    if (m->base[TEX_EXPLOSIONS_SHEET].tex) {
+        m->explosion_types = EXPLOSION_GEN_TYPES;
+        m->explosion_frames = EXPLOSION_GEN_FRAMES;
+        m->explosion_tile = EXPLOSION_GEN_TILE;
+    }
+    if (m->loader) {
+        SDL_WaitThread(m->loader, NULL);
+        m->loader = NULL;
+    }
+    m->loading = false;
+    double ms = (double)(SDL_GetPerformanceCounter() - m->load_start) * 1000.0 / (double)freq;
+    LOG_INFO("texman", "Textures ready in %.1f ms (%d from the asset pack)", ms, SDL_AtomicGet(&m->load_packed_count));
+    return true;
+}
+float texman_load_progress(TextureManager *m) {
+    if (!m)
+        return 0.f;
+    if (!m->loading)
+        return 1.f;
+    SDL_LockMutex(m->load_lock);
+    int built = m->explosions_built;
+    SDL_UnlockMutex(m->load_lock);
+    return (float)(m->load_done + built) / (float)(TEX__COUNT + EXPLOSION_GEN_TYPES);
+}
+bool texman_is_ready(TextureManager *m, TextureID id) {
+    if (!m || id < 0 || id >= TEX__COUNT)
+        return false;
+    return SDL_AtomicGet(&m->load[id].state) == LOAD_DONE;
+}
+bool texman_load_wait(TextureManager *m) {
+    if (!m || !m->loading)
+        return false;
+    if (!m->load_lock || !m->load_cond) {
+        SDL_Delay(1);
+        return true;
+    }
+    SDL_LockMutex(m->load_lock);
+    while (m->load_published == m->load_seen)
+        SDL_CondWait(m->load_cond, m->load_lock);
+    SDL_UnlockMutex(m->load_lock);
+    return true;
+}
+bool texman_load_textures(TextureManager *m, uint32_t seed) {
+    if (!texman_load_begin(m, seed))
+        return false;
+    while (!texman_load_step(m, 1000.0))
+        texman_load_wait(m);
     return true;
 }
 void texman_destroy(TextureManager *m) {
     if (!m)
         return;
+    if (m->loader) {
+        SDL_AtomicSet(&m->load_cancel, 1);
+        SDL_WaitThread(m->loader, NULL);
+        m->loader = NULL;
+    }
+    for (int i = 0; i < TEX__COUNT; i++) {
+        if (m->load[i].surface)
+            SDL_FreeSurface(m->load[i].surface);
+        fs_unmap_file(&m->load[i].map);
+        vfs_close(&m->load[i].file);
+    }
+    if (m->load_cond)
+        SDL_DestroyCond(m->load_cond);
+    if (m->load_lock)
+        SDL_DestroyMutex(m->load_lock);
     for (int i = 0; i < TEX__COUNT; i++)
-        if (m->base[i].tex)
+        if (m->base[i].tex && m->base[i].page < 0)
             SDL_DestroyTexture(m->base[i].tex);
-    if (m->explosions_sheet)
-        SDL_DestroyTexture(m->explosions_sheet);
+    for (int p = 0; p < TEXMAN_ATLAS_MAX_PAGES; p++) {
+        if (m->pages[p])
+            SDL_DestroyTexture(m->pages[p]);
+        if (m->page_pixels[p])
+            SDL_FreeSurface(m->page_pixels[p]);
+    }
+    for (int t = 0; t < EXPLOSION_GEN_TYPES; t++)
+        free(m->explosion_pending[t]);
+    if (m->explosion_lock)
+        SDL_DestroyMutex(m->explosion_lock);
     free(m);
 }
 SDL_Texture *texman_get(TextureManager *m, TextureID id) {
@@ -106,226 +695,138 @@ SDL_Texture *texman_get(TextureManager *m, TextureID id) {
         return NULL;
     return m->base[id].tex;
 }
-SDL_Rect texman_planet_src_rect(int idx) {
-    if (idx < 0)
-        idx = 0;
-    if (idx > 15)
-        idx = 15;
-    int cell = 128;
-    return (SDL_Rect){(idx % 4) * cell, (idx / 4) * cell, cell, cell
-};
+const Sprite *texman_sprite(TextureManager *m, SpriteID id) {
+    if (!m || id < 0 || id >= SPR__COUNT)
+        return &EMPTY_SPRITE;
+    return &m->sprites[id];
 }
-static SDL_Rect sheet_src(TextureManager *m, TextureID id, int index) {
-    SDL_Rect r = {0, 0, 0, 0
-};
-    if (!m || id < 0 || id >= TEX__COUNT)
-        return r;
-    struct BaseSlot *b = &m->base[id];
-    if (!(b->flags & TEXF_SHEET) || !b->tex)
-        return r;
-    int w, h;
-    Uint32 f;
-    int acc;
-    if (SDL_QueryTexture(b->tex, &f, &acc, &w, &h) != 0)
-        return r;
-    if (!b->tile_w || !b->tile_h)
-        return r;
-    int cols = w / b->tile_w;
-    if (cols <= 0)
-        return r;
-    if (index < 0)
-        index = 0;
-    int row = index / cols;
-    int col = index % cols;
-    r.x = col * b->tile_w;
-    r.y = row * b->tile_h;
-    r.w = b->tile_w;
-    r.h = b->tile_h;
-    return r;
-}
-SDL_Rect texman_sheet_src(TextureManager *m, TextureID id, int index) {
-    return sheet_src(m, id, index);
-}
-SDL_Texture *texman_projectiles_texture(TextureManager *m) {
-    return m ? m->base[TEX_PROJECTILES_SHEET].tex : NULL;
-}
-SDL_Rect texman_projectile_src(TextureManager *m, int variant_index) {
-    if (!m)
-        return (SDL_Rect){0, 0, 0, 0
-};
-    if (variant_index < 0)
-        variant_index = 0;
-    if (variant_index >= m->projectile_variant_count)
-        variant_index = m->projectile_variant_count - 1;
-    return sheet_src(m, TEX_PROJECTILES_SHEET, variant_index);
+const Sprite *texman_sprites(TextureManager *m) {
+    return m ? m->sprites : NULL;
 }
 int texman_projectile_variant_count(TextureManager *m) {
     return m ? m->projectile_variant_count : 0;
 }
-static const Uint8 PROJ_COLORS[][3] = {{255, 80, 80}, {80, 255, 100}, {90, 170, 255}, {255, 200, 40}, {200, 120, 255}, {120, 255, 255}};
-bool texman_projectile_variant_color(TextureManager *m, int idx, Uint8 *r, Uint8 *g, Uint8 *b) {
-    (void)m;
-    int max = (int)(sizeof(PROJ_COLORS) / sizeof(PROJ_COLORS[0]));
-    if (idx < 0 || idx >= max)
-        return false;
-    if (r)
-        *r = PROJ_COLORS[idx][0];
-    if (g)
-        *g = PROJ_COLORS[idx][1];
-    if (b)
-        *b = PROJ_COLORS[idx][2];
-    return true;
-}
-bool texman_regen_nebula(TextureManager *m, uint32_t seed) {
+const ProjectileStyle *texman_projectile_style(TextureManager *m, int variant) {
+    static const ProjectileStyle fallback = {&EMPTY_SPRITE, 255, 255, 255};
     if (!m)
-        return false;
-    SDL_Texture *old = m->base[TEX_BG_STARFIELD].tex;
-    SDL_Texture *neu = gen_nebula(m->sdl, seed);
-    if (!neu)
-        return false;
-    m->base[TEX_BG_STARFIELD].tex = neu;
-    if (old)
-        SDL_DestroyTexture(old);
-    return true;
+        return &fallback;
+    int max = m->projectile_variant_count > 0 ? m->projectile_variant_count : 1;
+    if (variant >= max)
+        variant = max - 1;
+    if (variant < 0)
+        variant = 0;
+    return &m->projectile_styles[variant];
+}
+SDL_Texture *texman_acquire(TextureManager *m, TextureID id) {
+    if (!m || id < 0 || id >= TEX__COUNT)
+        return NULL;
+    m->base[id].refs++;
+    return texman_make_resident(m, id);
+}
+void texman_release(TextureManager *m, TextureID id) {
+    if (!m || id < 0 || id >= TEX__COUNT || m->base[id].refs <= 0)
+        return;
+    if (--m->base[id].refs == 0)
+        m->base[id].released_at = SDL_GetPerformanceCounter();
+}
+void texman_set_budget(TextureManager *m, size_t bytes) {
+    if (m)
+        m->budget_bytes = bytes;
+}
+void texman_trim(TextureManager *m) {
+    if (m && !m->loading)
+        texman_evict_to_fit(m, 0);
 }
 TexmanStats texman_stats(TextureManager *m) {
     TexmanStats s = {0
 };
     if (!m)
         return s;
-    for (int i = 0; i < TEX__COUNT; i++)
-        if (m->base[i].tex)
+    for (int i = 0; i < TEX__COUNT; i++) {
+        const struct BaseSlot *b = &m->base[i];
+        if (b->tex)
             s.base_loaded++;
+        s.bytes[i] = b->tex ? b->bytes : 0;
+        s.refs[i] = b->refs;
+        if (b->tex && b->page < 0 && b->bytes < (size_t)b->w * (size_t)b->h * 4)
+            s.format_saved_bytes += (size_t)b->w * (size_t)b->h * 4 - b->bytes;
+    }
     s.projectile_variants = m->projectile_variant_count;
+    s.atlas_pages = m->page_count;
+    for (int p = 0; p < m->page_count; p++)
+        s.atlas_bytes += m->page_bytes[p];
+    s.resident_bytes = m->resident_bytes;
+    s.peak_bytes = m->peak_bytes;
+    s.budget_bytes = m->budget_bytes;
+    s.evictions = m->evictions;
     return s;
 }
-/* ---------------- Explosions generation ---------------------------------- */
-static inline Uint32 px_make(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-    return ((Uint32)a << 24) | ((Uint32)r << 16) | ((Uint32)g << 8) | b;
+void texman_log_stats(TextureManager *m) {
+    if (!m)
+        return;
+    TexmanStats s = texman_stats(m);
+    LOG_INFO("texman", "Resident %zu KB (peak %zu KB, budget %zu KB, %d evictions), atlas %d pages / %zu KB, "
+             "%zu KB saved by reduced formats",
+             s.resident_bytes / 1024, s.peak_bytes / 1024, s.budget_bytes / 1024, s.evictions, s.atlas_pages,
+             s.atlas_bytes / 1024, s.format_saved_bytes / 1024);
+    for (int i = 0; i < TEX__COUNT; i++)
+        LOG_DEBUG("texman", "  %-16s %6zu KB %-22s refs=%d%s", SPECS[i].name, s.bytes[i] / 1024,
+                  SDL_GetPixelFormatName(m->base[i].format), s.refs[i], m->base[i].page >= 0 ? " (atlas)" : "");
 }
-
-static void draw_explosion_frame(uint32_t *pixels, int pitch_pixels, int tile, int type, int frame, int total_frames) {
-
-    int size = tile;
-    int center = size / 2;
-    float frame_progress = (float)frame / (float)(total_frames - 1);
-    float max_radius = center * 0.9f;
-    struct Config {
-        float r, g, b, density, inner, fade;
-
-} cfgs[4] = {
-        {1.0f, 0.6f, 0.1f, 1.2f, 0.9f, 0.4f}, // orange
-        {0.2f, 0.4f, 1.0f, 1.0f, 0.8f, 0.4f}, // blau
-        {0.3f, 1.0f, 0.2f, 0.8f, 0.7f, 0.4f}, // grün
-        {1.0f, 0.2f, 0.1f, 1.4f, 1.0f, 0.4f}  // rot
-    };
-    int idx = type % 4;
-    struct Config c = cfgs[idx];
-    srand((unsigned)(type * 1337));
-    float ring_radius = max_radius * (0.1f + frame_progress * 0.9f);
-    float ring_thickness = max_radius * (0.5f - frame_progress * 0.3f);
-    int glowing_spots[20][2];
-    float spot_int[20];
-    for (int i = 0; i < 20; i++) {
-        float ang = (float)rand() / RAND_MAX * 6.2831853f;
-        float rad = (float)rand() / RAND_MAX * max_radius * 0.8f;
-        glowing_spots[i][0] = center + (int)(cosf(ang) * rad);
-        glowing_spots[i][1] = center + (int)(sinf(ang) * rad);
-        spot_int[i] = 0.3f + ((float)rand() / RAND_MAX) * 0.7f;
-    }
-    for (int y = 0; y < size; y++) {
-        for (int x = 0; x < size; x++) {
-            float dx = (float)x - center;
-            float dy = (float)y - center;
-            float dist = sqrtf(dx * dx + dy * dy);
-            float intensity = 0.f;
-            if (dist >= ring_radius - ring_thickness && dist <= ring_radius + ring_thickness) {
-                float ring_factor = 1.f - fabsf(dist - ring_radius) / ring_thickness;
-                ring_factor = powf(ring_factor, 0.8f);
-                intensity += ring_factor * c.inner * (1.f - frame_progress * 0.6f);
-    }
-            if (frame < total_frames / 3 && dist < ring_radius * 0.7f) {
-                float inner_factor = 1.f - dist / (ring_radius * 0.7f);
-                intensity += inner_factor * c.inner * (1.f - (float)frame / (float)(total_frames / 3));
-            }
-            for (int i = 0; i < 20; i++) {
-                float sx = (float)x - glowing_spots[i][0];
-                float sy = (float)y - glowing_spots[i][1];
-                float sd = sqrtf(sx * sx + sy * sy);
-                float spot_r = max_radius * 0.15f * (1.f + frame_progress * 0.8f);
-                if (sd < spot_r) {
-                    float sf = powf(1.f - sd / spot_r, 1.2f);
-                    intensity += spot_int[i] * sf * c.density * (1.f - frame_progress * 0.5f);
-            }
-            }
-            float noise_seed = x * 0.1f + y * 0.07f;
-            float particle_noise = 0.5f + 0.5f * sinf(noise_seed * 3.0f) * cosf(noise_seed * 2.5f);
-            if (particle_noise > 0.6f && dist < ring_radius * 1.3f && dist > ring_radius * 0.2f) {
-                float p_int = (particle_noise - 0.6f) / 0.4f;
-                float df = 1.f - fabsf(dist - ring_radius) / (ring_radius * 0.8f);
-                if (df < 0)
-                    df = 0;
-                p_int *= df * c.density * (1.f - frame_progress * 0.7f);
-                intensity += p_int * 0.4f;
-            }
-            if (frame > total_frames / 4 && dist > ring_radius * 0.7f && dist < max_radius * 1.4f) {
-                float smoke_factor = 1.f - (dist - ring_radius * 0.7f) / (max_radius * 0.7f);
-                if (smoke_factor < 0)
-                    smoke_factor = 0;
-                float smoke_noise = 0.5f + 0.5f * sinf(x * 0.03f + y * 0.05f) * cosf(x * 0.04f - y * 0.06f);
-                if (smoke_noise > 0.4f) {
-                    float si = (smoke_noise - 0.4f) / 0.6f;
-                    intensity += smoke_factor * si * 0.3f * ((float)(frame - total_frames / 4) / (float)(total_frames - total_frames / 4));
-            }
-            }
-            if (intensity > 0.01f) {
-                if (intensity > 1.f)
-                    intensity = 1.f;
-                float sat_boost = 1.f + intensity * 0.2f;
-                float heat = intensity * (1.f - frame_progress * 0.4f);
-                Uint8 r8 = (Uint8)(255 * intensity * c.r * sat_boost * (0.8f + heat * 0.2f));
-                Uint8 g8 = (Uint8)(255 * intensity * c.g * sat_boost * (0.6f + heat * 0.4f));
-                Uint8 b8 = (Uint8)(255 * intensity * c.b * sat_boost * (0.4f + heat * 0.6f));
-                Uint8 a8 = (Uint8)(255 * intensity * (1.f - frame_progress * 0.3f));
-                pixels[y * pitch_pixels + x] = px_make(r8, g8, b8, a8);
-            }
+/* ---------------- Explosions ---------------------------------------------- */
+/* The atlas region starts out transparent; the loader thread produces each
+ * type's strip (cache file or generator) after the regular textures and
+ * texman_load_step copies it into the page before loading completes. */
+static void texman_explosion_build(TextureManager *m, int explosion_type) {
+    size_t count = (size_t)EXPLOSION_GEN_TILE * EXPLOSION_GEN_FRAMES * EXPLOSION_GEN_TILE;
+    uint32_t *strip = malloc(count * sizeof(uint32_t));
+    if (!strip)
+        return;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    bool cached = explosion_cache_load(explosion_type, strip);
+    if (!cached) {
+        if (!explosion_gen_type(explosion_type, strip, 0)) {
+            free(strip);
+            return;
         }
+        explosion_cache_store(explosion_type, strip);
     }
+    /* generator/cache are ARGB8888 words, the atlas page is RGBA32 bytes */
+    for (size_t i = 0; i < count; i++) {
+        uint32_t v = strip[i];
+        Uint8 *px = (Uint8 *)&strip[i];
+        px[0] = (Uint8)(v >> 16);
+        px[1] = (Uint8)(v >> 8);
+        px[2] = (Uint8)v;
+        px[3] = (Uint8)(v >> 24);
+    }
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    LOG_DEBUG("texman", "Explosion type %d %s in %.2f ms", explosion_type, cached ? "loaded from cache" : "generated", ms);
+
+    SDL_LockMutex(m->explosion_lock);
+    free(m->explosion_pending[explosion_type]);
+    m->explosion_pending[explosion_type] = strip;
+    SDL_UnlockMutex(m->explosion_lock);
 }
-static SDL_Texture *gen_explosions_sheet(SDL_Renderer *r, int *out_types, int *out_frames, int *out_tile) {
-    int types = 4;
-    int frames = 12; /* 0..11 original logic */
-    int tile = 64;   /* each explosion frame 64x64 */
-    int w = tile * frames;
-    int h = tile * types;
-    SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, w, h);
-    if (!tex)
-        return NULL;
-    void *pixels;
-    int pitch;
-    if (SDL_LockTexture(tex, NULL, &pixels, &pitch) != 0) {
-        SDL_DestroyTexture(tex);
-        return NULL;
-}
-    int pitch_pixels = pitch / 4;
-    uint32_t *px = (uint32_t *)pixels;
-    for (int t = 0; t < types; t++) {
-        for (int f = 0; f < frames; f++) {
-            uint32_t *frame_base = px + (t * tile * pitch_pixels) + (f * tile);
-            draw_explosion_frame(frame_base, pitch_pixels, tile, t, f, frames);
-    }
-    }
-    SDL_UnlockTexture(tex);
-    if (out_types)
-        *out_types = types;
-    if (out_frames)
-        *out_frames = frames;
-    if (out_tile)
-        *out_tile = tile;
-    return tex;
-}
-SDL_Texture *texman_explosions_texture(TextureManager *m) {
-    return m ? m->explosions_sheet : NULL;
+static void texman_upload_explosions(TextureManager *m) {
+    if (!m || !m->explosion_lock)
+        return;
+    const struct BaseSlot *b = &m->base[TEX_EXPLOSIONS_SHEET];
+    /* Strips may be ready before the atlas page is uploaded */
+    if (!b->tex)
+        return;
+    SDL_LockMutex(m->explosion_lock);
+    for (int t = 0; t < EXPLOSION_GEN_TYPES; t++) {
+        uint32_t *strip = m->explosion_pending[t];
+        if (!strip)
+            continue;
+        int w = EXPLOSION_GEN_TILE * EXPLOSION_GEN_FRAMES;
+        SDL_Rect dst = {b->atlas.x, b->atlas.y + t * EXPLOSION_GEN_TILE, w, EXPLOSION_GEN_TILE};
+        SDL_UpdateTexture(b->tex, &dst, strip, w * (int)sizeof(uint32_t));
+        free(strip);
+        m->explosion_pending[t] = NULL;
+    }
+    SDL_UnlockMutex(m->explosion_lock);
 }
 int texman_explosion_type_count(TextureManager *m) {
     return m ? m->explosion_types : 0;
@@ -333,180 +834,87 @@ int texman_explosion_type_count(TextureManager *m) {
 int texman_explosion_frames(TextureManager *m) {
     return m ? m->explosion_frames : 0;
 }
-SDL_Rect texman_explosion_src(TextureManager *m, int explosion_type, int frame) {
-    SDL_Rect r = {0, 0, 0, 0
-};
-    if (!m || !m->explosions_sheet)
-        return r;
-    if (m->explosion_types <= 0 || m->explosion_frames <= 0)
-        return r;
-    if (explosion_type < 0)
-        explosion_type = 0;
-    if (explosion_type >= m->explosion_types)
-        explosion_type = m->explosion_types - 1;
-    if (frame < 0)
-        frame = 0;
-    if (frame >= m->explosion_frames)
-        frame = m->explosion_frames - 1;
-    r.x = frame * m->explosion_tile;
-    r.y = explosion_type * m->explosion_tile;
-    r.w = r.h = m->explosion_tile;
-    return r;
-}
-static SDL_Texture *gen_projectiles_sheet(SDL_Renderer *r, int *out_variants) {
+/* ---------------- Generated sheets ---------------------------------------- */
+/* Projectiles: one filled disc per colour variant, 8x8 tiles in a row */
+static SDL_Surface *decode_projectiles(uint32_t seed, FsMapping *map) {
+    (void)seed;
+    (void)map;
     int tile = 8;
     int variants = (int)(sizeof(PROJ_COLORS) / sizeof(PROJ_COLORS[0]));
-    int w = tile * variants, h = tile;
-    SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
-    if (!tex)
+    SDL_Surface *surf = SDL_CreateRGBSurfaceWithFormat(0, tile * variants, tile, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surf)
         return NULL;
-    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-    SDL_Texture *prev = SDL_GetRenderTarget(r);
-    SDL_SetRenderTarget(r, tex);
-    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    float rad = (tile * 0.5f) - 0.5f;
     for (int v = 0; v < variants; v++) {
-        Uint8 rc = PROJ_COLORS[v][0], gc = PROJ_COLORS[v][1], bc = PROJ_COLORS[v][2];
         for (int y = 0; y < tile; y++) {
+            Uint8 *row = (Uint8 *)surf->pixels + (size_t)y * surf->pitch + (size_t)v * tile * 4;
             for (int x = 0; x < tile; x++) {
                 float fx = (x + 0.5f) - tile * 0.5f;
                 float fy = (y + 0.5f) - tile * 0.5f;
-                float d2 = fx * fx + fy * fy;
-                float rad = (tile * 0.5f) - 0.5f;
-                if (d2 <= rad * rad)
-                    SDL_SetRenderDrawColor(r, rc, gc, bc, 255);
-                else
-                    SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
-                SDL_RenderDrawPoint(r, v * tile + x, y);
+                bool inside = fx * fx + fy * fy <= rad * rad;
+                row[x * 4 + 0] = inside ? PROJ_COLORS[v][0] : 0;
+                row[x * 4 + 1] = inside ? PROJ_COLORS[v][1] : 0;
+                row[x * 4 + 2] = inside ? PROJ_COLORS[v][2] : 0;
+                row[x * 4 + 3] = inside ? 255 : 0;
+            }
+        }
+    }
+    return surf;
 }
+/* Nebula: multi-center falloff + trig noise + stars (see nebula.c). A copy
+ * prepared by the previous run is picked up from the cache when available;
+ * the surface then points straight into the mapped file. */
+static SDL_Surface *decode_nebula(uint32_t seed, FsMapping *map) {
+    const int w = DISPLAY_W, h = DISPLAY_H;
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    const uint32_t *cached = NULL;
+    SDL_Surface *surf = NULL;
+    bool hit = nebula_cache_load(seed, w, h, map, &cached);
+    if (hit) {
+        surf = SDL_CreateRGBSurfaceWithFormatFrom((void *)cached, w, h, 32, w * (int)sizeof(Uint32), SDL_PIXELFORMAT_ARGB8888);
+        if (!surf)
+            fs_unmap_file(map);
+    } else {
+        surf = SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (surf && (surf->pitch != w * (int)sizeof(Uint32) || !nebula_generate(seed, (uint32_t *)surf->pixels, w, h, 0))) {
+            SDL_FreeSurface(surf);
+            surf = NULL;
         }
     }
-    SDL_SetRenderTarget(r, prev);
-    if (out_variants)
-        *out_variants = variants;
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    LOG_INFO("texman", "Nebula %08x %s in %.1f ms", (unsigned)seed, hit ? "loaded from cache" : "generated", ms);
+    return surf;
+}
+/* Generated pixels are already in their final format: upload as-is instead of
+ * letting SDL_CreateTextureFromSurface pick (and convert to) another one. */
+static SDL_Texture *texture_from_pixels(SDL_Renderer *r, SDL_Surface *surf) {
+    SDL_Texture *tex = SDL_CreateTexture(r, surf->format->format, SDL_TEXTUREACCESS_STATIC, surf->w, surf->h);
+    if (tex)
+        SDL_UpdateTexture(tex, NULL, surf->pixels, surf->pitch);
     return tex;
 }
-static SDL_Texture *gen_projectiles_sheet_proc(SDL_Renderer *r, uint32_t seed) {
-    (void)seed;
-    int v = 0;
-    return gen_projectiles_sheet(r, &v);
-}
-/* Nebula algorithm exactly as specified in nebule.c (multi-center falloff + trig noise + limited stars) */
-static inline float fast_exp(float x) {
-    union {
-        uint32_t i;
-        float f;
-} u;
-    u.i = (uint32_t)(12102203 * x + 1065353216);
-    return u.f;
-}
-static inline Uint32 make_color(Uint8 r8, Uint8 g8, Uint8 b8, Uint8 a8) {
-    return ((Uint32)a8 << 24) | ((Uint32)r8 << 16) | ((Uint32)g8 << 8) | b8;
-}
-static SDL_Texture *gen_nebula(SDL_Renderer *r, uint32_t seed) {
-    const int w = DISPLAY_W, h = DISPLAY_H;
-    SDL_Texture *tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, w, h);
-    if (!tex)
+/* ARGB8888 -> opaque RGB565, composited over black (the clear colour every
+ * scene draws the background onto) with a 4x4 ordered dither so the smooth
+ * gradients don't band */
+static SDL_Surface *surface_to_rgb565(SDL_Surface *src) {
+    static const Uint8 BAYER[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+    if (src->format->format != SDL_PIXELFORMAT_ARGB8888)
         return NULL;
-    Uint32 *px = (Uint32 *)malloc((size_t)w * h * sizeof(Uint32));
-    if (!px) {
-        SDL_DestroyTexture(tex);
-        return NULL;
-}
-    /* follow nebule.c: if seed provided use it, else random */
-    int nebula_seed = seed ? (int)seed : rand();
-    srand(nebula_seed);
-    int num_centers = 5 + (rand() % 4); /* 5-8 centers */
-    struct Center {
-        float x, y, intensity, inv_radius;
-        int color_type;
-    } centers[10];
-    for (int i = 0; i < num_centers; i++) {
-        centers[i].x = (float)(rand() % w);
-        centers[i].y = (float)(rand() % h);
-        centers[i].intensity = 0.4f + (rand() / (float)RAND_MAX) * 0.5f;
-        centers[i].color_type = rand() % 5;
-        float base_radius = 120.f + (float)(rand() % 80); /* fixed per center */
-        centers[i].inv_radius = 1.f / base_radius;
-    }
-    float *sin_lut = (float *)malloc(sizeof(float) * w);
-    float *cos_lut_x = (float *)malloc(sizeof(float) * w);
-    float *cos_lut_y = (float *)malloc(sizeof(float) * h);
-    if (!sin_lut || !cos_lut_x || !cos_lut_y) {
-        free(px);
-        free(sin_lut);
-        free(cos_lut_x);
-        free(cos_lut_y);
-        SDL_DestroyTexture(tex);
+    SDL_Surface *dst = SDL_CreateRGBSurfaceWithFormat(0, src->w, src->h, 16, SDL_PIXELFORMAT_RGB565);
+    if (!dst)
         return NULL;
-    }
-    for (int x = 0; x < w; x++) {
-        sin_lut[x] = sinf(x * 0.015f);
-        cos_lut_x[x] = cosf(x * 0.018f);
-    }
-    for (int y = 0; y < h; y++) {
-        cos_lut_y[y] = cosf(y * 0.014f);
-    }
-    for (int y = 0; y < h; y++) {
-        float y_component = y * 0.012f;
-        for (int x = 0; x < w; x++) {
-            float total_intensity = 0.f;
-            float red = 0.f, green = 0.f, blue = 0.f;
-            float noise_factor = 1.0f + 0.25f * sin_lut[x] * sinf(y_component) * cos_lut_x[x] * cos_lut_y[y];
-            for (int c = 0; c < num_centers; c++) {
-                float dx = x - centers[c].x;
-                float dy = y - centers[c].y;
-                float dist = sqrtf(dx * dx + dy * dy);
-                float falloff = fast_exp(-dist * centers[c].inv_radius) * centers[c].intensity;
-                falloff *= noise_factor;
-                total_intensity += falloff;
-                switch (centers[c].color_type) {
-                case 0: /* blue */
-                    blue += falloff * 0.85f;
-                    green += falloff * 0.15f;
-                    red += falloff * 0.05f;
-                    break;
-                case 1: /* purple */
-                    red += falloff * 0.70f;
-                    blue += falloff * 0.80f;
-                    green += falloff * 0.10f;
-                    break;
-                case 2: /* dark red */
-                    red += falloff * 0.90f;
-                    green += falloff * 0.05f;
-                    blue += falloff * 0.20f;
-                    break;
-                case 3: /* cyan */
-                    blue += falloff * 0.80f;
-                    green += falloff * 0.60f;
-                    red += falloff * 0.10f;
-                    break;
-                case 4: /* violet */
-                    red += falloff * 0.50f;
-                    blue += falloff * 0.90f;
-                    green += falloff * 0.05f;
-                    break;
-    }
-            }
-            float base_intensity = 0.08f;
-            red = fminf((red + base_intensity) * 85.0f, 120.0f);
-            green = fminf((green + base_intensity * 0.5f) * 60.0f, 80.0f);
-            blue = fminf((blue + base_intensity) * 100.0f, 140.0f);
-            float alpha_intensity = total_intensity + base_intensity;
-            Uint8 alpha = (Uint8)fminf(alpha_intensity * 200.0f + 40.0f, 200.0f);
-            px[y * (size_t)w + x] = make_color((Uint8)red, (Uint8)green, (Uint8)blue, alpha);
+    for (int y = 0; y < src->h; y++) {
+        const Uint32 *in = (const Uint32 *)((const Uint8 *)src->pixels + (size_t)y * src->pitch);
+        Uint16 *out = (Uint16 *)((Uint8 *)dst->pixels + (size_t)y * dst->pitch);
+        for (int x = 0; x < src->w; x++) {
+            Uint32 p = in[x];
+            Uint32 a = p >> 24;
+            Uint32 d = BAYER[y & 3][x & 3];
+            Uint32 r = (((p >> 16) & 0xFF) * a / 255 + (d >> 1)) >> 3; /* 5 bits: dither over 0..7 */
+            Uint32 g = (((p >> 8) & 0xFF) * a / 255 + (d >> 2)) >> 2;  /* 6 bits: dither over 0..3 */
+            Uint32 b = ((p & 0xFF) * a / 255 + (d >> 1)) >> 3;
+            out[x] = (Uint16)((r > 31 ? 31 : r) << 11 | (g > 63 ? 63 : g) << 5 | (b > 31 ? 31 : b));
         }
     }
-    free(sin_lut);
-    free(cos_lut_x);
-    free(cos_lut_y);
-    for (int i = 0; i < 600; i++) {
-        int sx = rand() % w;
-        int sy = rand() % h;
-        Uint8 bright = (Uint8)(120 + rand() % 86);
-        px[sy * (size_t)w + sx] = make_color(bright, bright, bright, 255);
-    }
-    SDL_UpdateTexture(tex, NULL, px, w * (int)sizeof(Uint32));
-    free(px);
-    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-    return tex;
+    return dst;
 }
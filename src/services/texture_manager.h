@@ -2,6 +2,7 @@
 #include <SDL2/SDL.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "explosion_gen.h"
 
 /* Unified, spec-driven always-loaded texture manager (replaces legacy). */
 
@@ -19,29 +20,94 @@ typedef enum {
 	TEX__COUNT
 } TextureID;
 
+/* Sprites: every sheet except the nebula and the logo lives in one or two
+ * shared atlas pages. Each tile gets a stable ID; IDs within a range follow
+ * the sheet's row-major tile order. */
+#define TEX_PLANET_SPRITES     16
+#define TEX_ICON_SPRITES       9
+#define TEX_ENEMY_SPRITES      9
+#define TEX_PROJECTILE_SPRITES 6
+#define TEX_EXPLOSION_SPRITES  (EXPLOSION_GEN_TYPES * EXPLOSION_GEN_FRAMES)
+
+typedef enum {
+	SPR_PLANET_FIRST = 0,
+	SPR_PLAYER = SPR_PLANET_FIRST + TEX_PLANET_SPRITES,
+	SPR_ICON_FIRST,
+	SPR_ENEMY_FIRST = SPR_ICON_FIRST + TEX_ICON_SPRITES,
+	SPR_PROJECTILE_FIRST = SPR_ENEMY_FIRST + TEX_ENEMY_SPRITES,
+	SPR_EXPLOSION_FIRST = SPR_PROJECTILE_FIRST + TEX_PROJECTILE_SPRITES, /* + type * frames + frame */
+	SPR_BUTTON_CROSS = SPR_EXPLOSION_FIRST + TEX_EXPLOSION_SPRITES,
+	SPR_BUTTON_CIRCLE,
+	SPR__COUNT
+} SpriteID;
+
+/* Immutable once loading finishes; tex is NULL until then */
+typedef struct Sprite {
+	SDL_Texture *tex;         /* atlas page */
+	SDL_Rect src;             /* pixels within the page */
+	float u0, v0, u1, v1;     /* same rect, normalised */
+} Sprite;
+
+/* Per-variant projectile look, built once in texman_create */
+typedef struct ProjectileStyle {
+	const Sprite *sprite;
+	Uint8 r, g, b;            /* trail colour */
+} ProjectileStyle;
+
 typedef struct TextureManager TextureManager;
 
 TextureManager *texman_create(SDL_Renderer *sdl, const char* assets_root);
-bool 			texman_load_textures(TextureManager*, uint32_t seed);
+bool 			texman_load_textures(TextureManager*, uint32_t seed); /* blocking: begin + step until done */
+/* Staged loading: begin starts the decode worker, step creates textures on the
+ * main thread within budget_ms and returns true once everything is loaded */
+bool            texman_load_begin(TextureManager*, uint32_t seed);
+bool            texman_load_step(TextureManager*, double budget_ms);
+/* Block until the decode worker hands over something load_step has not seen;
+ * false (without blocking) when no load is running */
+bool            texman_load_wait(TextureManager*);
+float           texman_load_progress(TextureManager*);
+bool            texman_is_ready(TextureManager*, TextureID id);
 void            texman_destroy(TextureManager*);
+/* Standalone textures; atlas members return their (shared) page. NULL while
+ * evicted: scenes that draw a texture hold a reference (texman_acquire). */
 SDL_Texture *texman_get(TextureManager*, TextureID id);
-SDL_Rect        texman_planet_src_rect(int idx);
-SDL_Rect        texman_sheet_src(TextureManager*, TextureID id, int index);
 
-/* Projectile sheet API */
-SDL_Texture *texman_projectiles_texture(TextureManager*);
-SDL_Rect     texman_projectile_src(TextureManager*, int variant_index);
+/* Residency. Atlas pages are always resident; standalone textures (nebula,
+ * logo) stay resident while referenced and are evicted least recently
+ * released first once the resident set exceeds the budget. */
+SDL_Texture *texman_acquire(TextureManager*, TextureID id); /* +1 ref, rebuilds if evicted */
+void         texman_release(TextureManager*, TextureID id);
+void         texman_set_budget(TextureManager*, size_t bytes);
+/* Enforce the budget (main thread, once per frame after scene changes) */
+void         texman_trim(TextureManager*);
+/* Never NULL; out-of-range IDs get an empty sprite */
+const Sprite *texman_sprite(TextureManager*, SpriteID id);
+/* The whole table, indexed by SpriteID (SPR__COUNT entries); stable for the
+ * manager's lifetime */
+const Sprite *texman_sprites(TextureManager*);
+
+/* Projectile variants (SPR_PROJECTILE_FIRST + variant) */
 int          texman_projectile_variant_count(TextureManager*);
-bool         texman_projectile_variant_color(TextureManager*, int variant_index, Uint8 *r, Uint8 *g, Uint8 *b);
+/* Never NULL; the variant is clamped to the generated range. The pointer stays
+ * valid for the manager's lifetime, so entities can keep it. */
+const ProjectileStyle *texman_projectile_style(TextureManager*, int variant);
 
-/* Explosions sheet (procedural) */
-SDL_Texture *texman_explosions_texture(TextureManager*);
+/* Explosions (procedural, SPR_EXPLOSION_FIRST + type * frames + frame) */
 int          texman_explosion_type_count(TextureManager*);
 int          texman_explosion_frames(TextureManager*);
-SDL_Rect     texman_explosion_src(TextureManager*, int explosion_type, int frame);
-
-/* Nebula regeneration */
-bool texman_regen_nebula(TextureManager*, uint32_t seed);
 
-typedef struct TexmanStats { int base_loaded; int projectile_variants; } TexmanStats;
+typedef struct TexmanStats {
+	int base_loaded;
+	int projectile_variants;
+	int atlas_pages;
+	size_t atlas_bytes;
+	size_t resident_bytes;    /* atlas pages + resident standalone textures */
+	size_t peak_bytes;
+	size_t budget_bytes;
+	int evictions;
+	size_t format_saved_bytes; /* vs. 32-bit, for resident textures in reduced formats */
+	size_t bytes[TEX__COUNT]; /* 0 while evicted; atlas members: their share of the page */
+	int refs[TEX__COUNT];
+} TexmanStats;
 TexmanStats texman_stats(TextureManager*);
+void        texman_log_stats(TextureManager*);